@@ -0,0 +1,81 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include "AsyncServiceClient.h"
+
+namespace TVRemoteScreenSDKCommunication
+{
+
+SerialCallQueue::~SerialCallQueue()
+{
+	{
+		std::lock_guard<std::mutex> lock{m_mutex};
+		m_shutdown = true;
+	}
+	m_condition.notify_all();
+
+	if (m_thread.joinable())
+	{
+		m_thread.join();
+	}
+}
+
+void SerialCallQueue::Post(Task task)
+{
+	{
+		std::lock_guard<std::mutex> lock{m_mutex};
+		m_tasks.push_back(std::move(task));
+
+		if (!m_thread.joinable())
+		{
+			m_thread = std::thread{&SerialCallQueue::Run, this};
+		}
+	}
+	m_condition.notify_one();
+}
+
+void SerialCallQueue::Run()
+{
+	std::unique_lock<std::mutex> lock{m_mutex};
+	while (true)
+	{
+		m_condition.wait(lock, [this]()
+		{
+			return m_shutdown || !m_tasks.empty();
+		});
+
+		if (m_tasks.empty())
+		{
+			return;
+		}
+
+		Task task = std::move(m_tasks.front());
+		m_tasks.pop_front();
+
+		lock.unlock();
+		task();
+		lock.lock();
+	}
+}
+
+} // namespace TVRemoteScreenSDKCommunication
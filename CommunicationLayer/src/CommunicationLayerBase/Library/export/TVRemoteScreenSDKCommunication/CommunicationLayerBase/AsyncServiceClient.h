@@ -0,0 +1,134 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace TVRemoteScreenSDKCommunication
+{
+
+// Runs posted tasks one after another on a worker thread started with the first task.
+// Tasks still queued on destruction are run before the worker is joined.
+class SerialCallQueue final
+{
+public:
+	using Task = std::function<void()>;
+
+	SerialCallQueue() = default;
+	~SerialCallQueue();
+
+	SerialCallQueue(const SerialCallQueue&) = delete;
+	SerialCallQueue& operator=(const SerialCallQueue&) = delete;
+
+	void Post(Task task);
+
+private:
+	void Run();
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<Task> m_tasks;
+	bool m_shutdown = false;
+	std::thread m_thread;
+};
+
+// Issues the calls of a generated service client (IImageServiceClient etc.) without blocking the caller.
+// Calls run in the order they are issued on a worker thread of this object, so a slow peer only delays
+// the calls queued here. The result is reported via the returned future or a completion callback,
+// the latter being invoked on the worker thread.
+//
+// Usage:
+//   AsyncServiceClient<IImageServiceClient> asyncClient{client};
+//   std::future<CallStatus> status = asyncClient.Call(&IImageServiceClient::UpdateImage, comId, x, y, width, height, std::move(picture));
+//
+// Arguments are moved or copied into the queued call, references to the caller's data are not kept.
+template<typename ClientInterface>
+class AsyncServiceClient final
+{
+public:
+	template<typename Result>
+	struct Completion
+	{
+		using Type = std::function<void(const Result&)>;
+	};
+
+	explicit AsyncServiceClient(std::shared_ptr<ClientInterface> client)
+		: m_client(std::move(client))
+	{
+	}
+
+	const std::shared_ptr<ClientInterface>& GetClient() const
+	{
+		return m_client;
+	}
+
+	template<typename Result, typename... Params, typename... Args>
+	std::future<Result> Call(Result (ClientInterface::*method)(Params...), Args&&... args)
+	{
+		const std::shared_ptr<std::packaged_task<Result()>> task =
+			std::make_shared<std::packaged_task<Result()>>(std::bind(method, m_client, std::forward<Args>(args)...));
+		std::future<Result> result = task->get_future();
+
+		m_queue.Post([task]()
+		{
+			(*task)();
+		});
+
+		return result;
+	}
+
+	template<typename Result, typename... Params, typename... Args>
+	void Call(
+		typename Completion<Result>::Type completion,
+		Result (ClientInterface::*method)(Params...),
+		Args&&... args)
+	{
+		const std::shared_ptr<std::packaged_task<Result()>> task =
+			std::make_shared<std::packaged_task<Result()>>(std::bind(method, m_client, std::forward<Args>(args)...));
+
+		m_queue.Post([task, completion]()
+		{
+			(*task)();
+			if (completion)
+			{
+				completion(task->get_future().get());
+			}
+		});
+	}
+
+private:
+	const std::shared_ptr<ClientInterface> m_client;
+
+	// destroyed first, so pending calls still find the client
+	SerialCallQueue m_queue;
+};
+
+} // namespace TVRemoteScreenSDKCommunication
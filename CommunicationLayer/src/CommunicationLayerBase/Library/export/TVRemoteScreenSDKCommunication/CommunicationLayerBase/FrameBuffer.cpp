@@ -0,0 +1,85 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include "FrameBuffer.h"
+
+#include <algorithm>
+
+namespace TVRemoteScreenSDKCommunication
+{
+
+FrameBuffer::FrameBuffer(std::shared_ptr<const void> owner, const char* data, size_t size)
+	: m_owner(std::move(owner))
+	, m_copies(std::make_shared<std::atomic<uint32_t>>(0))
+	, m_data(data)
+	, m_size(size)
+{
+}
+
+FrameBuffer::FrameBuffer(std::string data)
+	: m_copies(std::make_shared<std::atomic<uint32_t>>(0))
+{
+	const std::shared_ptr<const std::string> owner = std::make_shared<const std::string>(std::move(data));
+	m_data = owner->data();
+	m_size = owner->size();
+	m_owner = owner;
+}
+
+FrameBuffer FrameBuffer::Unowned(const char* data, size_t size)
+{
+	return FrameBuffer{nullptr, data, size};
+}
+
+FrameBuffer FrameBuffer::Slice(size_t offset, size_t size) const
+{
+	FrameBuffer slice = *this;
+	offset = std::min(offset, m_size);
+	slice.m_data = m_data + offset;
+	slice.m_size = std::min(size, m_size - offset);
+	return slice;
+}
+
+FrameBuffer FrameBuffer::Derive(std::string data) const
+{
+	FrameBuffer derived{std::move(data)};
+	if (m_copies)
+	{
+		derived.m_copies = m_copies;
+	}
+	return derived;
+}
+
+void FrameBuffer::CountCopy() const
+{
+	if (m_copies)
+	{
+		++*m_copies;
+	}
+}
+
+uint32_t FrameBuffer::GetCopyCount() const
+{
+	return m_copies ? m_copies->load() : 0;
+}
+
+} // namespace TVRemoteScreenSDKCommunication
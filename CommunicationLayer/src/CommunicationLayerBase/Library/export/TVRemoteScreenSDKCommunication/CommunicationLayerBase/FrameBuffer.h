@@ -0,0 +1,89 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace TVRemoteScreenSDKCommunication
+{
+
+/**
+ * @brief FrameBuffer refers to the pixel data of a frame on its way to the transport.
+ * The bytes are kept alive by a shared reference to their owner, e.g. an image, and are not
+ * modified while referenced, so buffers are passed on and sliced without copying the bytes.
+ * Code which has to copy the bytes nevertheless counts it, so the copies a frame takes can be checked.
+ */
+class FrameBuffer final
+{
+public:
+	FrameBuffer() = default;
+
+	// Refers to the bytes at data, owner keeps them alive.
+	FrameBuffer(std::shared_ptr<const void> owner, const char* data, size_t size);
+
+	// Takes over the bytes of the string.
+	explicit FrameBuffer(std::string data);
+
+	// Refers to bytes the caller keeps alive while the buffer and its slices are in use.
+	static FrameBuffer Unowned(const char* data, size_t size);
+
+	const char* data() const
+	{
+		return m_data;
+	}
+
+	size_t size() const
+	{
+		return m_size;
+	}
+
+	bool empty() const
+	{
+		return m_size == 0;
+	}
+
+	// The bytes from offset on, at most size of them, sharing owner and copy count.
+	FrameBuffer Slice(size_t offset, size_t size = std::string::npos) const;
+
+	// A buffer holding bytes made from this one, e.g. a cropped part, which shares its copy count.
+	FrameBuffer Derive(std::string data) const;
+
+	// To be called by code copying the bytes, once per copy.
+	void CountCopy() const;
+
+	// Copies of the bytes counted for this buffer and the ones sliced or derived from it.
+	uint32_t GetCopyCount() const;
+
+private:
+	std::shared_ptr<const void> m_owner;
+	std::shared_ptr<std::atomic<uint32_t>> m_copies;
+	const char* m_data = nullptr;
+	size_t m_size = 0;
+};
+
+} // namespace TVRemoteScreenSDKCommunication
@@ -71,7 +71,7 @@ TransportFramework GetTransportFramework(const std::string& scheme)
 		return TransportFramework::gRPCTransport;
 	}
 
-	if (scheme == "tcp+tv" || scheme == "tv+tcp")
+	if (scheme == "tcp+tv" || scheme == "tv+tcp" || IsUnixSocketScheme(scheme))
 	{
 		return TransportFramework::TCPSocketTransport;
 	}
@@ -79,4 +79,9 @@ TransportFramework GetTransportFramework(const std::string& scheme)
 	return TransportFramework::UnknownTransport;
 }
 
+bool IsUnixSocketScheme(const std::string& scheme)
+{
+	return scheme == "unix+tv" || scheme == "tv+unix";
+}
+
 } // namespace TVRemoteScreenSDKCommunication
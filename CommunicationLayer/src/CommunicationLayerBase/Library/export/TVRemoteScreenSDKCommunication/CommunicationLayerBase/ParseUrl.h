@@ -42,4 +42,8 @@ bool ParseUrl(const std::string& url, UrlComponents& urlComponents);
 
 TransportFramework GetTransportFramework(const std::string& scheme);
 
+// Whether a scheme of the TCPSocketTransport framework addresses a Unix domain socket
+// by the path component instead of a TCP socket by host and port.
+bool IsUnixSocketScheme(const std::string& scheme);
+
 } // namespace TVRemoteScreenSDKCommunication
@@ -25,6 +25,16 @@
 
 #include <cstdint>
 
+// With TV_COMM_GRPC_PLUGIN the gRPC transport is built into a plugin of its own, loaded on first use.
+// These tell whether the implementation of a transport framework is part of the current target.
+#if defined(TV_COMM_ENABLE_GRPC) && (!defined(TV_COMM_GRPC_PLUGIN) || defined(TV_COMM_BUILDING_GRPC_PLUGIN))
+#define TV_COMM_GRPC_IMPLEMENTATION
+#endif
+
+#if defined(TV_COMM_ENABLE_PLAIN_SOCKET) && !defined(TV_COMM_BUILDING_GRPC_PLUGIN)
+#define TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
+#endif
+
 namespace TVRemoteScreenSDKCommunication
 {
 
@@ -32,6 +42,7 @@ enum TransportFramework : std::size_t
 {
 	UnknownTransport = 0,
 	gRPCTransport,
+	// Plain sockets, either TCP (tcp+tv://host:port) or Unix domain sockets (unix+tv:///path).
 	TCPSocketTransport,
 };
 
@@ -44,4 +55,5 @@ constexpr TransportFramework DefaultFramework =
 #error No transport framworks enabled
 #endif
 	;
+
 }
\ No newline at end of file
@@ -0,0 +1,102 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include "ServiceType.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace TVRemoteScreenSDKCommunication
+{
+
+enum class TransportCompression
+{
+	None,
+	Deflate,
+	Gzip
+};
+
+/**
+ * @brief TransportOptions tune the channels and servers a service is created with.
+ * Every option left at its default keeps the current behaviour of the transport framework.
+ * gRPC ignores the SocketIO options and vice versa.
+ */
+struct TransportOptions final
+{
+	// gRPC
+
+	// largest message sent or received in bytes, 0 .. use gRPC default
+	int32_t maxMessageSize = 0;
+
+	// interval between HTTP/2 keepalive pings, 0 .. no keepalive pings
+	std::chrono::milliseconds keepaliveTime{0};
+
+	// time to wait for the acknowledgement of a keepalive ping, 0 .. use gRPC default
+	std::chrono::milliseconds keepaliveTimeout{0};
+
+	// compression of the messages sent
+	TransportCompression compression = TransportCompression::None;
+
+	// size of the HTTP/2 write buffer in bytes, 0 .. use gRPC default
+	int32_t writeBufferSize = 0;
+
+	// SocketIO
+
+	// largest piece of a message read in one go in bytes, 0 .. use SocketIO default
+	size_t chunkSize = 0;
+
+	// send and receive timeout of connected sockets, 0 .. use SocketIO default
+	std::chrono::milliseconds sendReceiveTimeout{0};
+
+	// length of the queue of pending connections of a server, 0 .. use SocketIO default
+	int maxBacklogSize = 0;
+
+	// SO_SNDBUF and SO_RCVBUF of connected sockets in bytes, 0 .. use system default
+	int sendBufferSize = 0;
+	int receiveBufferSize = 0;
+
+	// disables Nagle's algorithm on TCP sockets
+	bool noDelay = false;
+};
+
+/**
+ * @brief ServiceTransportOptions hold the transport options per service type.
+ * Service types without options of their own use the default options.
+ */
+struct ServiceTransportOptions final
+{
+	const TransportOptions& Get(ServiceType serviceType) const
+	{
+		const auto foundOptions = services.find(serviceType);
+		return foundOptions != services.end() ? foundOptions->second : defaults;
+	}
+
+	TransportOptions defaults;
+	std::map<ServiceType, TransportOptions> services;
+};
+
+} // namespace TVRemoteScreenSDKCommunication
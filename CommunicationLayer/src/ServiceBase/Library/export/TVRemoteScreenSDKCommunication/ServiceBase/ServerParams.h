@@ -31,4 +31,7 @@ constexpr int DefaultMinPollingThreads        = 1;
 constexpr int DefaultMaxPollingThreads        = 4;
 constexpr int DefaultCompletionQueueTimeout   = -1; // milliseconds (-1 .. do not set)
 
+constexpr int DefaultAsyncServerCompletionQueues          = 1;
+constexpr int DefaultAsyncServerThreadsPerCompletionQueue = 2;
+
 } // namespace TVRemoteScreenSDKCommunication
@@ -31,5 +31,6 @@ constexpr const char* ErrorMessage_NoComId = "No ComId provided.";
 constexpr const char* ErrorMessage_ResponseCallbackNotCalled = "Missing response callback invocation.";
 constexpr const char* ErrorMessage_UnexpectedEnumValue = "Provided enum value is not expected.";
 constexpr const char* ErrorMessage_Failed = "Failed.";
+constexpr const char* ErrorMessage_FrameRejected = "Frame rejected by the frame sink.";
 
 } // namespace TvServiceBase
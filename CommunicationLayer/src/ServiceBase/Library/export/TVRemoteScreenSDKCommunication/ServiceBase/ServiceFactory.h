@@ -23,7 +23,9 @@
 //********************************************************************************//
 #pragma once
 
-#ifdef TV_COMM_ENABLE_GRPC
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportFramework.h>
+
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "gRPCTransport.h"
 #endif
 
@@ -31,8 +33,6 @@
 #include "SocketIOTransport.h"
 #endif
 
-#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportFramework.h>
-
 #include <memory>
 #include <type_traits>
 
@@ -48,7 +48,7 @@ struct ServiceFramework
 	using type = void;
 };
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<typename ServiceType>
 struct ServiceFramework<
 	ServiceType,
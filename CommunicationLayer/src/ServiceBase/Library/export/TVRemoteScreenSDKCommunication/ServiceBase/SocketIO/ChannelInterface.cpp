@@ -27,8 +27,12 @@
 
 #include "Envelope.pb.h"
 
+#include <algorithm>
+#include <condition_variable>
 #include <thread>
 #include <iostream>
+#include <unordered_map>
+#include <unordered_set>
 
 #if defined(_WIN32) || defined(_WINCE)
 #include <winsock2.h>
@@ -46,19 +50,181 @@ namespace Transport
 namespace SocketIO
 {
 
-ChannelInterface::ChannelInterface(std::string location)
+namespace
+{
+
+Status DeadlineExceeded(const char* operation)
+{
+	return {StatusCode::IO_ERROR, std::string{"ChannelInterface: deadline exceeded while "} + operation};
+}
+
+} // namespace
+
+struct ChannelInterface::Connection final
+{
+	Connection(socket_t connectionSocket, size_t chunkSize)
+		: socket(connectionSocket)
+		, reader(connectionSocket, ReadBufferSize, chunkSize)
+	{
+	}
+
+	~Connection()
+	{
+		CloseSocket(socket);
+	}
+
+	bool IsBroken()
+	{
+		const std::lock_guard<std::mutex> lock{mutex};
+		return !failure.ok();
+	}
+
+	void ExpectResponse(uint64_t callId)
+	{
+		const std::lock_guard<std::mutex> lock{mutex};
+		pendingCalls.insert(callId);
+	}
+
+	// the response of an abandoned call is dropped on arrival, see AwaitResponse
+	void ForgetResponse(uint64_t callId)
+	{
+		const std::lock_guard<std::mutex> lock{mutex};
+		pendingCalls.erase(callId);
+		receivedResponses.erase(callId);
+	}
+
+	void Abort(Status reason)
+	{
+		{
+			const std::lock_guard<std::mutex> lock{mutex};
+			if (failure.ok())
+			{
+				failure = std::move(reason);
+			}
+			ShutdownSocket(socket);
+		}
+		condition.notify_all();
+	}
+
+	// Receives the next response as far as it arrives before the deadline, complete stays false otherwise.
+	// The reader does not block, a partially received response is kept and completed by the next call.
+	Status ReceiveResponse(Envelope& envelope, Deadline deadline, bool& complete)
+	{
+		while (true)
+		{
+			Status result = reader.ReceiveEnvelope(envelope, complete);
+			if (!result.ok() || complete)
+			{
+				return result;
+			}
+
+			if (!WaitForSocket(socket, false, deadline))
+			{
+				return Status::OK;
+			}
+		}
+	}
+
+	// Waits for the response with the given call id. Whichever caller finds nobody reading
+	// takes over receiving and hands out responses to the other callers until its own arrived.
+	Status AwaitResponse(uint64_t callId, Envelope& response, Deadline deadline)
+	{
+		std::unique_lock<std::mutex> lock{mutex};
+		while (true)
+		{
+			const auto foundResponse = receivedResponses.find(callId);
+			if (foundResponse != receivedResponses.end())
+			{
+				response = std::move(foundResponse->second);
+				receivedResponses.erase(foundResponse);
+				return Status::OK;
+			}
+
+			if (!failure.ok())
+			{
+				pendingCalls.erase(callId);
+				return failure;
+			}
+
+			if (Deadline::clock::now() >= deadline)
+			{
+				// the response is dropped should it arrive later
+				pendingCalls.erase(callId);
+				return DeadlineExceeded("waiting for the response");
+			}
+
+			if (reading)
+			{
+				condition.wait_until(lock, deadline);
+				continue;
+			}
+
+			reading = true;
+			lock.unlock();
+
+			Envelope envelope{};
+			bool complete = false;
+			Status receiveResult = ReceiveResponse(envelope, deadline, complete);
+
+			lock.lock();
+			reading = false;
+
+			if (!receiveResult.ok())
+			{
+				failure = std::move(receiveResult);
+				ShutdownSocket(socket);
+			}
+			else if (complete && pendingCalls.erase(envelope.callId) != 0)
+			{
+				const uint64_t receivedCallId = envelope.callId;
+				receivedResponses.emplace(receivedCallId, std::move(envelope));
+			}
+			// else: the response of a forgotten or unknown call, the frame has been read completely,
+			// so it is dropped and the connection stays usable for the other calls
+
+			condition.notify_all();
+		}
+	}
+
+	const socket_t socket;
+
+	// used by one caller at a time, either the one holding the channel or the current reading one,
+	// non-blocking once the handshake is done
+	FrameReader reader;
+
+	// set up by OpenConnection() before the connection is shared
+	uint32_t protocolRevision = ProtocolRevision_Legacy;
+
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::unordered_set<uint64_t> pendingCalls;
+	std::unordered_map<uint64_t, Envelope> receivedResponses;
+	bool reading = false;
+	Status failure = Status::OK;
+};
+
+ChannelInterface::ChannelInterface(std::string location, ConnectionPolicy policy, SocketOptions socketOptions)
 	: m_socketSetup(QuerySockets())
 	, m_location(std::move(location))
-	, m_clientSocket(InvalidSocket)
+	, m_policy(std::move(policy))
+	, m_socketOptions(std::move(socketOptions))
 {
 
 }
 
 ChannelInterface::~ChannelInterface()
 {
-	std::lock_guard<std::mutex> lock{m_ioMutex};
-	CloseSocket(m_clientSocket);
-	m_clientSocket = InvalidSocket;
+	{
+		std::lock_guard<std::mutex> lock{m_ioMutex};
+		m_shuttingDown = true;
+		Disconnect();
+	}
+	m_reconnectCondition.notify_all();
+
+	if (m_reconnectThread.joinable())
+	{
+		m_reconnectThread.join();
+	}
 }
 
 Status ChannelInterface::Call(
@@ -67,95 +233,175 @@ Status ChannelInterface::Call(
 	std::shared_ptr<std::string>&& request,
 	std::shared_ptr<std::string>& response)
 {
-	std::lock_guard<std::mutex> lock(m_ioMutex);
+	return Call(comId, functionId, std::move(request), FrameBuffer{}, response);
+}
+
+Status ChannelInterface::Call(
+	const std::string& comId,
+	int64_t functionId,
+	std::shared_ptr<std::string>&& request,
+	FrameBuffer requestTail,
+	std::shared_ptr<std::string>& response)
+{
+	std::unique_lock<std::mutex> lock(m_ioMutex);
 
 	Status returnStatus{StatusCode::IO_ERROR, "ChannelInterface::Call: unknown IO error"};
 
-	int retryCounter = 10;
+	const Deadline deadline = Deadline::clock::now() + m_policy.deadline;
+
+	uint32_t attempts = std::max<uint32_t>(m_policy.maxAttempts, 1);
+	if (m_circuitState == CircuitState::Open)
+	{
+		if (std::chrono::steady_clock::now() < m_circuitOpenUntil)
+		{
+			return {
+				StatusCode::UNAVAILABLE,
+				"ChannelInterface::Call: peer unavailable; location: " + m_location};
+		}
+
+		m_circuitState = CircuitState::HalfOpen;
+	}
+
+	if (m_circuitState == CircuitState::HalfOpen)
+	{
+		attempts = 1;
+	}
+
 	Envelope envelopeToSend;
 
 	envelopeToSend.comId = comId;
 	envelopeToSend.functionId = functionId;
 	envelopeToSend.data.swap(request);
+	envelopeToSend.dataTail = std::move(requestTail);
 
-	while (retryCounter > 0)
-	{
-		retryCounter--;
+	std::shared_ptr<Connection> connection;
+	Backoff backoff{m_policy};
 
-		if (m_clientSocket == InvalidSocket)
+	for (uint32_t attempt = 1; attempt <= attempts; ++attempt)
+	{
+		if (m_connection && m_connection->IsBroken())
 		{
-			returnStatus = Connect();
+			Disconnect();
 		}
 
-		if (m_clientSocket != InvalidSocket)
+		if (!m_connection)
 		{
-			// try sending preamble
-			returnStatus = SendPreamble(m_clientSocket);
+			returnStatus = Connect(deadline);
+		}
 
-			// try sending request
-			if (returnStatus.ok())
+		connection = m_connection;
+		if (connection)
+		{
+			if (connection->protocolRevision >= ProtocolRevision_CallId)
 			{
-				returnStatus = SendEnvelope(m_clientSocket, envelopeToSend);
+				envelopeToSend.callId = ++m_lastCallId;
+				connection->ExpectResponse(envelopeToSend.callId);
 			}
+
+			// try sending request
+			returnStatus = SendPreambleAndEnvelope(connection->socket, envelopeToSend, connection->protocolRevision, deadline);
 		}
 
-		if (returnStatus.ok())
+		if (returnStatus.ok() || attempt == attempts)
 		{
 			break;
 		}
-		else if (retryCounter > 0)
-		{
-			CloseSocket(m_clientSocket);
-			m_clientSocket = InvalidSocket;
 
-			// wait to not spam the socket and start over
-			std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		Disconnect();
+		connection.reset();
+
+		const std::chrono::milliseconds delay = backoff.Next();
+		if (std::chrono::steady_clock::now() + delay >= deadline)
+		{
+			returnStatus = {
+				returnStatus.code(),
+				returnStatus.error_message() + "; deadline of " + std::to_string(m_policy.deadline.count()) + " ms exceeded"};
+			break;
 		}
+
+		// other calls may use the channel meanwhile, they start over with a fresh connection
+		lock.unlock();
+		std::this_thread::sleep_for(delay);
+		lock.lock();
 	}
 	envelopeToSend.data.reset();
+	envelopeToSend.dataTail = FrameBuffer{};
 
 	if (!returnStatus.ok())
 	{
-		CloseSocket(m_clientSocket);
-		m_clientSocket = InvalidSocket;
+		Disconnect();
+		RecordFailure();
 		return returnStatus;
 	}
 
+	RecordSuccess();
+
 	// receive response
 	{
 		Envelope envelope{};
 
-		returnStatus = ReceiveEnvelope(m_clientSocket, envelope);
-
-		if (!returnStatus.ok())
+		if (connection->protocolRevision == ProtocolRevision_Legacy)
 		{
-			return returnStatus;
-		}
+			// responses arrive in request order, the channel stays locked for the whole round trip
+			bool complete = false;
+			returnStatus = connection->ReceiveResponse(envelope, deadline, complete);
+			if (returnStatus.ok() && !complete)
+			{
+				returnStatus = DeadlineExceeded("waiting for the response");
+			}
 
-		if (envelope.comId != comId)
-		{
-			return {
-				StatusCode::LOGIC_ERROR,
-				"ChannelInterface::Call: invalid comId (expected: '" + comId +
-				"', received: '" + envelope.comId + "')"};
+			if (!returnStatus.ok())
+			{
+				// a late response would otherwise be taken for the one of the next call
+				Disconnect();
+				return returnStatus;
+			}
 		}
-
-		if (envelope.functionId != functionId)
+		else
 		{
-			return {
-				StatusCode::LOGIC_ERROR,
-				"ChannelInterface::Call: invalid functionId (expected: '" + std::to_string(functionId) +
-				"', received: '" + std::to_string(envelope.functionId) + "')"};
-		}
+			// other calls may use the connection while this one waits for its response
+			lock.unlock();
 
-		returnStatus = Status{static_cast<StatusCode>(envelope.statusCode), envelope.statusMessage};
+			returnStatus = connection->AwaitResponse(envelopeToSend.callId, envelope, deadline);
+			if (!returnStatus.ok())
+			{
+				return returnStatus;
+			}
+		}
 
-		response.swap(envelope.data);
+		returnStatus = TakeResponse(comId, functionId, envelope, response);
 	}
 
 	return returnStatus;
 }
 
+Status ChannelInterface::TakeResponse(
+	const std::string& comId,
+	int64_t functionId,
+	Envelope& envelope,
+	std::shared_ptr<std::string>& response)
+{
+	if (envelope.comId != comId)
+	{
+		return {
+			StatusCode::LOGIC_ERROR,
+			"ChannelInterface::Call: invalid comId (expected: '" + comId +
+			"', received: '" + envelope.comId + "')"};
+	}
+
+	if (envelope.functionId != functionId)
+	{
+		return {
+			StatusCode::LOGIC_ERROR,
+			"ChannelInterface::Call: invalid functionId (expected: '" + std::to_string(functionId) +
+			"', received: '" + std::to_string(envelope.functionId) + "')"};
+	}
+
+	response.swap(envelope.data);
+
+	return Status{static_cast<StatusCode>(envelope.statusCode), envelope.statusMessage};
+}
+
 Status ChannelInterface::Call(
 	const ClientContext& context,
 	int64_t functionId,
@@ -206,68 +452,382 @@ Status ChannelInterface::Call(
 	return Call(ctx, functionId, request, response);
 }
 
-Status ChannelInterface::Connect()
+std::unique_ptr<ChannelInterface::ClientStream> ChannelInterface::OpenStream(const std::string& comId, int64_t functionId)
+{
+	return std::unique_ptr<ClientStream>{new ClientStream{*this, comId, functionId}};
+}
+
+ChannelInterface::ClientStream::ClientStream(ChannelInterface& channel, std::string comId, int64_t functionId)
+	: m_channel(channel)
+	, m_comId(std::move(comId))
+	, m_functionId(functionId)
+{
+}
+
+ChannelInterface::ClientStream::~ClientStream()
+{
+	if (!m_started || m_finished || !m_streamsSupported)
+	{
+		return;
+	}
+
+	// tell the server to drop the frames received so far
+	Send(std::make_shared<std::string>(), FrameBuffer{}, EnvelopeFlag_Cancelled);
+	m_connection->ForgetResponse(m_callId);
+}
+
+Status ChannelInterface::ClientStream::Open(bool& streamsSupported)
 {
-	if (m_clientSocket != InvalidSocket)
+	if (!m_started)
 	{
-		CloseSocket(m_clientSocket);
-		m_clientSocket = InvalidSocket;
+		m_status = Start();
 	}
 
-	sockaddr_in serverAddress{};
+	// a connected peer not supporting streams is no failure of opening the stream
+	streamsSupported = m_streamsSupported;
+	return m_connection && !m_streamsSupported ? Status::OK : m_status;
+}
 
-	serverAddress.sin_family = AF_INET;
+Status ChannelInterface::ClientStream::Write(std::shared_ptr<std::string> frame, FrameBuffer frameTail)
+{
+	if (!m_started)
+	{
+		m_status = Start();
+	}
 
-	if (ParseLocationUri(m_location, serverAddress.sin_addr, serverAddress.sin_port))
+	if (!m_status.ok())
 	{
-		// create socket
-		m_clientSocket = ::socket(AF_INET, SocketType, 0);
-		if (m_clientSocket == InvalidSocket)
+		return m_status;
+	}
+
+	m_status = Send(std::move(frame), std::move(frameTail), EnvelopeFlag_MoreFrames);
+	return m_status;
+}
+
+Status ChannelInterface::ClientStream::Finish(std::shared_ptr<std::string> lastFrame, std::shared_ptr<std::string>& response)
+{
+	return Finish(std::move(lastFrame), FrameBuffer{}, response);
+}
+
+Status ChannelInterface::ClientStream::Finish(
+	std::shared_ptr<std::string> lastFrame,
+	FrameBuffer lastFrameTail,
+	std::shared_ptr<std::string>& response)
+{
+	if (!m_started)
+	{
+		m_status = Start();
+	}
+
+	if (!m_status.ok())
+	{
+		return m_status;
+	}
+
+	m_finished = true;
+
+	m_status = Send(std::move(lastFrame), std::move(lastFrameTail), 0);
+	if (!m_status.ok())
+	{
+		m_connection->ForgetResponse(m_callId);
+		return m_status;
+	}
+
+	Envelope envelope{};
+	m_status = m_connection->AwaitResponse(m_callId, envelope, Deadline::clock::now() + m_channel.m_policy.deadline);
+	if (!m_status.ok())
+	{
+		return m_status;
+	}
+
+	return TakeResponse(m_comId, m_functionId, envelope, response);
+}
+
+Status ChannelInterface::ClientStream::Start()
+{
+	m_started = true;
+
+	const std::lock_guard<std::mutex> lock(m_channel.m_ioMutex);
+
+	if (m_channel.m_circuitState == CircuitState::Open)
+	{
+		if (std::chrono::steady_clock::now() < m_channel.m_circuitOpenUntil)
 		{
 			return {
-				StatusCode::CONNECT_ERROR,
-				"ChannelInterface::Connect: socket() failed; location: " + m_location +
-				"; last error " + std::to_string(GetLastSocketError())};
+				StatusCode::UNAVAILABLE,
+				"ChannelInterface::ClientStream: peer unavailable; location: " + m_channel.m_location};
 		}
 
-		ResetLastSocketError();
-		int connectResult = ::connect(m_clientSocket, reinterpret_cast<sockaddr*>(&serverAddress), sizeof(serverAddress));
-		if (connectResult < 0)
+		m_channel.m_circuitState = CircuitState::HalfOpen;
+	}
+
+	if (m_channel.m_connection && m_channel.m_connection->IsBroken())
+	{
+		m_channel.Disconnect();
+	}
+
+	if (!m_channel.m_connection)
+	{
+		const Status connectResult = m_channel.Connect(Deadline::clock::now() + m_channel.m_policy.deadline);
+		if (!connectResult.ok())
 		{
-			const int lastError = GetLastSocketError();
-			CloseSocket(m_clientSocket);
-			m_clientSocket = InvalidSocket;
-			return {
-				StatusCode::CONNECT_ERROR,
-				"ChannelInterface::Connect: connect() failed; location: " + m_location +
-				"; last error " + std::to_string(lastError)};
+			m_channel.RecordFailure();
+			return connectResult;
 		}
+	}
 
-		timeval timeout{};
-		timeout.tv_sec = SendReceiveTimeout;
+	m_connection = m_channel.m_connection;
+	if (m_connection->protocolRevision < ProtocolRevision_Streaming)
+	{
+		return {
+			StatusCode::FAILED_PRECONDITION,
+			"ChannelInterface::ClientStream: peer does not support streams; location: " + m_channel.m_location};
+	}
+	m_streamsSupported = true;
 
-		if (::setsockopt(m_clientSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) != 0 ||
-			::setsockopt(m_clientSocket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) != 0)
+	m_callId = ++m_channel.m_lastCallId;
+	m_connection->ExpectResponse(m_callId);
+
+	return Status::OK;
+}
+
+Status ChannelInterface::ClientStream::Send(std::shared_ptr<std::string> frame, FrameBuffer frameTail, uint16_t flags)
+{
+	Envelope envelopeToSend;
+	envelopeToSend.comId = m_comId;
+	envelopeToSend.functionId = m_functionId;
+	envelopeToSend.callId = m_callId;
+	envelopeToSend.flags = flags;
+	envelopeToSend.data.swap(frame);
+	envelopeToSend.dataTail = std::move(frameTail);
+
+	const std::lock_guard<std::mutex> lock(m_channel.m_ioMutex);
+
+	// the frames of a call are not retried, a new connection would not know the earlier ones
+	if (m_channel.m_connection != m_connection || m_connection->IsBroken())
+	{
+		return {
+			StatusCode::CONNECTION_CLOSED,
+			"ChannelInterface::ClientStream: connection closed in the middle of the call"};
+	}
+
+	const Status sendResult = SendPreambleAndEnvelope(
+		m_connection->socket,
+		envelopeToSend,
+		m_connection->protocolRevision,
+		Deadline::clock::now() + m_channel.m_policy.deadline);
+	if (!sendResult.ok())
+	{
+		m_channel.Disconnect();
+		m_channel.RecordFailure();
+		return sendResult;
+	}
+
+	m_channel.RecordSuccess();
+	return Status::OK;
+}
+
+Status ChannelInterface::Connect(Deadline deadline)
+{
+	Disconnect();
+	return OpenConnection(m_connection, deadline);
+}
+
+Status ChannelInterface::OpenConnection(std::shared_ptr<Connection>& openedConnection, Deadline deadline)
+{
+	while (true)
+	{
+		socket_t clientSocket = InvalidSocket;
+		const Status openResult = OpenSocket(clientSocket, deadline);
+		if (!openResult.ok())
 		{
-			const int lastError = GetLastSocketError();
-			CloseSocket(m_clientSocket);
-			m_clientSocket = InvalidSocket;
-			return {
-				StatusCode::CONNECT_ERROR,
-				"ChannelInterface::Connect: setsockopt() failed; location: " + m_location +
-				"; last error " + std::to_string(lastError)};
+			return openResult;
 		}
+
+		std::shared_ptr<Connection> connection = std::make_shared<Connection>(clientSocket, m_socketOptions.chunkSize);
+		if (m_peerSupportsHandshake)
+		{
+			Status handshakeResult = SendHandshake(connection->socket, CurrentProtocolRevision);
+			if (handshakeResult.ok())
+			{
+				if (!WaitForSocket(connection->socket, false, deadline))
+				{
+					return {
+						StatusCode::CONNECT_ERROR,
+						"ChannelInterface::Connect: handshake timed out; location: " + m_location};
+				}
+
+				handshakeResult = connection->reader.ReceiveHandshake(connection->protocolRevision);
+			}
+
+			if (!handshakeResult.ok())
+			{
+				const bool rejected = handshakeResult.code() == StatusCode::CONNECTION_CLOSED
+					|| handshakeResult.code() == StatusCode::LOGIC_ERROR;
+				if (!rejected)
+				{
+					// e.g. a timeout, the peer may well support the handshake
+					return {
+						StatusCode::CONNECT_ERROR,
+						"ChannelInterface::Connect: handshake failed; location: " + m_location +
+						"; " + handshakeResult.error_message()};
+				}
+
+				// Peers predating the handshake drop the connection on the unknown magic number.
+				// Connect again and talk to them with the legacy protocol revision.
+				m_peerSupportsHandshake = false;
+				continue;
+			}
+		}
+
+		connection->reader.SetNonBlocking(true);
+		openedConnection = std::move(connection);
+		return Status::OK;
 	}
-	else
+}
+
+Status ChannelInterface::OpenSocket(socket_t& clientSocket, Deadline deadline)
+{
+	SocketAddress serverAddress{};
+
+	if (!ParseLocationUri(m_location, serverAddress))
 	{
 		return {
 			StatusCode::CONNECT_ERROR,
 			"ChannelInterface::Connect: failed to parse location; location: " + m_location};
 	}
 
+	// create socket
+	clientSocket = ::socket(serverAddress.family, SocketType, 0);
+	if (clientSocket == InvalidSocket)
+	{
+		return {
+			StatusCode::CONNECT_ERROR,
+			"ChannelInterface::Connect: socket() failed; location: " + m_location +
+			"; last error " + std::to_string(GetLastSocketError())};
+	}
+
+	ResetLastSocketError();
+	if (!SetSocketOptions(clientSocket, serverAddress.family, m_socketOptions))
+	{
+		const int lastError = GetLastSocketError();
+		CloseSocket(clientSocket);
+		clientSocket = InvalidSocket;
+		return {
+			StatusCode::CONNECT_ERROR,
+			"ChannelInterface::Connect: setsockopt() failed; location: " + m_location +
+			"; last error " + std::to_string(lastError)};
+	}
+
+	const Status connectResult = ConnectSocket(clientSocket, serverAddress, deadline);
+	if (!connectResult.ok())
+	{
+		CloseSocket(clientSocket);
+		clientSocket = InvalidSocket;
+		return {
+			StatusCode::CONNECT_ERROR,
+			"ChannelInterface::Connect: " + connectResult.error_message() + "; location: " + m_location};
+	}
+
+	if (!SetSocketTimeouts(clientSocket, m_socketOptions.sendReceiveTimeout))
+	{
+		const int lastError = GetLastSocketError();
+		CloseSocket(clientSocket);
+		clientSocket = InvalidSocket;
+		return {
+			StatusCode::CONNECT_ERROR,
+			"ChannelInterface::Connect: setsockopt() failed; location: " + m_location +
+			"; last error " + std::to_string(lastError)};
+	}
+
 	return Status::OK;
 }
 
+void ChannelInterface::RecordSuccess()
+{
+	m_consecutiveFailures = 0;
+	m_circuitState = CircuitState::Closed;
+}
+
+void ChannelInterface::RecordFailure()
+{
+	++m_consecutiveFailures;
+
+	const bool tripped = m_circuitState == CircuitState::HalfOpen
+		|| (m_policy.failureThreshold != 0 && m_consecutiveFailures >= m_policy.failureThreshold);
+	if (!tripped)
+	{
+		return;
+	}
+
+	m_circuitState = CircuitState::Open;
+	m_circuitOpenUntil = std::chrono::steady_clock::now() + m_policy.openDuration;
+
+	if (m_policy.reconnectInBackground)
+	{
+		StartReconnect();
+	}
+}
+
+void ChannelInterface::StartReconnect()
+{
+	if (m_reconnecting || m_shuttingDown)
+	{
+		return;
+	}
+
+	// the previous reconnect has finished, it only leaves its thread behind
+	if (m_reconnectThread.joinable())
+	{
+		m_reconnectThread.join();
+	}
+
+	m_reconnecting = true;
+	m_reconnectThread = std::thread{&ChannelInterface::Reconnect, this};
+}
+
+void ChannelInterface::Reconnect()
+{
+	std::unique_lock<std::mutex> lock{m_ioMutex};
+
+	Backoff backoff{m_policy};
+	while (!m_shuttingDown && m_circuitState != CircuitState::Closed)
+	{
+		m_reconnectCondition.wait_for(lock, backoff.Next());
+		if (m_shuttingDown || m_circuitState == CircuitState::Closed)
+		{
+			break;
+		}
+
+		// calls keep failing fast instead of waiting for the channel while the attempt is in progress
+		std::shared_ptr<Connection> connection;
+		lock.unlock();
+		const Status connectResult = OpenConnection(connection, Deadline::clock::now() + m_policy.deadline);
+		lock.lock();
+
+		if (connectResult.ok() && !m_shuttingDown)
+		{
+			// a trial call may have connected meanwhile, then the new connection is closed again
+			if (!m_connection)
+			{
+				m_connection = std::move(connection);
+			}
+			RecordSuccess();
+		}
+	}
+
+	m_reconnecting = false;
+}
+
+void ChannelInterface::Disconnect()
+{
+	if (m_connection)
+	{
+		m_connection->Abort({StatusCode::CONNECTION_CLOSED, "ChannelInterface: connection closed"});
+		m_connection.reset();
+	}
+}
+
 } // namespace SocketIO
 
 } // namespace Transport
@@ -24,14 +24,20 @@
 #pragma once
 
 #include "ClientContext.h"
+#include "ConnectionPolicy.h"
 #include "Socket.h"
 #include "Status.h"
 
 #include <google/protobuf/message_lite.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <mutex>
+#include <thread>
 
 namespace TVRemoteScreenSDKCommunication
 {
@@ -44,8 +50,51 @@ namespace SocketIO
 
 class ChannelInterface final
 {
+	struct Connection;
+
 public:
-	explicit ChannelInterface(std::string location);
+	// Sends the request of one call as a sequence of frames, the server hands them over to its
+	// stream function as they arrive. Peers predating ProtocolRevision_Streaming do not accept
+	// streams, Open() tells so and the caller sends its request with a single call instead.
+	// A stream destroyed before being finished cancels the call.
+	// The tail of a frame is sent right after it as part of the same frame, without being copied.
+	class ClientStream final
+	{
+	public:
+		ClientStream(ChannelInterface& channel, std::string comId, int64_t functionId);
+		~ClientStream();
+
+		ClientStream(const ClientStream&) = delete;
+		ClientStream& operator=(const ClientStream&) = delete;
+
+		// Connects to the peer unless done by an earlier call already. Writing to the stream
+		// fails if streamsSupported is false.
+		Status Open(bool& streamsSupported);
+
+		Status Write(std::shared_ptr<std::string> frame, FrameBuffer frameTail = {});
+
+		Status Finish(std::shared_ptr<std::string> lastFrame, std::shared_ptr<std::string>& response);
+		Status Finish(std::shared_ptr<std::string> lastFrame, FrameBuffer lastFrameTail, std::shared_ptr<std::string>& response);
+
+	private:
+		Status Start();
+		Status Send(std::shared_ptr<std::string> frame, FrameBuffer frameTail, uint16_t flags);
+
+		ChannelInterface& m_channel;
+		const std::string m_comId;
+		const int64_t m_functionId;
+
+		std::shared_ptr<Connection> m_connection;
+		uint64_t m_callId = 0;
+
+		bool m_streamsSupported = false;
+
+		Status m_status = Status::OK;
+		bool m_started = false;
+		bool m_finished = false;
+	};
+
+	explicit ChannelInterface(std::string location, ConnectionPolicy policy = {}, SocketOptions socketOptions = {});
 	~ChannelInterface();
 
 	Status Call(
@@ -54,6 +103,14 @@ public:
 		std::shared_ptr<std::string>&& request,
 		std::shared_ptr<std::string>& response);
 
+	// The request is followed by requestTail, which is sent without being copied.
+	Status Call(
+		const std::string& comId,
+		int64_t functionId,
+		std::shared_ptr<std::string>&& request,
+		FrameBuffer requestTail,
+		std::shared_ptr<std::string>& response);
+
 	Status Call( // TODO REMOVE
 		const ClientContext& context,
 		int64_t functionId,
@@ -66,16 +123,57 @@ public:
 		const ::google::protobuf::MessageLite& request,
 		::google::protobuf::MessageLite& response);
 
+	std::unique_ptr<ClientStream> OpenStream(const std::string& comId, int64_t functionId);
 
 private:
-	Status Connect();
+	enum class CircuitState
+	{
+		// calls are attempted normally
+		Closed,
+		// the peer is considered down, calls fail immediately
+		Open,
+		// the open duration has passed, the next call is a single trial attempt
+		HalfOpen,
+	};
+
+	static Status TakeResponse(
+		const std::string& comId,
+		int64_t functionId,
+		Envelope& envelope,
+		std::shared_ptr<std::string>& response);
+
+	Status Connect(Deadline deadline);
+
+	// Connects and shakes hands without touching the current connection, m_ioMutex need not be held.
+	Status OpenConnection(std::shared_ptr<Connection>& openedConnection, Deadline deadline);
+	Status OpenSocket(socket_t& clientSocket, Deadline deadline);
+	void Disconnect();
+
+	// The circuit helpers expect m_ioMutex to be held.
+	void RecordSuccess();
+	void RecordFailure();
+	void StartReconnect();
+	void Reconnect();
 
 	std::shared_ptr<SocketSetup> m_socketSetup;
 
 	const std::string m_location;
+	const ConnectionPolicy m_policy;
+	const SocketOptions m_socketOptions;
 
 	std::mutex m_ioMutex;
-	socket_t m_clientSocket;
+	std::shared_ptr<Connection> m_connection;
+	std::atomic<bool> m_peerSupportsHandshake{true};
+	uint64_t m_lastCallId = 0;
+
+	CircuitState m_circuitState = CircuitState::Closed;
+	uint32_t m_consecutiveFailures = 0;
+	std::chrono::steady_clock::time_point m_circuitOpenUntil;
+
+	std::condition_variable m_reconnectCondition;
+	std::thread m_reconnectThread;
+	bool m_reconnecting = false;
+	bool m_shuttingDown = false;
 };
 
 } // namespace SocketIO
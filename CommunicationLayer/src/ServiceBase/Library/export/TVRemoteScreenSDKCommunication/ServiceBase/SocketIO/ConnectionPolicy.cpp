@@ -0,0 +1,78 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include "ConnectionPolicy.h"
+
+#include <algorithm>
+
+namespace TVRemoteScreenSDKCommunication
+{
+
+namespace Transport
+{
+
+namespace SocketIO
+{
+
+Backoff::Backoff(const ConnectionPolicy& policy)
+	: m_policy(policy)
+	, m_current(policy.initialBackoff)
+{
+}
+
+std::chrono::milliseconds Backoff::Next()
+{
+	const std::chrono::milliseconds delay = m_current;
+
+	const double grown = static_cast<double>(m_current.count()) * std::max(m_policy.backoffMultiplier, 1.0);
+	m_current = std::min(
+		std::chrono::milliseconds{static_cast<std::chrono::milliseconds::rep>(grown)},
+		m_policy.maxBackoff);
+
+	if (m_policy.jitter <= 0.0)
+	{
+		return delay;
+	}
+
+	// spread the attempts of several clients, so they do not hit a restarting peer all at once
+	if (!m_seeded)
+	{
+		m_random.seed(std::random_device{}());
+		m_seeded = true;
+	}
+
+	std::uniform_real_distribution<double> distribution{1.0 - m_policy.jitter, 1.0 + m_policy.jitter};
+	const double jittered = static_cast<double>(delay.count()) * distribution(m_random);
+	return std::chrono::milliseconds{static_cast<std::chrono::milliseconds::rep>(std::max(jittered, 0.0))};
+}
+
+void Backoff::Reset()
+{
+	m_current = m_policy.initialBackoff;
+}
+
+} // namespace SocketIO
+
+} // namespace Transport
+
+} // namespace TVRemoteScreenSDKCommunication
@@ -0,0 +1,93 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+namespace TVRemoteScreenSDKCommunication
+{
+
+namespace Transport
+{
+
+namespace SocketIO
+{
+
+/**
+ * @brief ConnectionPolicy controls how a ChannelInterface deals with an unreachable peer.
+ * Failed connection attempts are retried with exponential backoff until either the attempts
+ * or the deadline of the call are used up. After enough failed calls in a row the circuit opens:
+ * further calls fail immediately while a background task tries to reconnect.
+ */
+struct ConnectionPolicy final
+{
+	// connection attempts per call, including the first one
+	uint32_t maxAttempts = 10;
+
+	std::chrono::milliseconds initialBackoff{50};
+	std::chrono::milliseconds maxBackoff{1000};
+	double backoffMultiplier = 2.0;
+
+	// each delay is varied randomly by up to this fraction, 0 disables jitter
+	double jitter = 0.2;
+
+	// time a call may spend connecting, sending and waiting for the response, retries included
+	std::chrono::milliseconds deadline{3000};
+
+	// consecutive failed calls opening the circuit, 0 disables the circuit breaker
+	uint32_t failureThreshold = 3;
+
+	// calls fail immediately for this long once the circuit opened, then a single trial call is let through
+	std::chrono::milliseconds openDuration{2000};
+
+	bool reconnectInBackground = true;
+};
+
+/**
+ * @brief Backoff hands out the delays between connection attempts of a ConnectionPolicy.
+ * The random generator for the jitter is seeded with the first delay, so calls which succeed
+ * right away do not pay for it.
+ */
+class Backoff final
+{
+public:
+	explicit Backoff(const ConnectionPolicy& policy);
+
+	std::chrono::milliseconds Next();
+	void Reset();
+
+private:
+	const ConnectionPolicy& m_policy;
+	std::chrono::milliseconds m_current;
+	std::minstd_rand m_random;
+	bool m_seeded = false;
+};
+
+} // namespace SocketIO
+
+} // namespace Transport
+
+} // namespace TVRemoteScreenSDKCommunication
@@ -30,10 +30,19 @@ typedef int socklen_t;
 #pragma comment(lib, "coredll.lib")
 #endif // _WINCE
 #else
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <arpa/inet.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <iterator>
 #include <iostream>
 
 namespace TVRemoteScreenSDKCommunication
@@ -45,11 +54,130 @@ namespace Transport
 namespace SocketIO
 {
 
-Server::Server(ServerFunctionMap functions)
+namespace
+{
+
+// Joins the frames of a streamed call to a function only handling whole requests.
+class JoinedStream final : public Server::Stream
+{
+public:
+	JoinedStream(const Server::ServerFunction& function, std::string comId)
+		: m_function(function)
+		, m_comId(std::move(comId))
+		, m_request(std::make_shared<std::string>())
+	{
+	}
+
+	Status Read(std::string& frame) override
+	{
+		m_request->append(frame);
+		return Status::OK;
+	}
+
+	Status Finish(std::string& response) override
+	{
+		const auto responseData = std::make_shared<std::string>();
+		const Status status = m_function(m_comId, std::move(m_request), responseData);
+		response.swap(*responseData);
+		return status;
+	}
+
+	void Cancel() override
+	{
+	}
+
+private:
+	const Server::ServerFunction& m_function;
+	const std::string m_comId;
+	std::shared_ptr<std::string> m_request;
+};
+
+} // namespace
+
+struct Server::ActiveStream final
+{
+	~ActiveStream()
+	{
+		// the connection ended in the middle of the call
+		if (stream)
+		{
+			stream->Cancel();
+		}
+	}
+
+	// reset once the call has been finished or cancelled
+	std::unique_ptr<Stream> stream;
+
+	// the first error ends the call, the remaining frames are only received
+	Status status = Status::OK;
+};
+
+#if !(defined(_WIN32) || defined(_WINCE))
+struct Server::RequestQueue final
+{
+	std::deque<Envelope> requests;
+
+	// set while a worker drains the queue
+	bool draining = false;
+};
+
+struct Server::Endpoint final
+{
+	Endpoint(socket_t endpointSocket, size_t chunkSize)
+		: socket(endpointSocket)
+		, reader(endpointSocket, ReadBufferSize, chunkSize)
+	{
+		// a worker reads what has arrived and leaves the rest of the frame to the next readiness event
+		reader.SetNonBlocking(true);
+	}
+
+	~Endpoint()
+	{
+		CloseSocket(socket);
+	}
+
+	const socket_t socket;
+
+	// only used by the one task reading the next request of the endpoint, keeps a partially received frame
+	FrameReader reader;
+
+	// written once by the handshake, before further requests of the endpoint are handled
+	std::atomic<uint32_t> protocolRevision{ProtocolRevision_Legacy};
+
+	// requests may be handled concurrently from ProtocolRevision_CallId on, responses must not interleave
+	std::mutex sendMutex;
+
+	// only used by the one task reading the next request of the endpoint
+	ActiveStreams streams;
+
+	// guards the queues of ordered and latest-only requests
+	std::mutex dispatchMutex;
+	RequestQueue orderedRequests;
+	std::unordered_map<int64_t, RequestQueue> latestOnlyRequests;
+};
+
+#endif
+
+Server::Server(
+	ServerFunctionMap functions,
+	ConnectionMode connectionMode,
+	size_t numberOfWorkerThreads,
+	DispatchPolicyMap dispatchPolicies,
+	SocketOptions socketOptions,
+	StreamFunctionMap streamFunctions)
 	: m_serverFunctions(std::move(functions))
+	, m_connectionMode(connectionMode)
+	, m_numberOfWorkerThreads(numberOfWorkerThreads)
+	, m_dispatchPolicies(std::move(dispatchPolicies))
+	, m_socketOptions(std::move(socketOptions))
+	, m_streamFunctions(std::move(streamFunctions))
 	, m_serverSocket(InvalidSocket)
 	, m_endpoint(InvalidSocket)
 	, m_socketSetup(QuerySockets())
+#if !(defined(_WIN32) || defined(_WINCE))
+	, m_pollDescriptor(-1)
+	, m_wakeupDescriptor(-1)
+#endif
 {
 }
 
@@ -65,7 +193,17 @@ Envelope Server::HandleRequest(Envelope request)
 	Envelope response;
 	response.comId = request.comId;
 	response.functionId = request.functionId;
-	response.data = std::make_shared<std::string>();
+	response.callId = request.callId;
+
+	// The response of the previous request handled on this thread has been sent by now,
+	// unless something still holds on to it, its buffer is reused.
+	static thread_local std::shared_ptr<std::string> responseBuffer;
+	if (!responseBuffer || responseBuffer.use_count() != 1 || responseBuffer->capacity() > MaxRetainedMessageSize)
+	{
+		responseBuffer = std::make_shared<std::string>();
+	}
+	responseBuffer->clear();
+	response.data = responseBuffer;
 
 	Status logicStatus = registeredFunction != m_serverFunctions.cend() ?
 		registeredFunction->second(request.comId, std::move(request.data), response.data) :
@@ -77,6 +215,88 @@ Envelope Server::HandleRequest(Envelope request)
 	return response;
 }
 
+bool Server::IsStreamFrame(const ActiveStreams& streams, const Envelope& envelope)
+{
+	return (envelope.flags & (EnvelopeFlag_MoreFrames | EnvelopeFlag_Cancelled)) != 0
+		|| streams.find(envelope.callId) != streams.cend();
+}
+
+bool Server::HandleStreamFrame(ActiveStreams& streams, Envelope frame, Envelope& response)
+{
+	const bool isNewCall = streams.find(frame.callId) == streams.cend();
+	ActiveStream& call = streams[frame.callId];
+	if (isNewCall)
+	{
+		call.stream = OpenStream(frame.functionId, frame.comId);
+		if (!call.stream)
+		{
+			call.status = {StatusCode::LOGIC_ERROR, "no function registered for id " + std::to_string(frame.functionId)};
+		}
+	}
+
+	if ((frame.flags & EnvelopeFlag_Cancelled) != 0)
+	{
+		streams.erase(frame.callId);
+		return false;
+	}
+
+	if (call.status.ok())
+	{
+		call.status = call.stream->Read(*frame.data);
+		if (!call.status.ok())
+		{
+			call.stream->Cancel();
+			call.stream.reset();
+		}
+	}
+	frame.data.reset();
+
+	if ((frame.flags & EnvelopeFlag_MoreFrames) != 0)
+	{
+		return false;
+	}
+
+	response.comId = frame.comId;
+	response.functionId = frame.functionId;
+	response.callId = frame.callId;
+	response.data = std::make_shared<std::string>();
+
+	Status logicStatus = call.status;
+	if (call.stream)
+	{
+		logicStatus = call.stream->Finish(*response.data);
+		call.stream.reset();
+	}
+	streams.erase(frame.callId);
+
+	response.statusCode = static_cast<decltype(response.statusCode)>(logicStatus.code());
+	response.statusMessage = logicStatus.error_message();
+	return true;
+}
+
+std::unique_ptr<Server::Stream> Server::OpenStream(int64_t functionId, const std::string& comId)
+{
+	const auto foundStreamFunction = m_streamFunctions.find(functionId);
+	if (foundStreamFunction != m_streamFunctions.cend())
+	{
+		return foundStreamFunction->second(comId);
+	}
+
+	const auto foundFunction = m_serverFunctions.find(functionId);
+	if (foundFunction != m_serverFunctions.cend())
+	{
+		return std::unique_ptr<Stream>{new JoinedStream{foundFunction->second, comId}};
+	}
+
+	return {};
+}
+
+Server::DispatchPolicy Server::GetDispatchPolicy(int64_t functionId) const
+{
+	const auto foundPolicy = m_dispatchPolicies.find(functionId);
+	return foundPolicy != m_dispatchPolicies.cend() ? foundPolicy->second : DispatchPolicy::Ordered;
+}
+
 void Server::HandleConnections()
 {
 	bool keepRunning = true;
@@ -95,7 +315,7 @@ void Server::HandleConnections()
 			return;
 		}
 
-		sockaddr_in client{};
+		sockaddr_storage client{};
 		int clientAddrLength = sizeof(client);
 		endpoint = ::accept(serverSocket, reinterpret_cast<sockaddr*>(&client), reinterpret_cast<socklen_t*>(&clientAddrLength));
 
@@ -104,12 +324,10 @@ void Server::HandleConnections()
 			continue;
 		}
 
-		timeval timeout{};
-		timeout.tv_sec = SendReceiveTimeout;
-
-		if (::setsockopt(endpoint, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) != 0)
+		if (!SetSocketTimeouts(endpoint, m_socketOptions.sendReceiveTimeout, false))
 		{
 			std::cerr << "Server::HandleConnections: setsockopt() failed " << GetLastSocketError() << std::endl;
+			CloseSocket(endpoint);
 			continue;
 		}
 
@@ -119,10 +337,14 @@ void Server::HandleConnections()
 			m_endpoint = endpoint;
 		}
 
+		FrameReader reader{endpoint, ReadBufferSize, m_socketOptions.chunkSize};
+		ActiveStreams streams;
+
 		while (keepRunning)
 		{
 			// send preamble
-			Status preambleResult = ReceivePreamble(endpoint);
+			uint32_t magic = 0;
+			Status preambleResult = reader.ReceivePreamble(magic);
 			if (preambleResult.code() == StatusCode::CONNECTION_CLOSED)
 			{
 				// Client has been disconnected. Waiting for another client.
@@ -136,9 +358,24 @@ void Server::HandleConnections()
 				break;
 			}
 
+			if (magic == MagicHandshake)
+			{
+				// Requests are answered in order, which satisfies every protocol revision,
+				// the reader keeps the revision for the envelope format.
+				uint32_t protocolRevision = ProtocolRevision_Legacy;
+				Status handshakeResult = reader.AcceptHandshake(protocolRevision);
+				if (!handshakeResult.ok())
+				{
+					std::cerr << "Server::HandleConnections: handshake failed; "
+						<< handshakeResult.error_message() << std::endl;
+					break;
+				}
+				continue;
+			}
+
 			// receive request envelope
 			Envelope envelope{};
-			Status receiveResult = ReceiveEnvelope(endpoint, envelope);
+			Status receiveResult = reader.ReceiveEnvelope(envelope);
 
 			if (!receiveResult.ok())
 			{
@@ -148,9 +385,18 @@ void Server::HandleConnections()
 			}
 
 			Status sendResult = Status::OK;
+			if (IsStreamFrame(streams, envelope))
+			{
+				Envelope response;
+				if (HandleStreamFrame(streams, std::move(envelope), response))
+				{
+					sendResult = SendEnvelope(endpoint, response, reader.GetProtocolRevision());
+				}
+			}
+			else
 			{
 				Envelope response = HandleRequest(std::move(envelope));
-				sendResult = SendEnvelope(endpoint, response);
+				sendResult = SendEnvelope(endpoint, response, reader.GetProtocolRevision());
 			}
 
 			if (!sendResult.ok())
@@ -168,6 +414,9 @@ void Server::HandleConnections()
 			keepRunning = serverSocket != InvalidSocket;
 		}
 
+		// streams still open are cancelled
+		streams.clear();
+
 		CloseSocket(endpoint);
 		endpoint = InvalidSocket;
 		{
@@ -179,13 +428,12 @@ void Server::HandleConnections()
 
 bool Server::Start(const std::string& locationUri)
 {
-	sockaddr_in serverAddress{};
+	SocketAddress serverAddress{};
 
-	if (!ParseLocationUri(locationUri, serverAddress.sin_addr, serverAddress.sin_port))
+	if (!ParseLocationUri(locationUri, serverAddress))
 	{
 		return false;
 	}
-	serverAddress.sin_family = AF_INET;
 
 	Shutdown();
 
@@ -193,7 +441,7 @@ bool Server::Start(const std::string& locationUri)
 
 	// setup socket
 	ResetLastSocketError();
-	m_serverSocket = ::socket(AF_INET, SocketType, 0);
+	m_serverSocket = ::socket(serverAddress.family, SocketType, 0);
 	if (m_serverSocket == InvalidSocket)
 	{
 		std::cerr << "Server::Startup: socket() failed " << GetLastSocketError() << std::endl;
@@ -210,7 +458,18 @@ bool Server::Start(const std::string& locationUri)
 
 	int socketOptions = 1;
 	ResetLastSocketError();
-	if (::setsockopt(m_serverSocket, SOL_SOCKET, optName, reinterpret_cast<socketopt_t*>(&socketOptions), sizeof(socketOptions)) != 0)
+	if (serverAddress.family == AF_INET &&
+		::setsockopt(m_serverSocket, SOL_SOCKET, optName, reinterpret_cast<socketopt_t*>(&socketOptions), sizeof(socketOptions)) != 0)
+	{
+		std::cerr << "Server::Startup: setsockopt() failed " << GetLastSocketError() << std::endl;
+		CloseSocket(m_serverSocket);
+		m_serverSocket = InvalidSocket;
+		return false;
+	}
+
+	// set before listening, buffer sizes affect the TCP window negotiated on connect
+	ResetLastSocketError();
+	if (!SetSocketOptions(m_serverSocket, serverAddress.family, m_socketOptions))
 	{
 		std::cerr << "Server::Startup: setsockopt() failed " << GetLastSocketError() << std::endl;
 		CloseSocket(m_serverSocket);
@@ -218,9 +477,20 @@ bool Server::Start(const std::string& locationUri)
 		return false;
 	}
 
+#if !(defined(_WIN32) || defined(_WINCE))
+	// a socket file left behind by a server which did not shut down makes bind() fail
+	struct stat socketFileStatus{};
+	if (!serverAddress.path.empty() &&
+		::stat(serverAddress.path.c_str(), &socketFileStatus) == 0 &&
+		S_ISSOCK(socketFileStatus.st_mode))
+	{
+		::unlink(serverAddress.path.c_str());
+	}
+#endif
+
 	// bind address and listen
 	ResetLastSocketError();
-	if (::bind(m_serverSocket, reinterpret_cast<sockaddr*>(&serverAddress), sizeof(serverAddress)) < 0)
+	if (::bind(m_serverSocket, serverAddress.get(), serverAddress.length) < 0)
 	{
 		std::cerr << "Server::Startup: setsockopt() failed " << GetLastSocketError() << std::endl;
 		CloseSocket(m_serverSocket);
@@ -228,15 +498,38 @@ bool Server::Start(const std::string& locationUri)
 		return false;
 	}
 
+	m_socketPath = serverAddress.path;
+
 	ResetLastSocketError();
-	if (::listen(m_serverSocket, MaxBacklogSize) < 0)
+	if (::listen(m_serverSocket, m_socketOptions.maxBacklogSize) < 0)
 	{
 		std::cerr << "Server::Startup: setsockopt() failed " << GetLastSocketError() << std::endl;
 		CloseSocket(m_serverSocket);
 		m_serverSocket = InvalidSocket;
+		RemoveSocketFile();
 		return false;
 	}
 
+#if !(defined(_WIN32) || defined(_WINCE))
+	if (m_connectionMode == ConnectionMode::Multiplexed)
+	{
+		if (!StartEventLoop())
+		{
+			CloseSocket(m_serverSocket);
+			m_serverSocket = InvalidSocket;
+			RemoveSocketFile();
+			return false;
+		}
+
+		m_communicationThread = std::thread([this]()
+		{
+			HandleEvents();
+		});
+
+		return true;
+	}
+#endif
+
 	m_communicationThread = std::thread([this]()
 	{
 		HandleConnections();
@@ -255,14 +548,466 @@ void Server::Shutdown()
 
 		CloseSocket(m_serverSocket);
 		m_serverSocket = InvalidSocket;
+		RemoveSocketFile();
+
+#if !(defined(_WIN32) || defined(_WINCE))
+		// unblock request handlers waiting for data and wake up the event loop
+		for (const auto& endpoint : m_endpoints)
+		{
+			ShutdownSocket(endpoint.first);
+		}
+
+		if (m_wakeupDescriptor != -1)
+		{
+			const uint64_t wakeup = 1;
+			if (::write(m_wakeupDescriptor, &wakeup, sizeof(wakeup)) != sizeof(wakeup))
+			{
+				std::cerr << "Server::Shutdown: waking up event loop failed " << GetLastSocketError() << std::endl;
+			}
+		}
+#endif
 	}
 
 	if (m_communicationThread.joinable())
 	{
 		m_communicationThread.join();
 	}
+
+#if !(defined(_WIN32) || defined(_WINCE))
+	StopEventLoop();
+#endif
+}
+
+void Server::RemoveSocketFile()
+{
+	// called with m_ioMutex locked
+#if !(defined(_WIN32) || defined(_WINCE))
+	if (!m_socketPath.empty())
+	{
+		::unlink(m_socketPath.c_str());
+	}
+#endif
+	m_socketPath.clear();
+}
+
+#if !(defined(_WIN32) || defined(_WINCE))
+bool Server::StartEventLoop()
+{
+	// called with m_ioMutex locked
+	auto closeDescriptors = [this]()
+	{
+		if (m_pollDescriptor != -1)
+		{
+			::close(m_pollDescriptor);
+			m_pollDescriptor = -1;
+		}
+
+		if (m_wakeupDescriptor != -1)
+		{
+			::close(m_wakeupDescriptor);
+			m_wakeupDescriptor = -1;
+		}
+	};
+
+	const int flags = ::fcntl(m_serverSocket, F_GETFL, 0);
+	if (flags < 0 || ::fcntl(m_serverSocket, F_SETFL, flags | O_NONBLOCK) < 0)
+	{
+		std::cerr << "Server::Startup: fcntl() failed " << GetLastSocketError() << std::endl;
+		return false;
+	}
+
+	m_pollDescriptor = ::epoll_create1(EPOLL_CLOEXEC);
+	m_wakeupDescriptor = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+	if (m_pollDescriptor < 0 || m_wakeupDescriptor < 0)
+	{
+		std::cerr << "Server::Startup: creating event loop failed " << GetLastSocketError() << std::endl;
+		closeDescriptors();
+		return false;
+	}
+
+	epoll_event serverEvent{};
+	serverEvent.events = EPOLLIN;
+	serverEvent.data.fd = m_serverSocket;
+
+	epoll_event wakeupEvent{};
+	wakeupEvent.events = EPOLLIN;
+	wakeupEvent.data.fd = m_wakeupDescriptor;
+
+	if (::epoll_ctl(m_pollDescriptor, EPOLL_CTL_ADD, m_serverSocket, &serverEvent) != 0 ||
+		::epoll_ctl(m_pollDescriptor, EPOLL_CTL_ADD, m_wakeupDescriptor, &wakeupEvent) != 0)
+	{
+		std::cerr << "Server::Startup: epoll_ctl() failed " << GetLastSocketError() << std::endl;
+		closeDescriptors();
+		return false;
+	}
+
+	m_workers.reset(new ThreadPool{m_numberOfWorkerThreads});
+
+	return true;
+}
+
+void Server::StopEventLoop()
+{
+	if (m_workers)
+	{
+		m_workers->Shutdown();
+		m_workers.reset();
+	}
+
+	const std::lock_guard<std::mutex> lock{m_ioMutex};
+
+	// the sockets are closed as soon as the last request handler releases its endpoint
+	m_endpoints.clear();
+
+	if (m_pollDescriptor != -1)
+	{
+		::close(m_pollDescriptor);
+		m_pollDescriptor = -1;
+	}
+
+	if (m_wakeupDescriptor != -1)
+	{
+		::close(m_wakeupDescriptor);
+		m_wakeupDescriptor = -1;
+	}
+}
+
+void Server::HandleEvents()
+{
+	constexpr int MaxEvents = 32;
+	epoll_event events[MaxEvents];
+
+	int pollDescriptor = -1;
+	int wakeupDescriptor = -1;
+	socket_t serverSocket = InvalidSocket;
+	{
+		const std::lock_guard<std::mutex> lock{m_ioMutex};
+		pollDescriptor = m_pollDescriptor;
+		wakeupDescriptor = m_wakeupDescriptor;
+		serverSocket = m_serverSocket;
+	}
+
+	while (true)
+	{
+		const int eventCount = ::epoll_wait(pollDescriptor, events, MaxEvents, -1);
+		if (eventCount < 0)
+		{
+			if (GetLastSocketError() == EINTR)
+			{
+				continue;
+			}
+
+			std::cerr << "Server::HandleEvents: epoll_wait() failed " << GetLastSocketError() << std::endl;
+			return;
+		}
+
+		for (int i = 0; i < eventCount; ++i)
+		{
+			const int descriptor = events[i].data.fd;
+			if (descriptor == wakeupDescriptor)
+			{
+				return;
+			}
+
+			if (descriptor == serverSocket)
+			{
+				AcceptEndpoint();
+				continue;
+			}
+
+			std::shared_ptr<Endpoint> endpoint;
+			{
+				const std::lock_guard<std::mutex> lock{m_ioMutex};
+				const auto foundEndpoint = m_endpoints.find(descriptor);
+				if (foundEndpoint != m_endpoints.end())
+				{
+					endpoint = foundEndpoint->second;
+				}
+			}
+
+			if (!endpoint)
+			{
+				continue;
+			}
+
+			// The endpoint is registered as one-shot, so no further events are reported for it
+			// until it has been rearmed. This keeps the requests of an endpoint in order.
+			m_workers->Post([this, endpoint]()
+			{
+				ServeEndpoint(endpoint);
+			});
+		}
+	}
 }
 
+void Server::AcceptEndpoint()
+{
+	const std::lock_guard<std::mutex> lock{m_ioMutex};
+	if (m_serverSocket == InvalidSocket)
+	{
+		return;
+	}
+
+	sockaddr_storage client{};
+	socklen_t clientAddrLength = sizeof(client);
+	const socket_t endpoint = ::accept4(m_serverSocket, reinterpret_cast<sockaddr*>(&client), &clientAddrLength, SOCK_CLOEXEC);
+	if (endpoint == InvalidSocket)
+	{
+		return;
+	}
+
+	// Reads do not block, so a client stalling mid-request does not hold a worker and needs no receive timeout.
+	if (!SetSocketTimeouts(endpoint, m_socketOptions.sendReceiveTimeout, false))
+	{
+		std::cerr << "Server::AcceptEndpoint: setsockopt() failed " << GetLastSocketError() << std::endl;
+		CloseSocket(endpoint);
+		return;
+	}
+
+	epoll_event endpointEvent{};
+	endpointEvent.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+	endpointEvent.data.fd = endpoint;
+
+	if (::epoll_ctl(m_pollDescriptor, EPOLL_CTL_ADD, endpoint, &endpointEvent) != 0)
+	{
+		std::cerr << "Server::AcceptEndpoint: epoll_ctl() failed " << GetLastSocketError() << std::endl;
+		CloseSocket(endpoint);
+		return;
+	}
+
+	m_endpoints[endpoint] = std::make_shared<Endpoint>(endpoint, m_socketOptions.chunkSize);
+}
+
+void Server::ServeEndpoint(const std::shared_ptr<Endpoint>& endpoint)
+{
+	uint32_t magic = 0;
+	Envelope envelope{};
+	bool complete = false;
+	Status receiveResult = endpoint->reader.ReceiveFrame(magic, envelope, complete);
+	if (receiveResult.code() == StatusCode::CONNECTION_CLOSED)
+	{
+		CloseEndpoint(endpoint);
+		return;
+	}
+
+	if (!receiveResult.ok())
+	{
+		std::cerr << "Server::ServeEndpoint: Error receiving frame; "
+			<< receiveResult.error_message() << std::endl;
+		CloseEndpoint(endpoint);
+		return;
+	}
+
+	if (!complete)
+	{
+		// the rest of the frame has not arrived yet
+		RearmEndpoint(endpoint);
+		return;
+	}
+
+	if (magic == MagicHandshake)
+	{
+		endpoint->protocolRevision = endpoint->reader.GetProtocolRevision();
+		ContinueEndpoint(endpoint);
+		return;
+	}
+
+	// The frames of a streamed call are handed over before the next envelope is read,
+	// so they arrive in order and a client sending faster than they are consumed is held back.
+	if (IsStreamFrame(endpoint->streams, envelope))
+	{
+		Envelope response;
+		if (!HandleStreamFrame(endpoint->streams, std::move(envelope), response) || SendResponse(endpoint, response))
+		{
+			ContinueEndpoint(endpoint);
+		}
+		return;
+	}
+
+	// Clients of older revisions match responses by their order,
+	// so the next request is not read before this one has been answered.
+	if (endpoint->protocolRevision < ProtocolRevision_CallId)
+	{
+		if (SendResponse(endpoint, HandleRequest(std::move(envelope))))
+		{
+			ContinueEndpoint(endpoint);
+		}
+		return;
+	}
+
+	// Clients matching responses by call id may have further requests in flight,
+	// so the next one can already be picked up while this one is being handled.
+	const DispatchPolicy policy = GetDispatchPolicy(envelope.functionId);
+	if (policy == DispatchPolicy::Concurrent)
+	{
+		ContinueEndpoint(endpoint);
+		SendResponse(endpoint, HandleRequest(std::move(envelope)));
+		return;
+	}
+
+	// queued before the next request is read to keep the arrival order
+	std::vector<Envelope> superseded;
+	RequestQueue* queue = EnqueueRequest(endpoint, std::move(envelope), policy, superseded);
+
+	ContinueEndpoint(endpoint);
+
+	for (const Envelope& request : superseded)
+	{
+		Envelope response;
+		response.comId = request.comId;
+		response.functionId = request.functionId;
+		response.callId = request.callId;
+		response.data = std::make_shared<std::string>();
+		response.statusCode = static_cast<decltype(response.statusCode)>(StatusCode::CANCELLED);
+		response.statusMessage = "superseded by a newer request";
+
+		if (!SendResponse(endpoint, response))
+		{
+			return;
+		}
+	}
+
+	if (queue)
+	{
+		DrainRequests(endpoint, *queue);
+	}
+}
+
+Server::RequestQueue* Server::EnqueueRequest(
+	const std::shared_ptr<Endpoint>& endpoint,
+	Envelope request,
+	DispatchPolicy policy,
+	std::vector<Envelope>& superseded)
+{
+	const std::lock_guard<std::mutex> lock{endpoint->dispatchMutex};
+
+	RequestQueue* queue = &endpoint->orderedRequests;
+	if (policy == DispatchPolicy::LatestOnly)
+	{
+		// element references of an unordered_map stay valid when further functions are added
+		queue = &endpoint->latestOnlyRequests[request.functionId];
+
+		// The queued request has not been started yet and the new one makes it obsolete.
+		std::move(queue->requests.begin(), queue->requests.end(), std::back_inserter(superseded));
+		queue->requests.clear();
+	}
+
+	queue->requests.push_back(std::move(request));
+
+	if (queue->draining)
+	{
+		// the worker draining the queue picks the request up
+		return nullptr;
+	}
+
+	queue->draining = true;
+	return queue;
+}
+
+void Server::DrainRequests(const std::shared_ptr<Endpoint>& endpoint, RequestQueue& queue)
+{
+	while (true)
+	{
+		Envelope request;
+		{
+			const std::lock_guard<std::mutex> lock{endpoint->dispatchMutex};
+			if (queue.requests.empty())
+			{
+				queue.draining = false;
+				return;
+			}
+
+			request = std::move(queue.requests.front());
+			queue.requests.pop_front();
+		}
+
+		if (!SendResponse(endpoint, HandleRequest(std::move(request))))
+		{
+			// the endpoint is closed, the remaining requests are dropped with it
+			return;
+		}
+	}
+}
+
+bool Server::SendResponse(const std::shared_ptr<Endpoint>& endpoint, const Envelope& response)
+{
+	Status sendResult = Status::OK;
+	{
+		const std::lock_guard<std::mutex> sendLock{endpoint->sendMutex};
+		sendResult = SendEnvelope(endpoint->socket, response, endpoint->protocolRevision);
+	}
+
+	if (!sendResult.ok())
+	{
+		std::cerr << "Server::SendResponse: Error sending envelope; "
+			<< sendResult.error_message() << std::endl;
+		CloseEndpoint(endpoint);
+		return false;
+	}
+
+	return true;
+}
+
+void Server::ContinueEndpoint(const std::shared_ptr<Endpoint>& endpoint)
+{
+	if (!endpoint->reader.HasBufferedData())
+	{
+		RearmEndpoint(endpoint);
+		return;
+	}
+
+	// The next request has been read along with the last one and will not be reported by epoll.
+	const std::lock_guard<std::mutex> lock{m_ioMutex};
+	const auto foundEndpoint = m_endpoints.find(endpoint->socket);
+	if (foundEndpoint == m_endpoints.end() || foundEndpoint->second != endpoint || !m_workers)
+	{
+		return;
+	}
+
+	m_workers->Post([this, endpoint]()
+	{
+		ServeEndpoint(endpoint);
+	});
+}
+
+void Server::RearmEndpoint(const std::shared_ptr<Endpoint>& endpoint)
+{
+	const std::lock_guard<std::mutex> lock{m_ioMutex};
+	const auto foundEndpoint = m_endpoints.find(endpoint->socket);
+	if (foundEndpoint == m_endpoints.end() || foundEndpoint->second != endpoint)
+	{
+		return;
+	}
+
+	epoll_event endpointEvent{};
+	endpointEvent.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+	endpointEvent.data.fd = endpoint->socket;
+
+	if (::epoll_ctl(m_pollDescriptor, EPOLL_CTL_MOD, endpoint->socket, &endpointEvent) != 0)
+	{
+		std::cerr << "Server::RearmEndpoint: epoll_ctl() failed " << GetLastSocketError() << std::endl;
+		m_endpoints.erase(foundEndpoint);
+		ShutdownSocket(endpoint->socket);
+	}
+}
+
+void Server::CloseEndpoint(const std::shared_ptr<Endpoint>& endpoint)
+{
+	const std::lock_guard<std::mutex> lock{m_ioMutex};
+	const auto foundEndpoint = m_endpoints.find(endpoint->socket);
+	if (foundEndpoint == m_endpoints.end() || foundEndpoint->second != endpoint)
+	{
+		return;
+	}
+
+	::epoll_ctl(m_pollDescriptor, EPOLL_CTL_DEL, endpoint->socket, nullptr);
+	m_endpoints.erase(foundEndpoint);
+
+	// handlers of other requests of this endpoint may still be running, they see the socket shut down
+	ShutdownSocket(endpoint->socket);
+}
+#endif
+
 } // namespace SocketIO
 
 } // namespace Transport
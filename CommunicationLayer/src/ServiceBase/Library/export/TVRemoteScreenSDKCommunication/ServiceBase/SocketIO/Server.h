@@ -24,13 +24,16 @@
 #pragma once
 
 #include "Socket.h"
+#include "ThreadPool.h"
 
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace TVRemoteScreenSDKCommunication
 {
@@ -51,7 +54,65 @@ public:
 
 	using ServerFunctionMap = std::unordered_map<int64_t, ServerFunction>;
 
-	explicit Server(ServerFunctionMap functions);
+	// Receives the request of a call sent in several frames, see ProtocolRevision_Streaming.
+	// The frames of a call are read one after another, the next one is not received from
+	// the connection before Read returned, which holds back clients sending faster.
+	class Stream
+	{
+	public:
+		virtual ~Stream() = default;
+
+		// called for every frame in order, the frame may be swapped out, an error ends the call
+		virtual Status Read(std::string& frame) = 0;
+
+		// called after the last frame has been read
+		virtual Status Finish(std::string& response) = 0;
+
+		// the call ends without Finish, either abandoned by the client or by a failing Read
+		virtual void Cancel() = 0;
+	};
+
+	using StreamFunction = std::function<std::unique_ptr<Stream>(const std::string& comId)>;
+
+	// Streamed calls to functions without an entry are joined and handed to their ServerFunction.
+	using StreamFunctionMap = std::unordered_map<int64_t, StreamFunction>;
+
+	// How the requests for one function of an endpoint are dispatched to the worker pool.
+	// Only applies to clients from ProtocolRevision_CallId on, older clients are always served in order.
+	enum class DispatchPolicy
+	{
+		// Handled as soon as a worker is free, alongside any other request of the endpoint.
+		// Only for functions that do not depend on the order of their calls.
+		Concurrent,
+		// Handled one after another in the order they arrive, together with all other
+		// ordered requests of the endpoint. Other requests are not blocked.
+		Ordered,
+		// For idempotent updates: a request still waiting for its predecessor to finish is
+		// replaced by a newer one for the same function and answered with CANCELLED without being handled.
+		LatestOnly,
+	};
+
+	// functions without an entry are dispatched in order
+	using DispatchPolicyMap = std::unordered_map<int64_t, DispatchPolicy>;
+
+	enum class ConnectionMode
+	{
+		// One endpoint at a time is served on the communication thread.
+		// Further clients wait in the backlog until the current one disconnects.
+		Sequential,
+		// All endpoints are multiplexed by an event loop and requests are handled on a worker pool
+		// according to the DispatchPolicy of their function.
+		// Falls back to Sequential on platforms without epoll.
+		Multiplexed,
+	};
+
+	explicit Server(
+		ServerFunctionMap functions,
+		ConnectionMode connectionMode = ConnectionMode::Multiplexed,
+		size_t numberOfWorkerThreads = DefaultWorkerThreads,
+		DispatchPolicyMap dispatchPolicies = {},
+		SocketOptions socketOptions = {},
+		StreamFunctionMap streamFunctions = {});
 	~Server();
 
 	bool Start(const std::string& locationUri);
@@ -59,18 +120,60 @@ public:
 
 private:
 	const ServerFunctionMap m_serverFunctions;
+	const ConnectionMode m_connectionMode;
+	const size_t m_numberOfWorkerThreads;
+	const DispatchPolicyMap m_dispatchPolicies;
+	const SocketOptions m_socketOptions;
+	const StreamFunctionMap m_streamFunctions;
 
 	Envelope HandleRequest(Envelope request);
+	DispatchPolicy GetDispatchPolicy(int64_t functionId) const;
+
+	// streamed calls of one connection in progress by call id
+	struct ActiveStream;
+	using ActiveStreams = std::unordered_map<uint64_t, ActiveStream>;
+
+	static bool IsStreamFrame(const ActiveStreams& streams, const Envelope& envelope);
+
+	// Hands the frame to the stream of its call. Returns true once the call is complete, response is set then.
+	bool HandleStreamFrame(ActiveStreams& streams, Envelope frame, Envelope& response);
+	std::unique_ptr<Stream> OpenStream(int64_t functionId, const std::string& comId);
 
 	std::mutex m_ioMutex;
 	socket_t m_serverSocket;
 	socket_t m_endpoint;
 
+	// file of a Unix domain server socket, removed on shutdown
+	std::string m_socketPath;
+	void RemoveSocketFile();
+
 	std::thread m_communicationThread;
 
 	std::shared_ptr<SocketSetup> m_socketSetup;
 
 	void HandleConnections();
+
+#if !(defined(_WIN32) || defined(_WINCE))
+	struct Endpoint;
+	struct RequestQueue;
+
+	bool StartEventLoop();
+	void StopEventLoop();
+	void HandleEvents();
+	void AcceptEndpoint();
+	void ServeEndpoint(const std::shared_ptr<Endpoint>& endpoint);
+	RequestQueue* EnqueueRequest(const std::shared_ptr<Endpoint>& endpoint, Envelope request, DispatchPolicy policy, std::vector<Envelope>& superseded);
+	void DrainRequests(const std::shared_ptr<Endpoint>& endpoint, RequestQueue& queue);
+	bool SendResponse(const std::shared_ptr<Endpoint>& endpoint, const Envelope& response);
+	void ContinueEndpoint(const std::shared_ptr<Endpoint>& endpoint);
+	void RearmEndpoint(const std::shared_ptr<Endpoint>& endpoint);
+	void CloseEndpoint(const std::shared_ptr<Endpoint>& endpoint);
+
+	int m_pollDescriptor;
+	int m_wakeupDescriptor;
+	std::unordered_map<socket_t, std::shared_ptr<Endpoint>> m_endpoints;
+	std::unique_ptr<ThreadPool> m_workers;
+#endif
 };
 
 } // namespace SocketIO
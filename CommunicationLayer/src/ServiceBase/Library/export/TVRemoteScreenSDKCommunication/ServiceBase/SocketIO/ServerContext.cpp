@@ -39,6 +39,11 @@ ServerContext::ServerContext(std::string comId)
 	m_clientMetadata[ServiceBase::CommunicationIdToken] = std::move(comId);
 }
 
+void ServerContext::SetComId(const std::string& comId)
+{
+	m_clientMetadata[ServiceBase::CommunicationIdToken].assign(comId);
+}
+
 std::string ServerContext::getComId() const
 {
 	return m_clientMetadata.at(ServiceBase::CommunicationIdToken);
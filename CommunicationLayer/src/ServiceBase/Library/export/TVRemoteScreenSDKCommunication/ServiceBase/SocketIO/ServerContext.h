@@ -41,6 +41,9 @@ public:
 	explicit ServerContext(std::string comId);
 	std::string getComId() const;
 
+	// reuses the memory of the previous com id
+	void SetComId(const std::string& comId);
+
 	// This one is only for mimicking the minimal required grpc interface
 	const std::map<std::string, std::string>& client_metadata() const {return m_clientMetadata;}
 
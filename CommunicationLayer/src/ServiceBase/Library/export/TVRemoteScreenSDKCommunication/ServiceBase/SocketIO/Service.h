@@ -27,6 +27,7 @@
 #include "ServerContext.h"
 #include "Status.h"
 
+#include <google/protobuf/arena.h>
 #include <google/protobuf/message_lite.h>
 
 #include <memory>
@@ -59,6 +60,84 @@ namespace Transport
 namespace SocketIO
 {
 
+/**
+ * @brief ServerFunctionScratch holds the messages of one server function for one thread.
+ * They live on an arena and are cleared instead of destroyed after a request,
+ * so once they have grown to the size of the requests their payloads are not allocated again.
+ * Small bookkeeping allocations of a call, like its com id and status message, remain.
+ * The messages are used by one request at a time, from Acquire until Release.
+ */
+template<typename Request, typename Response>
+class ServerFunctionScratch final
+{
+public:
+	ServerFunctionScratch()
+		: m_context{std::string{}}
+	{
+		Reset();
+	}
+
+	ServerFunctionScratch(const ServerFunctionScratch&) = delete;
+	ServerFunctionScratch& operator=(const ServerFunctionScratch&) = delete;
+
+	ServerContext& Context(const std::string& comId)
+	{
+		m_context.SetComId(comId);
+		return m_context;
+	}
+
+	Request& GetRequest()
+	{
+		return *m_request;
+	}
+
+	Response& GetResponse()
+	{
+		return *m_response;
+	}
+
+	// false while another request uses the messages, e.g. an outer one on the same thread
+	bool Acquire()
+	{
+		if (m_inUse)
+		{
+			return false;
+		}
+		m_inUse = true;
+		return true;
+	}
+
+	// to be called when the request has been handled
+	void Release(size_t requestSize)
+	{
+		m_inUse = false;
+
+		if (requestSize > MaxRetainedMessageSize)
+		{
+			// the memory of an exceptionally large request is not kept around
+			Reset();
+			return;
+		}
+
+		m_request->Clear();
+		m_response->Clear();
+	}
+
+private:
+	void Reset()
+	{
+		m_arena.Reset();
+		m_request = ::google::protobuf::Arena::CreateMessage<Request>(&m_arena);
+		m_response = ::google::protobuf::Arena::CreateMessage<Response>(&m_arena);
+	}
+
+	::google::protobuf::Arena m_arena;
+	ServerContext m_context;
+	Request* m_request = nullptr;
+	Response* m_response = nullptr;
+	bool m_inUse = false;
+};
+
 class Service
 {
 public:
@@ -94,26 +173,45 @@ protected:
 				std::shared_ptr<std::string> responseRaw
 				) -> Status
 			{
-				typename std::remove_const<Request>::type request{};
-				if (!request.ParseFromString(*requestRaw))
-				{
-					return {StatusCode::IO_ERROR, "error parsing request"};
-				}
-				requestRaw->clear();
-
-				ServerContext context{comId};
-
-				Response response{};
-				Status status = (static_cast<Child*>(this)->*serviceFunction)(&context, &request, &response);
-				if (!status.ok())
+				using Scratch = ServerFunctionScratch<typename std::remove_const<Request>::type, Response>;
+
+				// Requests of one server function may be handled on several threads at once. The messages of a
+				// thread are shared by all services of the type, a service function calling into another one,
+				// or into itself, on the same thread gets messages of its own instead of clearing the ones in use.
+				static thread_local Scratch threadScratch;
+				std::unique_ptr<Scratch> nestedScratch;
+				if (!threadScratch.Acquire())
 				{
-					return status;
+					nestedScratch.reset(new Scratch{});
+					nestedScratch->Acquire();
 				}
+				Scratch& scratch = nestedScratch ? *nestedScratch : threadScratch;
 
-				if (!response.SerializeToString(responseRaw.get()))
+				const size_t requestSize = requestRaw->size();
+				Status status = [&]() -> Status
 				{
-					return {StatusCode::LOGIC_ERROR, "response serialization failed"};
-				}
+					auto& request = scratch.GetRequest();
+					if (!request.ParseFromString(*requestRaw))
+					{
+						return {StatusCode::IO_ERROR, "error parsing request"};
+					}
+					requestRaw->clear();
+
+					Response& response = scratch.GetResponse();
+					Status callStatus = (static_cast<Child*>(this)->*serviceFunction)(&scratch.Context(comId), &request, &response);
+					if (!callStatus.ok())
+					{
+						return callStatus;
+					}
+
+					if (!response.SerializeToString(responseRaw.get()))
+					{
+						return {StatusCode::LOGIC_ERROR, "response serialization failed"};
+					}
+					return callStatus;
+				}();
+
+				scratch.Release(requestSize);
 				return status;
 			};
 	}
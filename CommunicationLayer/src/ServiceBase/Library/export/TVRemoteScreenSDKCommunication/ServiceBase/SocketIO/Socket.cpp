@@ -32,12 +32,22 @@
 #pragma comment(lib, "Ws2_32.lib")
 #endif // _WINCE
 #else // _WIN32 || _WINCE
+#include <fcntl.h>
 #include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
 #include <unistd.h>
 #endif // _WIN32 || _WINCE
 
 #include <array>
+#include <atomic>
 #include <algorithm>
+#include <climits>
+#include <cstddef>
 #include <mutex>
 #include <limits>
 #include <thread>
@@ -77,6 +87,11 @@ int CloseSocket(socket_t socket)
 	return ::closesocket(socket);
 }
 
+int ShutdownSocket(socket_t socket)
+{
+	return ::shutdown(socket, SD_BOTH);
+}
+
 class SocketSetup
 {
 public:
@@ -120,9 +135,176 @@ int CloseSocket(socket_t socket)
 	return ::close(socket);
 }
 
+int ShutdownSocket(socket_t socket)
+{
+	return ::shutdown(socket, SHUT_RDWR);
+}
+
 #endif // _WIN32 || _WINCE
 
-bool ParseLocationUri(const std::string& locationUri, in_addr& address, in_port_t& port)
+bool SetSocketTimeouts(socket_t socket, std::chrono::milliseconds timeout, bool setReceiveTimeout)
+{
+#if defined(_WIN32) || defined(_WINCE)
+	const DWORD timeoutValue = static_cast<DWORD>(timeout.count());
+#else
+	timeval timeoutValue{};
+	timeoutValue.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+	timeoutValue.tv_usec = static_cast<suseconds_t>(timeout.count() % 1000 * 1000);
+#endif
+
+	const char* value = reinterpret_cast<const char*>(&timeoutValue);
+	return ::setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, value, sizeof(timeoutValue)) == 0 &&
+		(!setReceiveTimeout || ::setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, value, sizeof(timeoutValue)) == 0);
+}
+
+bool SetSocketOptions(socket_t socket, int family, const SocketOptions& options)
+{
+	if (options.sendBufferSize > 0 &&
+		::setsockopt(socket, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char*>(&options.sendBufferSize), sizeof(int)) != 0)
+	{
+		return false;
+	}
+
+	if (options.receiveBufferSize > 0 &&
+		::setsockopt(socket, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&options.receiveBufferSize), sizeof(int)) != 0)
+	{
+		return false;
+	}
+
+	const int noDelay = 1;
+	if (options.noDelay &&
+		(family == AF_INET || family == AF_INET6) &&
+		::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay)) != 0)
+	{
+		return false;
+	}
+
+	return true;
+}
+
+namespace
+{
+
+#if defined(MSG_DONTWAIT)
+constexpr int NonBlockingFlags = MSG_DONTWAIT;
+#else
+constexpr int NonBlockingFlags = 0;
+#endif
+
+bool SetBlocking(socket_t socket, bool blocking)
+{
+#if defined(_WIN32) || defined(_WINCE)
+	u_long nonBlocking = blocking ? 0 : 1;
+	return ::ioctlsocket(socket, FIONBIO, &nonBlocking) == 0;
+#else
+	const int flags = ::fcntl(socket, F_GETFL, 0);
+	return flags >= 0 && ::fcntl(socket, F_SETFL, blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK)) == 0;
+#endif
+}
+
+} // namespace
+
+bool WaitForSocket(socket_t socket, bool forWriting, Deadline deadline)
+{
+	while (true)
+	{
+		int timeout = -1;
+		if (deadline != Deadline::max())
+		{
+			const Deadline now = Deadline::clock::now();
+			if (now >= deadline)
+			{
+				return false;
+			}
+
+			// rounded up, so the deadline has passed when poll() times out
+			const std::chrono::milliseconds remaining =
+				std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now) + std::chrono::milliseconds{1};
+			timeout = static_cast<int>(std::min<std::chrono::milliseconds::rep>(remaining.count(), INT_MAX));
+		}
+
+		pollfd descriptor{};
+		descriptor.fd = socket;
+		descriptor.events = forWriting ? POLLOUT : POLLIN;
+
+		ResetLastSocketError();
+#if defined(_WIN32) || defined(_WINCE)
+		const int result = ::WSAPoll(&descriptor, 1, timeout);
+#else
+		const int result = ::poll(&descriptor, 1, timeout);
+#endif
+		// errors and hang-ups are reported by the following socket call
+		if (result > 0 || (result < 0 && GetLastSocketError() != TV_SOCKET_ERROR(EINTR)))
+		{
+			return true;
+		}
+	}
+}
+
+Status ConnectSocket(socket_t socket, const SocketAddress& address, Deadline deadline)
+{
+	if (deadline == Deadline::max())
+	{
+		ResetLastSocketError();
+		if (::connect(socket, address.get(), address.length) < 0)
+		{
+			return {
+				StatusCode::CONNECT_ERROR,
+				"ConnectSocket: connect() failed; last error " + std::to_string(GetLastSocketError())};
+		}
+		return Status::OK;
+	}
+
+	if (!SetBlocking(socket, false))
+	{
+		return {
+			StatusCode::CONNECT_ERROR,
+			"ConnectSocket: switching to non-blocking mode failed; last error " + std::to_string(GetLastSocketError())};
+	}
+
+	ResetLastSocketError();
+	int lastError = 0;
+	if (::connect(socket, address.get(), address.length) < 0)
+	{
+		lastError = GetLastSocketError();
+#if defined(_WIN32) || defined(_WINCE)
+		const bool inProgress = lastError == WSAEWOULDBLOCK;
+#else
+		const bool inProgress = lastError == EINPROGRESS;
+#endif
+		if (inProgress)
+		{
+			if (!WaitForSocket(socket, true, deadline))
+			{
+				return {StatusCode::CONNECT_ERROR, "ConnectSocket: connect() timed out"};
+			}
+
+			socklen_t lastErrorSize = sizeof(lastError);
+			if (::getsockopt(socket, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&lastError), &lastErrorSize) != 0)
+			{
+				lastError = GetLastSocketError();
+			}
+		}
+	}
+
+	if (lastError != 0)
+	{
+		return {
+			StatusCode::CONNECT_ERROR,
+			"ConnectSocket: connect() failed; last error " + std::to_string(lastError)};
+	}
+
+	if (!SetBlocking(socket, true))
+	{
+		return {
+			StatusCode::CONNECT_ERROR,
+			"ConnectSocket: switching to blocking mode failed; last error " + std::to_string(GetLastSocketError())};
+	}
+
+	return Status::OK;
+}
+
+bool ParseLocationUri(const std::string& locationUri, SocketAddress& address)
 {
 	UrlComponents components{};
 	if (!ParseUrl(locationUri, components))
@@ -135,6 +317,28 @@ bool ParseLocationUri(const std::string& locationUri, in_addr& address, in_port_
 		return false;
 	}
 
+	if (IsUnixSocketScheme(components.scheme))
+	{
+#if defined(_WIN32) || defined(_WINCE)
+		return false;
+#else // _WIN32 || _WINCE
+		sockaddr_un unixAddress{};
+		if (components.path.empty() || components.path.size() >= sizeof(unixAddress.sun_path))
+		{
+			return false;
+		}
+
+		unixAddress.sun_family = AF_UNIX;
+		std::copy(components.path.begin(), components.path.end(), unixAddress.sun_path);
+
+		address.family = AF_UNIX;
+		address.length = static_cast<int>(offsetof(sockaddr_un, sun_path) + components.path.size() + 1);
+		std::copy_n(reinterpret_cast<const char*>(&unixAddress), sizeof(unixAddress), reinterpret_cast<char*>(&address.storage));
+		address.path = components.path;
+		return true;
+#endif // _WIN32 || _WINCE
+	}
+
 	addrinfo hints{};
 	hints.ai_family = AF_INET;
 	hints.ai_socktype = SOCK_STREAM;
@@ -146,16 +350,23 @@ bool ParseLocationUri(const std::string& locationUri, in_addr& address, in_port_
 	}
 	std::unique_ptr<addrinfo, void(*)(addrinfo*)> hostInfoPtr{hostInfo, &::freeaddrinfo};
 
+	sockaddr_in inetAddress{};
 	if (hostInfo && hostInfo->ai_addr)
 	{
-		address = reinterpret_cast<sockaddr_in*>(hostInfo->ai_addr)->sin_addr;
+		inetAddress.sin_addr = reinterpret_cast<sockaddr_in*>(hostInfo->ai_addr)->sin_addr;
 	}
 	else
 	{
 		return false;
 	}
 
-	port = htons(components.port);
+	inetAddress.sin_family = AF_INET;
+	inetAddress.sin_port = htons(components.port);
+
+	address.family = AF_INET;
+	address.length = static_cast<int>(sizeof(inetAddress));
+	std::copy_n(reinterpret_cast<const char*>(&inetAddress), sizeof(inetAddress), reinterpret_cast<char*>(&address.storage));
+	address.path.clear();
 
 	return true;
 }
@@ -199,260 +410,793 @@ void SendWithRetry(ssize_t& sentSize, int& lastError, socket_t socket, const cha
 	while (sentSize < 0 && lastError == TV_SOCKET_ERROR(EINTR));
 }
 
-Status ReceiveData(socket_t socket, std::string& dataBuffer)
+struct SendBuffer final
 {
-	uint32_t dataLength = 0;
+	const char* data;
+	size_t size;
+};
 
-	// receive length
+constexpr size_t MaxSendBuffers = 7;
+
+void GatherSendWithRetry(ssize_t& sentSize, int& lastError, socket_t socket, const SendBuffer* buffers, size_t bufferCount, int flags)
+{
+#if defined(_WIN32) || defined(_WINCE)
+	std::array<WSABUF, MaxSendBuffers> vector{};
+	for (size_t i = 0; i < bufferCount; ++i)
+	{
+		vector[i].buf = const_cast<char*>(buffers[i].data);
+		vector[i].len = static_cast<ULONG>(buffers[i].size);
+	}
+	static_cast<void>(flags);
+
+	do
+	{
+		ResetLastSocketError();
+		DWORD sentBytes = 0;
+		const int result = ::WSASend(socket, vector.data(), static_cast<DWORD>(bufferCount), &sentBytes, 0, nullptr, nullptr);
+		sentSize = (result == 0) ? static_cast<ssize_t>(sentBytes) : -1;
+		lastError = GetLastSocketError();
+	}
+	while (sentSize < 0 && lastError == TV_SOCKET_ERROR(EINTR));
+#else // _WIN32 || _WINCE
+	std::array<iovec, MaxSendBuffers> vector{};
+	for (size_t i = 0; i < bufferCount; ++i)
+	{
+		vector[i].iov_base = const_cast<char*>(buffers[i].data);
+		vector[i].iov_len = buffers[i].size;
+	}
+
+	msghdr message{};
+	message.msg_iov = vector.data();
+	message.msg_iovlen = bufferCount;
+
+	do
+	{
+		ResetLastSocketError();
+		sentSize = ::sendmsg(socket, &message, flags);
+		lastError = GetLastSocketError();
+	}
+	while (sentSize < 0 && lastError == TV_SOCKET_ERROR(EINTR));
+#endif // _WIN32 || _WINCE
+}
+
+// Writes all buffers with as few system calls as possible; the socket may accept only part of them per call.
+// With a deadline the socket is only written when it has room, so no call blocks beyond the deadline.
+Status SendBuffers(socket_t socket, SendBuffer* buffers, size_t bufferCount, Deadline deadline)
+{
+	const bool bounded = deadline != Deadline::max();
+	size_t sentBytes = 0;
+	while (true)
 	{
+		// drop what has been sent completely, continue within a partially sent buffer
+		while (bufferCount > 0 && sentBytes >= buffers->size)
+		{
+			sentBytes -= buffers->size;
+			++buffers;
+			--bufferCount;
+		}
+
+		if (bufferCount == 0)
+		{
+			return Status::OK;
+		}
+
+		buffers->data += sentBytes;
+		buffers->size -= sentBytes;
+
+		if (bounded && !WaitForSocket(socket, true, deadline))
+		{
+			return {StatusCode::IO_ERROR, "SendBuffers: deadline exceeded"};
+		}
+
 		int lastError = 0;
-		ssize_t receivedBytes = 0;
-		ReceiveWithRetry(receivedBytes, lastError, socket, reinterpret_cast<char*>(&dataLength), sizeof(dataLength), 0);
-		dataLength = ::ntohl(dataLength);
+		ssize_t sentSize = 0;
+		GatherSendWithRetry(sentSize, lastError, socket, buffers, bufferCount, bounded ? NonBlockingFlags : 0);
+		if (bounded && sentSize < 0 && (lastError == TV_SOCKET_ERROR(EWOULDBLOCK) || lastError == EAGAIN))
+		{
+			sentBytes = 0;
+			continue;
+		}
 
-		const bool headerIsValid = (receivedBytes == sizeof(dataLength));
-		if (!headerIsValid)
+		if (sentSize <= 0)
 		{
-			return{
+			return {
 				StatusCode::IO_ERROR,
-				"ReceiveData: invalid data length; receivedBytes " + std::to_string(receivedBytes) +
-				"; received data length " + std::to_string(dataLength) +
-				"; last error " + std::to_string(lastError)};
+				"SendBuffers: send() failed; last error: " + std::to_string(lastError) +
+				"; sent bytes: " + std::to_string(sentSize)};
 		}
+
+		sentBytes = static_cast<size_t>(sentSize);
 	}
+}
 
-	if (dataLength == 0)
+// Appends a number in network byte order and advances the position, independent of alignment.
+template<typename T>
+void WriteBigEndian(char*& position, T value)
+{
+	for (size_t i = sizeof(T); i > 0; --i)
 	{
-		dataBuffer.clear();
-		return Status::OK;
+		position[i - 1] = static_cast<char>(value & 0xFF);
+		value = static_cast<T>(value >> 8);
+	}
+	position += sizeof(T);
+}
+
+template<typename T>
+T ReadBigEndian(const char*& position)
+{
+	T value = 0;
+	for (size_t i = 0; i < sizeof(T); ++i)
+	{
+		value = static_cast<T>((value << 8) | static_cast<unsigned char>(position[i]));
 	}
+	position += sizeof(T);
+	return value;
+}
 
-	dataBuffer.resize(dataLength);
+Status SendEnvelope(socket_t socket, const Envelope& envelope, uint32_t protocolRevision, bool sendPreamble, Deadline deadline)
+{
+	if (socket == InvalidSocket)
+	{
+		return {
+			StatusCode::IO_ERROR,
+			"SendEnvelope: not connected / invalid socket"};
+	}
 
-	// read data buffer
+	if (!envelope.data)
+	{
+		return {StatusCode::LOGIC_ERROR, "no data"};
+	}
 
-	size_t effectiveChunkSize = 0;
-	size_t bufferPosition = 0;
-	while (bufferPosition < dataLength)
+	// the header has to fit into the read buffer of the peer, the com id is needed whole
+	constexpr size_t BinaryHeaderMaxStringsSize = BinaryHeaderMaxSize - BinaryHeaderFixedSize - sizeof(uint16_t);
+	const bool binaryHeader = protocolRevision >= ProtocolRevision_BinaryHeader;
+	if (binaryHeader && envelope.comId.size() > std::min(BinaryHeaderMaxStringSize, BinaryHeaderMaxStringsSize))
 	{
-		effectiveChunkSize = std::min(static_cast<size_t>(dataLength) - bufferPosition, ChunkSize);
+		return {StatusCode::LOGIC_ERROR, "SendEnvelope: com id too long"};
+	}
 
-		int lastError = 0;
-		ssize_t receivedSize = 0;
-		ReceiveWithRetry(receivedSize, lastError, socket, &dataBuffer.at(bufferPosition), effectiveChunkSize, 0);
-		if (receivedSize < 0)
+	// message structure: [PREAMBLE (4 bytes)]|MAGIC (4 bytes)|meta data length (4 bytes)|meta data|data length (4 bytes)|data
+	// The binary header is written to the stack, its strings are sent straight from the envelope.
+	const std::string metaDataBuffer = binaryHeader ? std::string{} : envelope.SerializeMetaData();
+	const size_t statusMessageSize = std::min(
+		{envelope.statusMessage.size(), BinaryHeaderMaxStringSize, BinaryHeaderMaxStringsSize - envelope.comId.size()});
+	const size_t metaDataSize = binaryHeader
+		? BinaryHeaderFixedSize + envelope.comId.size() + sizeof(uint16_t) + statusMessageSize
+		: metaDataBuffer.size();
+
+	std::array<char, 3 * sizeof(uint32_t) + BinaryHeaderFixedSize> prefixBuffer{};
+	std::array<char, sizeof(uint16_t)> statusMessageLengthBuffer{};
+	const uint32_t dataLengthBuffer = htonl(static_cast<uint32_t>(envelope.data->size() + envelope.dataTail.size()));
+
+	char* prefix = prefixBuffer.data();
+	if (sendPreamble)
+	{
+		WriteBigEndian<uint32_t>(prefix, MagicPreamble);
+	}
+	WriteBigEndian<uint32_t>(prefix, MagicNumber);
+	WriteBigEndian<uint32_t>(prefix, static_cast<uint32_t>(metaDataSize));
+
+	std::array<SendBuffer, MaxSendBuffers> buffers{};
+	size_t bufferCount = 0;
+
+	if (binaryHeader)
+	{
+		WriteBigEndian<uint16_t>(prefix, BinaryHeaderVersion);
+		WriteBigEndian<uint16_t>(prefix, protocolRevision >= ProtocolRevision_Streaming ? envelope.flags : 0);
+		WriteBigEndian<uint32_t>(prefix, static_cast<uint32_t>(envelope.functionId));
+		WriteBigEndian<uint64_t>(prefix, envelope.callId);
+		WriteBigEndian<uint32_t>(prefix, envelope.statusCode);
+		WriteBigEndian<uint16_t>(prefix, static_cast<uint16_t>(envelope.comId.size()));
+
+		char* statusMessageLength = statusMessageLengthBuffer.data();
+		WriteBigEndian<uint16_t>(statusMessageLength, static_cast<uint16_t>(statusMessageSize));
+
+		buffers[bufferCount++] = {prefixBuffer.data(), static_cast<size_t>(prefix - prefixBuffer.data())};
+		buffers[bufferCount++] = {envelope.comId.data(), envelope.comId.size()};
+		buffers[bufferCount++] = {statusMessageLengthBuffer.data(), statusMessageLengthBuffer.size()};
+		buffers[bufferCount++] = {envelope.statusMessage.data(), statusMessageSize};
+	}
+	else
+	{
+		buffers[bufferCount++] = {prefixBuffer.data(), static_cast<size_t>(prefix - prefixBuffer.data())};
+		buffers[bufferCount++] = {metaDataBuffer.data(), metaDataBuffer.size()};
+	}
+	buffers[bufferCount++] = {reinterpret_cast<const char*>(&dataLengthBuffer), sizeof(dataLengthBuffer)};
+	buffers[bufferCount++] = {envelope.data->data(), envelope.data->size()};
+	buffers[bufferCount++] = {envelope.dataTail.data(), envelope.dataTail.size()};
+
+	Status result = SendBuffers(socket, buffers.data(), bufferCount, deadline);
+	if (!result.ok())
+	{
+		return {
+			StatusCode::IO_ERROR,
+			"SendEnvelope: " + result.error_message()};
+	}
+
+	return Status::OK;
+}
+
+Status SendEnvelope(socket_t socket, const Envelope& envelope, uint32_t protocolRevision)
+{
+	return SendEnvelope(socket, envelope, protocolRevision, false, Deadline::max());
+}
+
+Status SendPreambleAndEnvelope(socket_t socket, const Envelope& envelope, uint32_t protocolRevision, Deadline deadline)
+{
+	return SendEnvelope(socket, envelope, protocolRevision, true, deadline);
+}
+
+Status SendPreamble(socket_t socket)
+{
+	if (socket == InvalidSocket)
+	{
+		return {
+			StatusCode::IO_ERROR,
+			"SendPreamble: not connected / invalid socket"};
+	}
+
+	uint32_t buffer = ::htonl(MagicPreamble);
+
+	int lastError = 0;
+	ssize_t sentSize = 0;
+	SendWithRetry(sentSize, lastError, socket, reinterpret_cast<char*>(&buffer), sizeof(buffer), MSG_MORE);
+	if (sentSize < static_cast<ssize_t>(sizeof(buffer)))
+	{
+		return {
+			StatusCode::IO_ERROR,
+			"SendPreamble: send() failed; sent bytes: " + std::to_string(sentSize) +
+			"; last error: " + std::to_string(lastError)};
+	}
+
+	return Status::OK;
+}
+
+Status SendHandshake(socket_t socket, uint32_t protocolRevision)
+{
+	if (socket == InvalidSocket)
+	{
+		return {
+			StatusCode::IO_ERROR,
+			"SendHandshake: not connected / invalid socket"};
+	}
+
+	const uint32_t buffer[] = {::htonl(MagicHandshake), ::htonl(protocolRevision)};
+
+	int lastError = 0;
+	ssize_t sentSize = 0;
+	SendWithRetry(sentSize, lastError, socket, reinterpret_cast<const char*>(buffer), sizeof(buffer), 0);
+	if (sentSize < static_cast<ssize_t>(sizeof(buffer)))
+	{
+		return {
+			StatusCode::IO_ERROR,
+			"SendHandshake: send() failed; sent bytes: " + std::to_string(sentSize) +
+			"; last error: " + std::to_string(lastError)};
+	}
+
+	return Status::OK;
+}
+
+FrameReader::FrameReader(socket_t socket, size_t bufferSize, size_t chunkSize)
+	: m_socket(socket)
+	, m_chunkSize(chunkSize)
+	, m_buffer(std::max(bufferSize, BinaryHeaderMaxSize))
+{
+}
+
+bool FrameReader::HasBufferedData() const
+{
+	return m_begin != m_end;
+}
+
+uint32_t FrameReader::GetProtocolRevision() const
+{
+	return m_protocolRevision;
+}
+
+void FrameReader::SetNonBlocking(bool nonBlocking)
+{
+	m_receiveFlags = nonBlocking ? NonBlockingFlags : 0;
+}
+
+Status FrameReader::Receive(char* buffer, size_t size, size_t& receivedBytes)
+{
+	int lastError = 0;
+	ssize_t result = 0;
+	ReceiveWithRetry(result, lastError, m_socket, buffer, size, m_receiveFlags);
+	if (result == 0)
+	{
+		return {StatusCode::CONNECTION_CLOSED, "FrameReader: connection closed"};
+	}
+
+	if (result < 0)
+	{
+		if (lastError == TV_SOCKET_ERROR(ECONNRESET))
 		{
-			return {
-				StatusCode::IO_ERROR,
-				"ReceiveData: recv() failed; last error: " + std::to_string(lastError)};
+			return {StatusCode::CONNECTION_CLOSED, "FrameReader: connection reset by peer"};
 		}
-		else if (receivedSize == 0)
+
+		if (m_receiveFlags != 0 && (lastError == TV_SOCKET_ERROR(EWOULDBLOCK) || lastError == EAGAIN))
 		{
-			break;
+			m_wouldBlock = true;
+			return {StatusCode::IO_ERROR, "FrameReader: no further bytes available"};
 		}
 
-		bufferPosition += static_cast<size_t>(receivedSize);
-	}
-
-	// check expected size
-	if (dataBuffer.size() < bufferPosition)
-	{
 		return {
 			StatusCode::IO_ERROR,
-			"ReceiveData: buffer size does not match: " + std::to_string(dataBuffer.size()) +
-			" < " + std::to_string(dataLength)};
+			"FrameReader: recv() failed; last error: " + std::to_string(lastError)};
 	}
 
+	receivedBytes = static_cast<size_t>(result);
 	return Status::OK;
 }
 
-Status ReceiveEnvelope(socket_t socket, Envelope& envelope)
+Status FrameReader::Fill(size_t size)
 {
-	// message structure: MAGIC (4 bytes)|data length (4 bytes)|data
+	if (m_end - m_begin >= size)
 	{
-		uint32_t magicBuffer = 0;
+		return Status::OK;
+	}
 
-		int lastError = 0;
-		ssize_t receivedBytes = 0;
-		ReceiveWithRetry(receivedBytes, lastError, socket, reinterpret_cast<char*>(&magicBuffer), sizeof(magicBuffer), 0);
-		magicBuffer = ::ntohl(magicBuffer);
+	// make room behind the buffered bytes
+	if (m_begin + size > m_buffer.size())
+	{
+		std::copy(m_buffer.begin() + m_begin, m_buffer.begin() + m_end, m_buffer.begin());
+		m_end -= m_begin;
+		m_begin = 0;
+	}
 
-		const bool headerIsValid = (receivedBytes == sizeof(magicBuffer)) && (magicBuffer == MagicNumber);
-		if (!headerIsValid)
+	while (m_end - m_begin < size)
+	{
+		size_t receivedBytes = 0;
+		Status result = Receive(m_buffer.data() + m_end, m_buffer.size() - m_end, receivedBytes);
+		if (!result.ok())
 		{
-			return {StatusCode::IO_ERROR,
-				"ReceiveEnvelope: invalid header; receivedBytes: " + std::to_string(receivedBytes) +
-				"; magic: " + std::to_string(magicBuffer) +
-				"; lastError: " + std::to_string(lastError)};
+			return result;
 		}
+
+		m_end += receivedBytes;
 	}
 
-	// read meta data
-	std::string metaDataBuffer;
+	return Status::OK;
+}
 
-	Status result = ReceiveData(socket, metaDataBuffer);
+Status FrameReader::ReceiveUInt32(uint32_t& value)
+{
+	Status result = Fill(sizeof(value));
 	if (!result.ok())
 	{
 		return result;
 	}
 
-	if (!envelope.ParseMetaData(metaDataBuffer))
+	std::copy_n(m_buffer.data() + m_begin, sizeof(value), reinterpret_cast<char*>(&value));
+	m_begin += sizeof(value);
+	value = ::ntohl(value);
+
+	return Status::OK;
+}
+
+Status FrameReader::ReceiveDataLength()
+{
+	// a non-blocking read may have stopped after the length
+	if (m_hasDataLength)
 	{
-		return {
-			StatusCode::LOGIC_ERROR,
-			"ReceiveEnvelope: parsing envelope failed"};
+		return Status::OK;
 	}
 
-	std::shared_ptr<std::string> payload = std::make_shared<std::string>();
-
-	// read payload
-	result = ReceiveData(socket, *payload);
+	Status result = ReceiveUInt32(m_dataLength);
 	if (!result.ok())
 	{
 		return result;
 	}
 
-	envelope.data = payload;
-
+	m_hasDataLength = true;
+	m_dataPosition = 0;
 	return Status::OK;
 }
 
-Status SendData(socket_t socket, const std::string& dataBuffer, bool sendMore)
+Status FrameReader::ReceiveData(std::string& dataBuffer)
 {
-	// send data length
+	// receive length
+	Status result = ReceiveDataLength();
+	if (!result.ok())
 	{
-		uint32_t dataLengthBuffer = htonl(static_cast<uint32_t>(dataBuffer.size()));
-		const bool doSendMore = sendMore || !dataBuffer.empty();
-		int lastError = 0;
-		ssize_t sentSize = 0;
-		SendWithRetry(sentSize, lastError, socket, reinterpret_cast<char*>(&dataLengthBuffer), sizeof(dataLengthBuffer), doSendMore ? MSG_MORE : 0);
-		if (sentSize != sizeof(dataLengthBuffer))
+		return {
+			StatusCode::IO_ERROR,
+			"ReceiveData: invalid data length; " + result.error_message()};
+	}
+
+	if (m_dataLength <= m_buffer.size())
+	{
+		result = Fill(m_dataLength);
+		if (!result.ok())
 		{
 			return {
 				StatusCode::IO_ERROR,
-				"SendData: send() data length failed; last error: " + std::to_string(lastError) +
-				", sent bytes: " + std::to_string(sentSize)};
+				"ReceiveData: " + result.error_message()};
 		}
+
+		dataBuffer.assign(m_buffer.data() + m_begin, m_dataLength);
+		m_begin += m_dataLength;
+		m_hasDataLength = false;
+		return Status::OK;
 	}
 
-	// send data in chunks
-	size_t effectiveChunkSize = 0;
-	size_t bufferPosition = 0;
+	// take over what is buffered already and read the rest without the detour through the buffer
+	if (m_dataPosition == 0)
+	{
+		dataBuffer.resize(m_dataLength);
+		std::copy(m_buffer.begin() + m_begin, m_buffer.begin() + m_end, dataBuffer.begin());
+		m_dataPosition = m_end - m_begin;
+		m_begin = 0;
+		m_end = 0;
+	}
 
-	while (bufferPosition < dataBuffer.size())
+	while (m_dataPosition < m_dataLength)
 	{
-		effectiveChunkSize = std::min(dataBuffer.size() - bufferPosition, ChunkSize);
+		const size_t effectiveChunkSize = std::min(static_cast<size_t>(m_dataLength) - m_dataPosition, m_chunkSize);
 
-		const bool doSendMore = sendMore || bufferPosition + effectiveChunkSize < dataBuffer.size();
-		int lastError = 0;
-		ssize_t sentSize = 0;
-		SendWithRetry(sentSize, lastError, socket, &dataBuffer.at(bufferPosition), effectiveChunkSize, doSendMore ? MSG_MORE : 0);
-		if (sentSize <= 0)
+		size_t receivedSize = 0;
+		result = Receive(&dataBuffer[m_dataPosition], effectiveChunkSize, receivedSize);
+		if (!result.ok())
 		{
 			return {
 				StatusCode::IO_ERROR,
-				"SendData: send() data failed; last error: " + std::to_string(lastError) +
-				"; sent bytes: " + std::to_string(sentSize)};
+				"ReceiveData: " + result.error_message() + "; received " + std::to_string(m_dataPosition) +
+				" of " + std::to_string(m_dataLength) + " bytes"};
 		}
 
-		bufferPosition += static_cast<size_t>(sentSize);
+		m_dataPosition += receivedSize;
 	}
 
+	m_hasDataLength = false;
 	return Status::OK;
 }
 
-Status SendEnvelope(socket_t socket, const Envelope& envelope)
+Status FrameReader::ReceivePreamble(uint32_t& magic)
 {
-	if (!envelope.data)
+	if (m_socket == InvalidSocket)
 	{
-		return {StatusCode::LOGIC_ERROR, "no data"};
+		return {StatusCode::IO_ERROR, "ReceivePreamble: not connected / invalid socket"};
 	}
 
-	// send header
+	uint32_t magicBuffer = 0;
+	Status result = ReceiveUInt32(magicBuffer);
+	if (result.code() == StatusCode::CONNECTION_CLOSED)
 	{
-		uint32_t magicNumberBuffer = htonl(MagicNumber);
-		int lastError = 0;
-		ssize_t sentSize = 0;
-		SendWithRetry(sentSize, lastError, socket, reinterpret_cast<char*>(&magicNumberBuffer), sizeof(magicNumberBuffer), MSG_MORE);
-		if (sentSize != sizeof(magicNumberBuffer))
-		{
-			return {StatusCode::IO_ERROR,
-				"SendEnvelope: send() failed for header; last error: " + std::to_string(lastError) +
-				"; sent bytes: " + std::to_string(sentSize)};
-		}
+		return {StatusCode::CONNECTION_CLOSED, "ReceivePreamble: connection closed"};
 	}
 
-	// send meta data
-	std::string metaDataBuffer = envelope.SerializeMetaData();
-	Status result = SendData(socket, metaDataBuffer, true);
 	if (!result.ok())
 	{
-		return result;
+		return {
+			StatusCode::IO_ERROR,
+			"ReceivePreamble: " + result.error_message()};
+	}
+
+	if (magicBuffer != MagicPreamble && magicBuffer != MagicHandshake)
+	{
+		return {
+			StatusCode::IO_ERROR,
+			"ReceivePreamble: invalid preamble; received magic " + std::to_string(magicBuffer)};
 	}
 
-	// send data in chunks
-	return SendData(socket, *(envelope.data), false);
+	magic = magicBuffer;
+	return Status::OK;
 }
 
-Status ReceivePreamble(socket_t socket)
+Status FrameReader::ReceivePreamble()
 {
-	if (socket == InvalidSocket)
+	uint32_t magic = 0;
+	Status result = ReceivePreamble(magic);
+	if (result.ok() && magic != MagicPreamble)
 	{
-		return {StatusCode::IO_ERROR, "SendPreamble: not connected / invalid socket"};
+		return {
+			StatusCode::IO_ERROR,
+			"ReceivePreamble: invalid preamble; received magic " + std::to_string(magic)};
 	}
 
-	uint32_t buffer = 0;
+	return result;
+}
 
-	int lastError = 0;
-	ssize_t receivedBytes = 0;
-	ReceiveWithRetry(receivedBytes, lastError, socket, reinterpret_cast<char*>(&buffer), sizeof(buffer), 0);
+Status FrameReader::ReceiveHandshake(uint32_t& protocolRevision)
+{
+	if (m_socket == InvalidSocket)
+	{
+		return {StatusCode::IO_ERROR, "ReceiveHandshake: not connected / invalid socket"};
+	}
 
-	if (receivedBytes == 0)
+	uint32_t magic = 0;
+	Status result = ReceiveUInt32(magic);
+	if (result.code() == StatusCode::CONNECTION_CLOSED)
 	{
-		return {StatusCode::CONNECTION_CLOSED, "ReceivePreamble: connection closed"};
+		return {StatusCode::CONNECTION_CLOSED, "ReceiveHandshake: connection closed"};
 	}
 
-	if (receivedBytes < 0)
+	if (!result.ok())
 	{
 		return {
 			StatusCode::IO_ERROR,
-			"ReceivePreamble: recv() failed; last error: " + std::to_string(lastError)};
+			"ReceiveHandshake: " + result.error_message()};
 	}
 
-	uint32_t magicBuffer = ::ntohl(buffer);
-	const bool isValid = (receivedBytes == sizeof(buffer)) && (magicBuffer == MagicPreamble);
-	if (!isValid)
+	// the peer rejected or did not understand the handshake
+	if (magic != MagicHandshake)
+	{
+		return {
+			StatusCode::LOGIC_ERROR,
+			"ReceiveHandshake: invalid handshake; received magic " + std::to_string(magic)};
+	}
+
+	result = ReceiveUInt32(protocolRevision);
+	if (!result.ok())
 	{
 		return {
 			StatusCode::IO_ERROR,
-			"ReceivePreamble: invalid preamble; received bytes " + std::to_string(receivedBytes) +
-			"; received magic " + std::to_string(magicBuffer)};
+			"ReceiveHandshake: " + result.error_message()};
 	}
 
+	m_protocolRevision = protocolRevision;
 	return Status::OK;
 }
 
-Status SendPreamble(socket_t socket)
+Status FrameReader::AcceptHandshake(uint32_t& protocolRevision)
 {
-	if (socket == InvalidSocket)
+	uint32_t requestedRevision = 0;
+	Status result = ReceiveUInt32(requestedRevision);
+	if (!result.ok())
 	{
 		return {
 			StatusCode::IO_ERROR,
-			"SendPreamble: not connected / invalid socket"};
+			"AcceptHandshake: " + result.error_message()};
 	}
 
-	uint32_t buffer = ::htonl(MagicPreamble);
+	protocolRevision = std::min(requestedRevision, CurrentProtocolRevision);
+	m_protocolRevision = protocolRevision;
+	return SendHandshake(m_socket, protocolRevision);
+}
 
-	int lastError = 0;
-	ssize_t sentSize = 0;
-	SendWithRetry(sentSize, lastError, socket, reinterpret_cast<char*>(&buffer), sizeof(buffer), MSG_MORE);
-	if (sentSize < static_cast<ssize_t>(sizeof(buffer)))
+Status FrameReader::ReceiveEnvelope(Envelope& envelope)
+{
+	// message structure: MAGIC (4 bytes)|meta data|data length (4 bytes)|data
+	Status result = ReceiveEnvelopeMagic();
+	if (!result.ok())
+	{
+		return result;
+	}
+
+	result = ReceiveMetaData(envelope);
+	if (!result.ok())
+	{
+		return result;
+	}
+
+	std::shared_ptr<std::string> payload = PayloadBuffer();
+
+	// read payload
+	result = ReceiveData(*payload);
+	if (!result.ok())
+	{
+		return result;
+	}
+
+	envelope.data = payload;
+
+	return Status::OK;
+}
+
+Status FrameReader::ReceiveEnvelope(Envelope& envelope, bool& complete)
+{
+	complete = false;
+	m_wouldBlock = false;
+
+	// envelopes without preamble start right with their magic number
+	if (m_frameStage == FrameStage::Preamble)
+	{
+		m_frameStage = FrameStage::EnvelopeMagic;
+	}
+
+	Status result = ContinueFrame();
+	if (!result.ok())
+	{
+		return m_wouldBlock ? Status::OK : result;
+	}
+
+	envelope = std::move(m_frame);
+	m_frameStage = FrameStage::Preamble;
+	m_frame = Envelope{};
+	complete = true;
+	return Status::OK;
+}
+
+Status FrameReader::ReceiveFrame(uint32_t& magic, Envelope& envelope, bool& complete)
+{
+	complete = false;
+	m_wouldBlock = false;
+
+	Status result = ContinueFrame();
+	if (!result.ok())
+	{
+		// the frame is continued once further bytes have arrived
+		return m_wouldBlock ? Status::OK : result;
+	}
+
+	magic = m_frameMagic;
+	if (m_frameStage != FrameStage::HandshakeRevision)
+	{
+		envelope = std::move(m_frame);
+	}
+
+	m_frameStage = FrameStage::Preamble;
+	m_frame = Envelope{};
+	complete = true;
+	return Status::OK;
+}
+
+Status FrameReader::ContinueFrame()
+{
+	// Each stage either completes or consumes nothing but what it keeps in the members,
+	// so a stage stopped by a non-blocking read can be repeated.
+	if (m_frameStage == FrameStage::Preamble)
+	{
+		Status result = ReceivePreamble(m_frameMagic);
+		if (!result.ok())
+		{
+			return result;
+		}
+
+		m_frameStage = m_frameMagic == MagicHandshake ? FrameStage::HandshakeRevision : FrameStage::EnvelopeMagic;
+	}
+
+	if (m_frameStage == FrameStage::HandshakeRevision)
+	{
+		uint32_t protocolRevision = ProtocolRevision_Legacy;
+		return AcceptHandshake(protocolRevision);
+	}
+
+	if (m_frameStage == FrameStage::EnvelopeMagic)
+	{
+		Status result = ReceiveEnvelopeMagic();
+		if (!result.ok())
+		{
+			return result;
+		}
+
+		m_frameStage = FrameStage::MetaData;
+	}
+
+	if (m_frameStage == FrameStage::MetaData)
+	{
+		Status result = ReceiveMetaData(m_frame);
+		if (!result.ok())
+		{
+			return result;
+		}
+
+		m_frame.data = PayloadBuffer();
+		m_frameStage = FrameStage::Payload;
+	}
+
+	return ReceiveData(*m_frame.data);
+}
+
+std::shared_ptr<std::string> FrameReader::PayloadBuffer()
+{
+	// The payload of the previous frame has usually been handled by now,
+	// unless something still holds on to it, its buffer is reused.
+	if (!m_payload || m_payload.use_count() != 1 || m_payload->capacity() > MaxRetainedMessageSize)
+	{
+		m_payload = std::make_shared<std::string>();
+	}
+	else
+	{
+		// the last holder may have been another thread, its use of the buffer has to be visible here
+		std::atomic_thread_fence(std::memory_order_acquire);
+		m_payload->clear();
+	}
+	return m_payload;
+}
+
+Status FrameReader::ReceiveEnvelopeMagic()
+{
+	uint32_t magicBuffer = 0;
+	Status result = ReceiveUInt32(magicBuffer);
+
+	const bool headerIsValid = result.ok() && (magicBuffer == MagicNumber);
+	if (!headerIsValid)
+	{
+		return {StatusCode::IO_ERROR,
+			"ReceiveEnvelope: invalid header; magic: " + std::to_string(magicBuffer) +
+			"; " + result.error_message()};
+	}
+
+	return Status::OK;
+}
+
+Status FrameReader::ReceiveMetaData(Envelope& envelope)
+{
+	if (m_protocolRevision >= ProtocolRevision_BinaryHeader)
+	{
+		return ReceiveBinaryMetaData(envelope);
+	}
+
+	Status result = ReceiveData(m_frameMetaData);
+	if (!result.ok())
+	{
+		return result;
+	}
+
+	if (!envelope.ParseMetaData(m_frameMetaData))
+	{
+		return {
+			StatusCode::LOGIC_ERROR,
+			"ReceiveEnvelope: parsing envelope failed"};
+	}
+
+	return Status::OK;
+}
+
+Status FrameReader::ReceiveBinaryMetaData(Envelope& envelope)
+{
+	Status result = ReceiveDataLength();
+	if (!result.ok())
 	{
 		return {
 			StatusCode::IO_ERROR,
-			"SendPreamble: send() failed; sent bytes: " + std::to_string(sentSize) +
-			"; last error: " + std::to_string(lastError)};
+			"ReceiveBinaryMetaData: invalid header length; " + result.error_message()};
+	}
+
+	const uint32_t headerLength = m_dataLength;
+
+	// the header is parsed in place, so it has to fit into the buffer
+	if (headerLength < BinaryHeaderFixedSize + sizeof(uint16_t) || headerLength > BinaryHeaderMaxSize)
+	{
+		return {
+			StatusCode::LOGIC_ERROR,
+			"ReceiveBinaryMetaData: unexpected header length " + std::to_string(headerLength)};
+	}
+
+	result = Fill(headerLength);
+	if (!result.ok())
+	{
+		return {
+			StatusCode::IO_ERROR,
+			"ReceiveBinaryMetaData: " + result.error_message()};
+	}
+
+	const char* position = m_buffer.data() + m_begin;
+	const char* const end = position + headerLength;
+	m_begin += headerLength;
+	m_hasDataLength = false;
+
+	const uint16_t version = ReadBigEndian<uint16_t>(position);
+	if (version < BinaryHeaderVersion)
+	{
+		return {
+			StatusCode::LOGIC_ERROR,
+			"ReceiveBinaryMetaData: unknown header version " + std::to_string(version)};
+	}
+
+	const uint16_t flags = ReadBigEndian<uint16_t>(position);
+	envelope.flags = m_protocolRevision >= ProtocolRevision_Streaming ? flags : 0;
+	envelope.functionId = ReadBigEndian<uint32_t>(position);
+	envelope.callId = ReadBigEndian<uint64_t>(position);
+	envelope.statusCode = ReadBigEndian<uint32_t>(position);
+
+	const uint16_t comIdSize = ReadBigEndian<uint16_t>(position);
+	if (static_cast<size_t>(end - position) < comIdSize + sizeof(uint16_t))
+	{
+		return {StatusCode::LOGIC_ERROR, "ReceiveBinaryMetaData: com id exceeds header"};
+	}
+	envelope.comId.assign(position, comIdSize);
+	position += comIdSize;
+
+	const uint16_t statusMessageSize = ReadBigEndian<uint16_t>(position);
+	if (static_cast<size_t>(end - position) < statusMessageSize)
+	{
+		return {StatusCode::LOGIC_ERROR, "ReceiveBinaryMetaData: status message exceeds header"};
 	}
+	envelope.statusMessage.assign(position, statusMessageSize);
 
 	return Status::OK;
 }
@@ -462,6 +1206,7 @@ std::string Envelope::SerializeMetaData() const
 	tvsocketservicebase::Envelope intermediate{};
 	intermediate.set_com_id(comId);
 	intermediate.set_function_id(functionId);
+	intermediate.set_call_id(callId);
 	intermediate.set_status_code(statusCode);
 	intermediate.set_status_message(statusMessage);
 
@@ -479,6 +1224,7 @@ bool Envelope::ParseMetaData(const std::string& metadata)
 
 	comId = intermediate.com_id();
 	functionId = intermediate.function_id();
+	callId = intermediate.call_id();
 	statusCode = intermediate.status_code();
 	statusMessage = intermediate.status_message();
 
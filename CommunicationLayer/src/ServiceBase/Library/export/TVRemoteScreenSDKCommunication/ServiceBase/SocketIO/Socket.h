@@ -25,16 +25,20 @@
 
 #include "Status.h"
 
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/FrameBuffer.h>
+
 #if defined(_WIN32) || defined(_WINCE)
 #include <winsock2.h>
 #else
 #include <arpa/inet.h>
 #endif
 
+#include <chrono>
 #include <string>
 #include <stdint.h>
 #include <stddef.h>
 #include <memory>
+#include <vector>
 
 namespace TVRemoteScreenSDKCommunication
 {
@@ -57,16 +61,108 @@ constexpr int SocketType = SOCK_STREAM | SOCK_CLOEXEC;
 
 constexpr uint32_t MagicNumber = 0xFF545600;
 constexpr uint32_t MagicPreamble = 0xFF005456;
+constexpr uint32_t MagicHandshake = 0xFF015456;
 constexpr size_t ChunkSize = 1024 * 1024 * 16; // in bytes;
+constexpr size_t ReadBufferSize = 1024 * 64; // in bytes;
 constexpr uint32_t SendReceiveTimeout = 1; //seconds
 constexpr int MaxBacklogSize = 32;
+constexpr size_t DefaultWorkerThreads = 4;
+constexpr size_t MaxRetainedMessageSize = 1024 * 64; // in bytes, larger messages do not keep their buffers for reuse
+
+// Tuning of the sockets of a channel or server, the defaults are the constants above.
+struct SocketOptions final
+{
+	// largest piece of a payload read with a single system call, in bytes
+	size_t chunkSize = ChunkSize;
+
+	std::chrono::milliseconds sendReceiveTimeout = std::chrono::seconds{SendReceiveTimeout};
+
+	int maxBacklogSize = MaxBacklogSize;
+
+	// SO_SNDBUF and SO_RCVBUF in bytes, 0 .. keep the system default
+	int sendBufferSize = 0;
+	int receiveBufferSize = 0;
+
+	// sets TCP_NODELAY, ignored for Unix domain sockets
+	bool noDelay = false;
+};
+
+// Revisions of the framing protocol. The client proposes its revision with a handshake
+// right after connecting, the server answers with the revision used for the connection.
+// Peers not knowing the handshake close the connection and are talked to with the legacy revision.
+enum ProtocolRevision : uint32_t
+{
+	// One request at a time, answered in order.
+	ProtocolRevision_Legacy = 0,
+	// Envelopes carry a call id, several requests may be in flight and are answered in any order.
+	ProtocolRevision_CallId = 1,
+	// Envelope meta data is a fixed binary header instead of a protobuf message.
+	ProtocolRevision_BinaryHeader = 2,
+	// The request of a call may be sent in several frames, see EnvelopeFlags.
+	ProtocolRevision_Streaming = 3,
+};
+
+constexpr uint32_t CurrentProtocolRevision = ProtocolRevision_Streaming;
+
+// Flags of the binary envelope header, from ProtocolRevision_Streaming on.
+// A streamed request is a series of envelopes with the same call id, all but the last one carrying
+// EnvelopeFlag_MoreFrames. The response follows the last frame.
+enum EnvelopeFlags : uint16_t
+{
+	EnvelopeFlag_MoreFrames = 0x1,
+	// the client abandoned the streamed call, no response is sent
+	EnvelopeFlag_Cancelled = 0x2,
+};
+
+// Binary envelope header from ProtocolRevision_BinaryHeader on, numbers in network byte order:
+// version (2 bytes)|flags (2 bytes)|function id (4 bytes)|call id (8 bytes)|status code (4 bytes)|
+// com id length (2 bytes)|com id|status message length (2 bytes)|status message
+// Later versions may append fields, readers skip the ones they do not know.
+constexpr uint16_t BinaryHeaderVersion = 1;
+constexpr size_t BinaryHeaderFixedSize = 22; // in bytes, up to and including the com id length
+constexpr size_t BinaryHeaderMaxStringSize = 0xFFFF; // in bytes
+// in bytes, readers parse the header within their read buffer, senders cut the status message to fit
+constexpr size_t BinaryHeaderMaxSize = ReadBufferSize;
+
+struct SocketAddress final
+{
+	const sockaddr* get() const
+	{
+		return reinterpret_cast<const sockaddr*>(&storage);
+	}
+
+	int family = AF_UNSPEC;
+	sockaddr_storage storage{};
+	int length = 0;
+
+	// path of a Unix domain socket, empty for TCP
+	std::string path;
+};
+
+// Resolves tcp+tv://host:port to a TCP address and, where supported, unix+tv:///path to a Unix domain socket address.
+bool ParseLocationUri(const std::string& locationUri, SocketAddress& address);
+
+// Point in time a blocking socket operation has to be finished by, Deadline::max() for none.
+using Deadline = std::chrono::steady_clock::time_point;
+
+// Waits until the socket is readable or writable. Returns false once the deadline has passed.
+bool WaitForSocket(socket_t socket, bool forWriting, Deadline deadline);
 
-bool ParseLocationUri(const std::string& locationUri, in_addr& address, in_port_t& port);
+// Connects the socket to the address, giving up at the deadline.
+Status ConnectSocket(socket_t socket, const SocketAddress& address, Deadline deadline);
 
 void ResetLastSocketError();
 int GetLastSocketError();
 
 int CloseSocket(socket_t socket);
+int ShutdownSocket(socket_t socket);
+
+// Sets send and, if requested, receive timeout of a connected socket.
+bool SetSocketTimeouts(socket_t socket, std::chrono::milliseconds timeout, bool setReceiveTimeout = true);
+
+// Sets buffer sizes and TCP_NODELAY of a socket of the given address family.
+// Sockets accepted by a listening socket inherit them.
+bool SetSocketOptions(socket_t socket, int family, const SocketOptions& options);
 
 std::shared_ptr<struct SocketSetup> QuerySockets();
 
@@ -74,21 +170,126 @@ struct Envelope final
 {
 	Envelope() = default;
 
+	// protobuf meta data used before ProtocolRevision_BinaryHeader
 	std::string SerializeMetaData() const;
 	bool ParseMetaData(const std::string& data);
 
 	std::string comId;
 	std::string statusMessage;
 	std::shared_ptr<std::string> data;
+	// sent right after data as part of the same payload, referenced instead of being copied
+	FrameBuffer dataTail;
 	int64_t functionId = -1;
+	uint64_t callId = 0;
 	uint32_t statusCode = 0;
+
+	// EnvelopeFlags, only transferred from ProtocolRevision_Streaming on
+	uint16_t flags = 0;
 };
 
-Status ReceivePreamble(socket_t socket);
 Status SendPreamble(socket_t socket);
+Status SendHandshake(socket_t socket, uint32_t protocolRevision);
+
+// The protocol revision of the connection selects the meta data format.
+Status SendEnvelope(socket_t socket, const Envelope& envelope, uint32_t protocolRevision);
+
+// Sends preamble and envelope together, usually with a single system call.
+// A frame not sent completely by the deadline leaves the connection unusable.
+Status SendPreambleAndEnvelope(
+	socket_t socket,
+	const Envelope& envelope,
+	uint32_t protocolRevision,
+	Deadline deadline = Deadline::max());
+
+// Receives the frames of one connection. The socket is read in large blocks and header fields
+// are parsed from the buffer; payloads exceeding the buffer are read directly into their destination.
+// All reads of a connection have to go through the same reader, it may hold bytes of subsequent frames.
+class FrameReader final
+{
+public:
+	// The buffer holds at least BinaryHeaderMaxSize bytes.
+	explicit FrameReader(socket_t socket, size_t bufferSize = ReadBufferSize, size_t chunkSize = ChunkSize);
+
+	Status ReceivePreamble();
+
+	// Receives either a preamble or a handshake magic number.
+	Status ReceivePreamble(uint32_t& magic);
+
+	// Returns CONNECTION_CLOSED if the peer dropped the connection and LOGIC_ERROR if it answered
+	// with something else, which is what peers predating the handshake do.
+	Status ReceiveHandshake(uint32_t& protocolRevision);
+
+	// Answers a handshake whose magic number has already been received.
+	Status AcceptHandshake(uint32_t& protocolRevision);
+
+	Status ReceiveEnvelope(Envelope& envelope);
 
-Status ReceiveEnvelope(socket_t socket, Envelope& envelope);
-Status SendEnvelope(socket_t socket, const Envelope& envelope);
+	// Lets reads return instead of waiting when the socket has no further bytes, see ReceiveFrame.
+	// Sends of the connection are not affected.
+	void SetNonBlocking(bool nonBlocking);
+
+	// Receives the next frame as far as the socket has bytes available, for readers in non-blocking mode.
+	// A frame is either a handshake, which gets answered, or a preamble followed by an envelope.
+	// complete stays false while the frame is incomplete, the bytes received so far are kept
+	// and the next call continues with the rest.
+	Status ReceiveFrame(uint32_t& magic, Envelope& envelope, bool& complete);
+
+	// Receives an envelope not preceded by a preamble, such as a response, in the same way as ReceiveFrame.
+	Status ReceiveEnvelope(Envelope& envelope, bool& complete);
+
+	// The revision agreed on by the handshake, ProtocolRevision_Legacy without one.
+	uint32_t GetProtocolRevision() const;
+
+	// Whether bytes of the next frame have already been read from the socket.
+	// Readiness notifications of the socket do not cover them.
+	bool HasBufferedData() const;
+
+private:
+	enum class FrameStage
+	{
+		Preamble,
+		HandshakeRevision,
+		EnvelopeMagic,
+		MetaData,
+		Payload,
+	};
+
+	Status Fill(size_t size);
+	Status Receive(char* buffer, size_t size, size_t& receivedBytes);
+	Status ReceiveUInt32(uint32_t& value);
+	Status ReceiveDataLength();
+	Status ReceiveData(std::string& dataBuffer);
+	Status ReceiveEnvelopeMagic();
+	Status ReceiveMetaData(Envelope& envelope);
+	Status ReceiveBinaryMetaData(Envelope& envelope);
+	Status ContinueFrame();
+	std::shared_ptr<std::string> PayloadBuffer();
+
+	const socket_t m_socket;
+	const size_t m_chunkSize;
+	uint32_t m_protocolRevision = ProtocolRevision_Legacy;
+	std::vector<char> m_buffer;
+	size_t m_begin = 0;
+	size_t m_end = 0;
+
+	int m_receiveFlags = 0;
+	// set when a non-blocking read found no further bytes
+	bool m_wouldBlock = false;
+
+	// length of the data being received, kept when a non-blocking read stops in between
+	bool m_hasDataLength = false;
+	uint32_t m_dataLength = 0;
+	size_t m_dataPosition = 0;
+
+	// frame being received by ReceiveFrame
+	FrameStage m_frameStage = FrameStage::Preamble;
+	uint32_t m_frameMagic = 0;
+	std::string m_frameMetaData;
+	Envelope m_frame;
+
+	// payload of the previous frame, reused once its receiver has let go of it
+	std::shared_ptr<std::string> m_payload;
+};
 
 } // namespace SocketIO
 } // namespace Transport
@@ -0,0 +1,119 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include "ThreadPool.h"
+
+namespace TVRemoteScreenSDKCommunication
+{
+
+namespace Transport
+{
+
+namespace SocketIO
+{
+
+ThreadPool::ThreadPool(size_t numberOfThreads)
+{
+	if (numberOfThreads == 0)
+	{
+		numberOfThreads = 1;
+	}
+
+	m_threads.reserve(numberOfThreads);
+	for (size_t i = 0; i < numberOfThreads; ++i)
+	{
+		m_threads.emplace_back([this]()
+		{
+			Run();
+		});
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	Shutdown();
+}
+
+bool ThreadPool::Post(Task task)
+{
+	{
+		const std::lock_guard<std::mutex> lock{m_mutex};
+		if (m_shutdown)
+		{
+			return false;
+		}
+		m_tasks.push_back(std::move(task));
+	}
+	m_condition.notify_one();
+	return true;
+}
+
+void ThreadPool::Shutdown()
+{
+	{
+		const std::lock_guard<std::mutex> lock{m_mutex};
+		m_shutdown = true;
+		m_tasks.clear();
+	}
+	m_condition.notify_all();
+
+	for (std::thread& thread : m_threads)
+	{
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+	m_threads.clear();
+}
+
+void ThreadPool::Run()
+{
+	while (true)
+	{
+		Task task;
+		{
+			std::unique_lock<std::mutex> lock{m_mutex};
+			m_condition.wait(lock, [this]()
+			{
+				return m_shutdown || !m_tasks.empty();
+			});
+
+			if (m_shutdown)
+			{
+				return;
+			}
+
+			task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+
+		task();
+	}
+}
+
+} // namespace SocketIO
+
+} // namespace Transport
+
+} // namespace TVRemoteScreenSDKCommunication
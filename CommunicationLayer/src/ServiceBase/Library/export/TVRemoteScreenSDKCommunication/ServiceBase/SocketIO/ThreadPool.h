@@ -0,0 +1,84 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TVRemoteScreenSDKCommunication
+{
+
+namespace Transport
+{
+
+namespace SocketIO
+{
+
+/**
+ * @brief ThreadPool runs posted tasks on a fixed number of worker threads.
+ * Tasks are started in the order they have been posted.
+ */
+class ThreadPool final
+{
+public:
+	using Task = std::function<void()>;
+
+	explicit ThreadPool(size_t numberOfThreads);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/**
+	 * @brief Post queues a task for execution.
+	 * @return false if the pool has already been shut down and the task got discarded.
+	 */
+	bool Post(Task task);
+
+	/**
+	 * @brief Shutdown discards all pending tasks and waits for the running ones to finish.
+	 */
+	void Shutdown();
+
+private:
+	void Run();
+
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	std::deque<Task> m_tasks;
+	bool m_shutdown = false;
+
+	std::vector<std::thread> m_threads;
+};
+
+} // namespace SocketIO
+
+} // namespace Transport
+
+} // namespace TVRemoteScreenSDKCommunication
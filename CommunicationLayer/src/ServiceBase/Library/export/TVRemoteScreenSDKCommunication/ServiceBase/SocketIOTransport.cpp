@@ -34,14 +34,34 @@ namespace Transport
 
 std::shared_ptr<SocketIO::ChannelInterface> TCPSocket::CreateChannel(const std::string& destination)
 {
-	return std::make_shared<SocketIO::ChannelInterface>(destination);
+	return CreateChannel(destination, TransportOptions{});
+}
+
+std::shared_ptr<SocketIO::ChannelInterface> TCPSocket::CreateChannel(
+	const std::string& destination,
+	const TransportOptions& options)
+{
+	return std::make_shared<SocketIO::ChannelInterface>(destination, SocketIO::ConnectionPolicy{}, MakeSocketOptions(options));
 }
 
 std::unique_ptr<TCPSocket::Server> TCPSocket::CreateAndStartSyncServer(
 	const std::string& locationUri,
 	Service* service)
 {
-	std::unique_ptr<TCPSocket::Server> server{new Server{service->RegisteredFunctions()}};
+	return CreateAndStartSyncServer(locationUri, service, TransportOptions{});
+}
+
+std::unique_ptr<TCPSocket::Server> TCPSocket::CreateAndStartSyncServer(
+	const std::string& locationUri,
+	Service* service,
+	const TransportOptions& options)
+{
+	std::unique_ptr<TCPSocket::Server> server{new Server{
+		service->RegisteredFunctions(),
+		Server::ConnectionMode::Multiplexed,
+		SocketIO::DefaultWorkerThreads,
+		Server::DispatchPolicyMap{},
+		MakeSocketOptions(options)}};
 	if (server->Start(locationUri))
 	{
 		return server;
@@ -49,6 +69,32 @@ std::unique_ptr<TCPSocket::Server> TCPSocket::CreateAndStartSyncServer(
 	return {};
 }
 
+SocketIO::SocketOptions TCPSocket::MakeSocketOptions(const TransportOptions& options)
+{
+	SocketIO::SocketOptions socketOptions;
+
+	if (options.chunkSize > 0)
+	{
+		socketOptions.chunkSize = options.chunkSize;
+	}
+
+	if (options.sendReceiveTimeout.count() > 0)
+	{
+		socketOptions.sendReceiveTimeout = options.sendReceiveTimeout;
+	}
+
+	if (options.maxBacklogSize > 0)
+	{
+		socketOptions.maxBacklogSize = options.maxBacklogSize;
+	}
+
+	socketOptions.sendBufferSize = options.sendBufferSize;
+	socketOptions.receiveBufferSize = options.receiveBufferSize;
+	socketOptions.noDelay = options.noDelay;
+
+	return socketOptions;
+}
+
 } // namespace Transport
 
 } // namespace TVRemoteScreenSDKCommunication
@@ -30,6 +30,8 @@
 #include "SocketIO/Status.h"
 #include "SocketIO/Service.h"
 
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
+
 #include <memory>
 #include <string>
 
@@ -50,16 +52,30 @@ struct TCPSocket final
 	using StatusCode       = SocketIO::StatusCode;
 
 	static std::shared_ptr<ChannelInterface> CreateChannel(const std::string& destination);
+	static std::shared_ptr<ChannelInterface> CreateChannel(
+		const std::string& destination,
+		const TransportOptions& options);
 
 	/**
 	 * @brief CreateAndStartSyncServer creates and starts a synchronous SocketIO server with the given parameters.
 	 * Synchronous server means its client wait synchronously until the server responds.
 	 * @param locationUri location of the server (IP address and port, e.g. 127.0.0.1:9003).
+	 * @param options transport options, only the SocketIO ones apply
 	 * @return server instance if creating and starting was successful
 	 */
 	static std::unique_ptr<Server> CreateAndStartSyncServer(
 		const std::string& locationUri,
 		Service* service);
+	static std::unique_ptr<Server> CreateAndStartSyncServer(
+		const std::string& locationUri,
+		Service* service,
+		const TransportOptions& options);
+
+	/**
+	 * @brief MakeSocketOptions picks the SocketIO options out of the transport options,
+	 * options left at their default keep the SocketIO defaults.
+	 */
+	static SocketIO::SocketOptions MakeSocketOptions(const TransportOptions& options);
 };
 
 } // namespace Transport
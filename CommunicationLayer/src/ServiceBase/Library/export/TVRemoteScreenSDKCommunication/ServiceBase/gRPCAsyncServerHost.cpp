@@ -0,0 +1,356 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include "gRPCAsyncServerHost.h"
+#include "ServiceErrorMessage.h"
+#include "gRPCTransport.h"
+
+#include <iostream>
+
+namespace TVRemoteScreenSDKCommunication
+{
+
+namespace Transport
+{
+
+namespace
+{
+
+std::mutex& RegistryMutex()
+{
+	static std::mutex mutex;
+	return mutex;
+}
+
+// running hosts by location
+std::unordered_map<std::string, std::weak_ptr<gRPCAsyncServerHost>>& Registry()
+{
+	static std::unordered_map<std::string, std::weak_ptr<gRPCAsyncServerHost>> registry;
+	return registry;
+}
+
+} // namespace
+
+struct gRPCAsyncServerHost::ServiceEntry final
+{
+	explicit ServiceEntry(MethodHandlers methodHandlers)
+		: handlers(std::move(methodHandlers))
+	{
+	}
+
+	const MethodHandlers handlers;
+
+	// guarded by m_servicesMutex
+	size_t runningCalls = 0;
+};
+
+// One call from being requested from the generic service until its response has been sent.
+// Unary calls only, the request is the one message the client sends.
+class gRPCAsyncServerHost::Call final
+{
+public:
+	Call(gRPCAsyncServerHost* host, ::grpc::ServerCompletionQueue* completionQueue)
+		: m_host(host)
+		, m_completionQueue(completionQueue)
+		, m_stream(&m_context)
+	{
+		m_host->m_genericService.RequestCall(&m_context, &m_stream, m_completionQueue, m_completionQueue, this);
+	}
+
+	void Proceed(bool ok)
+	{
+		switch (m_state)
+		{
+			case State::Requested:
+				if (!ok)
+				{
+					// the server is shutting down
+					delete this;
+					return;
+				}
+
+				// accept the next call while this one is served
+				new Call(m_host, m_completionQueue);
+
+				m_state = State::Reading;
+				m_stream.Read(&m_request, this);
+				return;
+			case State::Reading:
+			{
+				m_state = State::Finishing;
+				if (!ok)
+				{
+					m_stream.Finish(::grpc::Status(::grpc::StatusCode::INTERNAL, "no request received"), this);
+					return;
+				}
+
+				const ::grpc::Status status = m_host->Dispatch(&m_context, &m_request, &m_response);
+				if (status.ok())
+				{
+					m_stream.WriteAndFinish(m_response, ::grpc::WriteOptions{}, status, this);
+				}
+				else
+				{
+					m_stream.Finish(status, this);
+				}
+				return;
+			}
+			case State::Finishing:
+				delete this;
+				return;
+		}
+	}
+
+private:
+	enum class State
+	{
+		Requested,
+		Reading,
+		Finishing,
+	};
+
+	gRPCAsyncServerHost* const m_host;
+	::grpc::ServerCompletionQueue* const m_completionQueue;
+
+	State m_state = State::Requested;
+
+	::grpc::GenericServerContext m_context;
+	::grpc::GenericServerAsyncReaderWriter m_stream;
+	::grpc::ByteBuffer m_request;
+	::grpc::ByteBuffer m_response;
+};
+
+std::shared_ptr<gRPCAsyncServerHost> gRPCAsyncServerHost::Create(
+	const std::vector<std::string>& locationUris,
+	int numberOfCompletionQueues,
+	int threadsPerCompletionQueue,
+	const TransportOptions& options)
+{
+	if (locationUris.empty() || numberOfCompletionQueues < 1 || threadsPerCompletionQueue < 1)
+	{
+		return nullptr;
+	}
+
+	std::shared_ptr<gRPCAsyncServerHost> host{new gRPCAsyncServerHost{locationUris}};
+
+	::grpc::ServerBuilder builder;
+	gRPC::ApplyServerOptions(builder, options);
+	for (const std::string& locationUri : locationUris)
+	{
+		builder.AddListeningPort(locationUri, ::grpc::InsecureServerCredentials());
+	}
+	builder.RegisterAsyncGenericService(&host->m_genericService);
+
+	for (int i = 0; i < numberOfCompletionQueues; ++i)
+	{
+		host->m_completionQueues.push_back(builder.AddCompletionQueue());
+	}
+
+	host->m_server = builder.BuildAndStart();
+	if (!host->m_server)
+	{
+		std::cerr << "gRPCAsyncServerHost::Create: starting server failed" << std::endl;
+		host->Shutdown();
+		return nullptr;
+	}
+
+	for (const std::unique_ptr<::grpc::ServerCompletionQueue>& completionQueue : host->m_completionQueues)
+	{
+		::grpc::ServerCompletionQueue* queue = completionQueue.get();
+
+		// one outstanding call per thread, so that all of them can serve a call at the same time
+		for (int i = 0; i < threadsPerCompletionQueue; ++i)
+		{
+			new Call(host.get(), queue);
+		}
+
+		for (int i = 0; i < threadsPerCompletionQueue; ++i)
+		{
+			host->m_threads.emplace_back([queue]()
+			{
+				void* tag = nullptr;
+				bool ok = false;
+				while (queue->Next(&tag, &ok))
+				{
+					static_cast<Call*>(tag)->Proceed(ok);
+				}
+			});
+		}
+	}
+
+	const std::lock_guard<std::mutex> lock{RegistryMutex()};
+	for (const std::string& locationUri : locationUris)
+	{
+		Registry()[locationUri] = host;
+	}
+
+	return host;
+}
+
+std::shared_ptr<gRPCAsyncServerHost> gRPCAsyncServerHost::Find(const std::string& locationUri)
+{
+	const std::lock_guard<std::mutex> lock{RegistryMutex()};
+	const auto foundHost = Registry().find(locationUri);
+	return foundHost != Registry().end() ? foundHost->second.lock() : nullptr;
+}
+
+gRPCAsyncServerHost::gRPCAsyncServerHost(std::vector<std::string> locationUris)
+	: m_locationUris(std::move(locationUris))
+{
+}
+
+gRPCAsyncServerHost::~gRPCAsyncServerHost()
+{
+	Shutdown();
+}
+
+bool gRPCAsyncServerHost::AddService(const std::string& serviceName, MethodHandlers handlers)
+{
+	const std::lock_guard<std::mutex> lock{m_servicesMutex};
+	return m_services.emplace(serviceName, std::make_shared<ServiceEntry>(std::move(handlers))).second;
+}
+
+void gRPCAsyncServerHost::RemoveService(const std::string& serviceName)
+{
+	std::unique_lock<std::mutex> lock{m_servicesMutex};
+	const auto foundService = m_services.find(serviceName);
+	if (foundService == m_services.end())
+	{
+		return;
+	}
+
+	const std::shared_ptr<ServiceEntry> service = foundService->second;
+	m_services.erase(foundService);
+
+	// the handlers refer to the service implementation, which may be destroyed right after
+	m_servicesCondition.wait(lock, [&service]()
+	{
+		return service->runningCalls == 0;
+	});
+}
+
+void gRPCAsyncServerHost::Shutdown()
+{
+	{
+		const std::lock_guard<std::mutex> lock{RegistryMutex()};
+		for (const std::string& locationUri : m_locationUris)
+		{
+			const auto foundHost = Registry().find(locationUri);
+			if (foundHost == Registry().end())
+			{
+				continue;
+			}
+
+			const std::shared_ptr<gRPCAsyncServerHost> registeredHost = foundHost->second.lock();
+			if (!registeredHost || registeredHost.get() == this)
+			{
+				Registry().erase(foundHost);
+			}
+		}
+	}
+
+	if (m_server)
+	{
+		m_server->Shutdown();
+	}
+
+	// the queues may only be shut down after the server
+	for (const std::unique_ptr<::grpc::ServerCompletionQueue>& completionQueue : m_completionQueues)
+	{
+		completionQueue->Shutdown();
+	}
+
+	for (std::thread& thread : m_threads)
+	{
+		if (thread.joinable())
+		{
+			thread.join();
+		}
+	}
+	m_threads.clear();
+
+	// a queue must be drained before it is destroyed, also if its threads have never been started
+	for (const std::unique_ptr<::grpc::ServerCompletionQueue>& completionQueue : m_completionQueues)
+	{
+		void* tag = nullptr;
+		bool ok = false;
+		while (completionQueue->Next(&tag, &ok))
+		{
+			static_cast<Call*>(tag)->Proceed(ok);
+		}
+	}
+	m_completionQueues.clear();
+	m_server.reset();
+}
+
+::grpc::Status gRPCAsyncServerHost::Dispatch(
+	::grpc::GenericServerContext* context,
+	::grpc::ByteBuffer* request,
+	::grpc::ByteBuffer* response)
+{
+	// method is "/<service name>/<method name>"
+	const std::string& fullMethodName = context->method();
+	const size_t separator = fullMethodName.rfind('/');
+	if (fullMethodName.empty() || fullMethodName.front() != '/' || separator == 0 || separator == std::string::npos)
+	{
+		return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, std::string{});
+	}
+
+	const std::string serviceName = fullMethodName.substr(1, separator - 1);
+	const std::string methodName = fullMethodName.substr(separator + 1);
+
+	std::shared_ptr<ServiceEntry> service;
+	MethodHandlers::const_iterator foundHandler;
+	{
+		const std::lock_guard<std::mutex> lock{m_servicesMutex};
+		const auto foundService = m_services.find(serviceName);
+		if (foundService == m_services.end())
+		{
+			// not attached yet or already stopped
+			return ::grpc::Status(::grpc::StatusCode::UNAVAILABLE, TvServiceBase::ErrorMessage_NoProcessingCallback);
+		}
+
+		service = foundService->second;
+		foundHandler = service->handlers.find(methodName);
+		if (foundHandler == service->handlers.end())
+		{
+			return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, std::string{});
+		}
+
+		++service->runningCalls;
+	}
+
+	const ::grpc::Status status = foundHandler->second(context, request, response);
+
+	{
+		const std::lock_guard<std::mutex> lock{m_servicesMutex};
+		--service->runningCalls;
+	}
+	m_servicesCondition.notify_all();
+
+	return status;
+}
+
+} // namespace Transport
+
+} // namespace TVRemoteScreenSDKCommunication
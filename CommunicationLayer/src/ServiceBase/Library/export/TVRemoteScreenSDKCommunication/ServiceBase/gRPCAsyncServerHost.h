@@ -0,0 +1,158 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include <grpc++/grpc++.h>
+#include <grpcpp/generic/async_generic_service.h>
+
+#include "ServerParams.h"
+
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace TVRemoteScreenSDKCommunication
+{
+
+namespace Transport
+{
+
+/**
+ * @brief gRPCAsyncServerHost is one asynchronous gRPC server shared by several services.
+ * It listens on the locations of all of them and serves every call from a small, fixed set of
+ * completion queues and threads instead of the pollers of one synchronous server per service.
+ * Services attach to a running host by their location and may come and go while it is running.
+ */
+class gRPCAsyncServerHost final
+{
+public:
+	using MethodHandler = std::function<::grpc::Status(
+		::grpc::ServerContext* context,
+		::grpc::ByteBuffer* request,
+		::grpc::ByteBuffer* response)>;
+
+	// method name (without the service name) -> handler
+	using MethodHandlers = std::unordered_map<std::string, MethodHandler>;
+
+	/**
+	 * @brief Create builds and starts a host listening on all given locations.
+	 * @param options transport options of the host, shared by all services it serves
+	 * @return host instance if creating and starting was successful
+	 */
+	static std::shared_ptr<gRPCAsyncServerHost> Create(
+		const std::vector<std::string>& locationUris,
+		int numberOfCompletionQueues = DefaultAsyncServerCompletionQueues,
+		int threadsPerCompletionQueue = DefaultAsyncServerThreadsPerCompletionQueue,
+		const TransportOptions& options = TransportOptions{});
+
+	/**
+	 * @brief Find returns the running host listening on the given location, if any.
+	 */
+	static std::shared_ptr<gRPCAsyncServerHost> Find(const std::string& locationUri);
+
+	/**
+	 * @brief MakeUnaryHandler adapts a synchronous unary method of a service implementation.
+	 */
+	template<typename Implementation, typename Request, typename Response>
+	static MethodHandler MakeUnaryHandler(
+		Implementation* implementation,
+		::grpc::Status (Implementation::*method)(::grpc::ServerContext*, const Request*, Response*));
+
+	~gRPCAsyncServerHost();
+
+	gRPCAsyncServerHost(const gRPCAsyncServerHost&) = delete;
+	gRPCAsyncServerHost& operator=(const gRPCAsyncServerHost&) = delete;
+
+	/**
+	 * @brief AddService routes the calls of the service with the given full name to its handlers.
+	 * @return false if the service has already been added
+	 */
+	bool AddService(const std::string& serviceName, MethodHandlers handlers);
+
+	/**
+	 * @brief RemoveService stops routing calls to the service and waits for its running calls to finish.
+	 * Must not be called from within a method handler.
+	 */
+	void RemoveService(const std::string& serviceName);
+
+	void Shutdown();
+
+private:
+	class Call;
+	struct ServiceEntry;
+
+	explicit gRPCAsyncServerHost(std::vector<std::string> locationUris);
+
+	::grpc::Status Dispatch(::grpc::GenericServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ByteBuffer* response);
+
+	const std::vector<std::string> m_locationUris;
+
+	::grpc::AsyncGenericService m_genericService;
+	std::unique_ptr<::grpc::Server> m_server;
+	std::vector<std::unique_ptr<::grpc::ServerCompletionQueue>> m_completionQueues;
+	std::vector<std::thread> m_threads;
+
+	std::mutex m_servicesMutex;
+	std::condition_variable m_servicesCondition;
+	std::unordered_map<std::string, std::shared_ptr<ServiceEntry>> m_services;
+};
+
+template<typename Implementation, typename Request, typename Response>
+gRPCAsyncServerHost::MethodHandler gRPCAsyncServerHost::MakeUnaryHandler(
+	Implementation* implementation,
+	::grpc::Status (Implementation::*method)(::grpc::ServerContext*, const Request*, Response*))
+{
+	return [implementation, method](
+		::grpc::ServerContext* context,
+		::grpc::ByteBuffer* requestBuffer,
+		::grpc::ByteBuffer* responseBuffer)
+	{
+		Request request;
+		::grpc::Status status = ::grpc::SerializationTraits<Request>::Deserialize(requestBuffer, &request);
+		if (!status.ok())
+		{
+			return status;
+		}
+
+		Response response;
+		status = (implementation->*method)(context, &request, &response);
+		if (!status.ok())
+		{
+			return status;
+		}
+
+		bool ownBuffer = false;
+		return ::grpc::SerializationTraits<Response>::Serialize(response, responseBuffer, &ownBuffer);
+	};
+}
+
+} // namespace Transport
+
+} // namespace TVRemoteScreenSDKCommunication
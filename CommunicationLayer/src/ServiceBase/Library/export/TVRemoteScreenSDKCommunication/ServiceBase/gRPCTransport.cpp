@@ -23,26 +23,224 @@
 //********************************************************************************//
 #include "gRPCTransport.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace TVRemoteScreenSDKCommunication
 {
 
 namespace Transport
 {
 
+namespace
+{
+
+struct ChannelPool final
+{
+	std::mutex mutex;
+
+	// channels in use by key, see ChannelKey
+	std::unordered_map<std::string, std::weak_ptr<gRPC::ChannelInterface>> channels;
+};
+
+ChannelPool& GetChannelPool()
+{
+	static ChannelPool pool;
+	return pool;
+}
+
+grpc_compression_algorithm ToCompressionAlgorithm(TransportCompression compression)
+{
+	switch (compression)
+	{
+		case TransportCompression::Deflate:
+			return GRPC_COMPRESS_DEFLATE;
+		case TransportCompression::Gzip:
+			return GRPC_COMPRESS_GZIP;
+		case TransportCompression::None:
+			break;
+	}
+	return GRPC_COMPRESS_NONE;
+}
+
+std::string ChannelKey(const std::string& destination, const ::grpc::ChannelArguments& arguments)
+{
+	grpc_channel_args channelArgs{};
+	arguments.SetChannelArgs(&channelArgs);
+
+	// equal arguments set in a different order still share the channel
+	std::vector<std::string> keyParts;
+	for (size_t i = 0; i < channelArgs.num_args; ++i)
+	{
+		const grpc_arg& argument = channelArgs.args[i];
+
+		std::string keyPart = argument.key;
+		keyPart.push_back('=');
+		switch (argument.type)
+		{
+			case GRPC_ARG_STRING:
+				keyPart.append(argument.value.string);
+				break;
+			case GRPC_ARG_INTEGER:
+				keyPart.append(std::to_string(argument.value.integer));
+				break;
+			case GRPC_ARG_POINTER:
+				keyPart.append(std::to_string(reinterpret_cast<uintptr_t>(argument.value.pointer.p)));
+				break;
+		}
+		keyParts.push_back(std::move(keyPart));
+	}
+	std::sort(keyParts.begin(), keyParts.end());
+
+	std::string key = destination;
+	for (const std::string& keyPart : keyParts)
+	{
+		key.push_back('\0');
+		key.append(keyPart);
+	}
+	return key;
+}
+
+} // namespace
+
 std::shared_ptr<gRPC::ChannelInterface> gRPC::CreateChannel(const std::string& destination)
 {
-	return ::grpc::CreateChannel(destination, ::grpc::InsecureChannelCredentials());
+	return CreateChannel(destination, ::grpc::ChannelArguments{});
+}
+
+std::shared_ptr<gRPC::ChannelInterface> gRPC::CreateChannel(
+	const std::string& destination,
+	const TransportOptions& options)
+{
+	return CreateChannel(destination, MakeChannelArguments(options));
+}
+
+::grpc::ChannelArguments gRPC::MakeChannelArguments(const TransportOptions& options)
+{
+	::grpc::ChannelArguments arguments;
+
+	if (options.maxMessageSize > 0)
+	{
+		arguments.SetMaxReceiveMessageSize(options.maxMessageSize);
+		arguments.SetMaxSendMessageSize(options.maxMessageSize);
+	}
+
+	if (options.keepaliveTime.count() > 0)
+	{
+		arguments.SetInt(GRPC_ARG_KEEPALIVE_TIME_MS, static_cast<int>(options.keepaliveTime.count()));
+	}
+
+	if (options.keepaliveTimeout.count() > 0)
+	{
+		arguments.SetInt(GRPC_ARG_KEEPALIVE_TIMEOUT_MS, static_cast<int>(options.keepaliveTimeout.count()));
+	}
+
+	if (options.compression != TransportCompression::None)
+	{
+		arguments.SetCompressionAlgorithm(ToCompressionAlgorithm(options.compression));
+	}
+
+	if (options.writeBufferSize > 0)
+	{
+		arguments.SetInt(GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE, options.writeBufferSize);
+	}
+
+	return arguments;
+}
+
+void gRPC::ApplyServerOptions(::grpc::ServerBuilder& builder, const TransportOptions& options)
+{
+	if (options.maxMessageSize > 0)
+	{
+		builder.SetMaxReceiveMessageSize(options.maxMessageSize);
+		builder.SetMaxSendMessageSize(options.maxMessageSize);
+	}
+
+	if (options.keepaliveTime.count() > 0)
+	{
+		builder.AddChannelArgument(GRPC_ARG_KEEPALIVE_TIME_MS, static_cast<int>(options.keepaliveTime.count()));
+	}
+
+	if (options.keepaliveTimeout.count() > 0)
+	{
+		builder.AddChannelArgument(GRPC_ARG_KEEPALIVE_TIMEOUT_MS, static_cast<int>(options.keepaliveTimeout.count()));
+	}
+
+	if (options.compression != TransportCompression::None)
+	{
+		builder.SetDefaultCompressionAlgorithm(ToCompressionAlgorithm(options.compression));
+	}
+
+	if (options.writeBufferSize > 0)
+	{
+		builder.AddChannelArgument(GRPC_ARG_HTTP2_WRITE_BUFFER_SIZE, options.writeBufferSize);
+	}
+}
+
+std::shared_ptr<gRPC::ChannelInterface> gRPC::CreateChannel(
+	const std::string& destination,
+	const ::grpc::ChannelArguments& arguments)
+{
+	const std::string key = ChannelKey(destination, arguments);
+
+	ChannelPool& pool = GetChannelPool();
+	const std::lock_guard<std::mutex> lock{pool.mutex};
+
+	const auto foundChannel = pool.channels.find(key);
+	if (foundChannel != pool.channels.end())
+	{
+		if (std::shared_ptr<ChannelInterface> channel = foundChannel->second.lock())
+		{
+			return channel;
+		}
+	}
+
+	// forget the channels whose last client has been stopped
+	for (auto channelIt = pool.channels.begin(); channelIt != pool.channels.end();)
+	{
+		channelIt = channelIt->second.expired() ? pool.channels.erase(channelIt) : std::next(channelIt);
+	}
+
+	std::shared_ptr<ChannelInterface> channel =
+		::grpc::CreateCustomChannel(destination, ::grpc::InsecureChannelCredentials(), arguments);
+	pool.channels[key] = channel;
+	return channel;
+}
+
+std::unique_ptr<gRPC::Server> gRPC::CreateAndStartSyncServer(
+	const std::string& locationUri,
+	Service* service,
+	int numberOfCompletionQueues,
+	int minPollingThreads,
+	int maxPollingThreads,
+	int completionQueuesTimeout)
+{
+	return CreateAndStartSyncServer(
+		locationUri,
+		service,
+		TransportOptions{},
+		numberOfCompletionQueues,
+		minPollingThreads,
+		maxPollingThreads,
+		completionQueuesTimeout);
 }
 
 std::unique_ptr<gRPC::Server> gRPC::CreateAndStartSyncServer(
 	const std::string& locationUri,
 	Service* service,
+	const TransportOptions& options,
 	int numberOfCompletionQueues,
 	int minPollingThreads,
 	int maxPollingThreads,
 	int completionQueuesTimeout)
 {
 	::grpc::ServerBuilder builder;
+	ApplyServerOptions(builder, options);
 
 	if (numberOfCompletionQueues > 0)
 	{
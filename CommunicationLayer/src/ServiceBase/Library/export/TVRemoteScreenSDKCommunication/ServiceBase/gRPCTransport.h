@@ -31,6 +31,8 @@
 
 #include "ServerParams.h"
 
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
+
 namespace TVRemoteScreenSDKCommunication
 {
 
@@ -47,7 +49,30 @@ struct gRPC final
 	using Status             = ::grpc::Status;
 	using StatusCode         = ::grpc::StatusCode;
 
+	/**
+	 * @brief CreateChannel returns a channel to the destination. Channels are shared by all clients
+	 * of the process using the same destination and channel arguments and closed with their last user.
+	 * @param destination location of the server (see gRPC documentation for supported schemes)
+	 * @param arguments channel arguments, part of the key the channel is shared by
+	 * @return channel instance
+	 */
 	static std::shared_ptr<ChannelInterface> CreateChannel(const std::string& destination);
+	static std::shared_ptr<ChannelInterface> CreateChannel(
+		const std::string& destination,
+		const ::grpc::ChannelArguments& arguments);
+	static std::shared_ptr<ChannelInterface> CreateChannel(
+		const std::string& destination,
+		const TransportOptions& options);
+
+	/**
+	 * @brief MakeChannelArguments translates the gRPC transport options into channel arguments.
+	 */
+	static ::grpc::ChannelArguments MakeChannelArguments(const TransportOptions& options);
+
+	/**
+	 * @brief ApplyServerOptions sets the gRPC transport options on a server about to be built.
+	 */
+	static void ApplyServerOptions(::grpc::ServerBuilder& builder, const TransportOptions& options);
 
 	/**
 	 * @brief CreateAndStartSyncServer creates and starts a synchronous gRPC server with the given parameters.
@@ -57,6 +82,7 @@ struct gRPC final
 	 * @param minPollingThreads minimum number of polling threads, 0 .. do not set, use gRPC default
 	 * @param maxPollingThreads maximum number of polling threads, 0 .. do not set, use gRPC default
 	 * @param completionQueuesTimeout timeout in milliseconds for completion queues, -1 .. do not set, use gRPC default
+	 * @param options transport options, only the gRPC ones apply
 	 * @return server instance if creating and starting was successful
 	 */
 	static std::unique_ptr<Server> CreateAndStartSyncServer(
@@ -66,6 +92,14 @@ struct gRPC final
 		int minPollingThreads = DefaultMinPollingThreads,
 		int maxPollingThreads = DefaultMaxPollingThreads,
 		int completionQueuesTimeout = DefaultCompletionQueueTimeout);
+	static std::unique_ptr<Server> CreateAndStartSyncServer(
+		const std::string& locationUri,
+		Service* service,
+		const TransportOptions& options,
+		int numberOfCompletionQueues = DefaultNumberOfCompletionQueues,
+		int minPollingThreads = DefaultMinPollingThreads,
+		int maxPollingThreads = DefaultMaxPollingThreads,
+		int completionQueuesTimeout = DefaultCompletionQueueTimeout);
 };
 
 } // namespace Transport
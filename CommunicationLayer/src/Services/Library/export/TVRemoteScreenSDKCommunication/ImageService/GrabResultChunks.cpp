@@ -0,0 +1,120 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include "GrabResultChunks.h"
+#include "PixelDataEncoding.h"
+
+#include "GrabResult.pb.h"
+#include "RegionsGrabResult.pb.h"
+
+#include <algorithm>
+
+namespace TVRemoteScreenSDKCommunication
+{
+namespace ImageService
+{
+
+namespace
+{
+
+// Releases the part of the picture data a slice has referenced, once gRPC is done sending it.
+void DestroyChunkData(void* chunkData)
+{
+	delete static_cast<FrameBuffer*>(chunkData);
+}
+
+// The fields besides the pixel data are the same in every chunk and serialized once into fieldsPrefix.
+std::vector<::grpc::ByteBuffer> EncodeChunks(const std::string& fieldsPrefix, const FrameBuffer& pictureData)
+{
+	const size_t chunks = GrabResultChunkCount(pictureData.size());
+
+	std::vector<::grpc::ByteBuffer> buffers;
+	buffers.reserve(chunks);
+
+	for (size_t chunk = 0; chunk < chunks; ++chunk)
+	{
+		const size_t offset = chunk * GrabResultChunkSize;
+		const size_t chunkSize = std::min(GrabResultChunkSize, pictureData.size() - offset);
+
+		std::string header = fieldsPrefix;
+		AppendPixelDataHeader(header, chunkSize);
+
+		// the slice keeps the owner of the picture data alive while the chunk is in flight
+		FrameBuffer* const chunkData = new FrameBuffer{pictureData.Slice(offset, chunkSize)};
+
+		const ::grpc::Slice slices[] = {
+			::grpc::Slice{header},
+			::grpc::Slice{const_cast<char*>(chunkData->data()), chunkData->size(), &DestroyChunkData, chunkData}};
+		buffers.emplace_back(slices, sizeof(slices) / sizeof(slices[0]));
+	}
+
+	return buffers;
+}
+
+} // namespace
+
+std::vector<::grpc::ByteBuffer> EncodeGrabResultChunks(
+	int32_t x,
+	int32_t y,
+	int32_t width,
+	int32_t height,
+	const FrameBuffer& pictureData)
+{
+	::tvimageservice::GrabResult grabResult;
+	grabResult.set_chunks(static_cast<uint32_t>(GrabResultChunkCount(pictureData.size())));
+	::tvimageservice::Rect* dirtyRect = grabResult.mutable_dirtyrect();
+	dirtyRect->set_x(x);
+	dirtyRect->set_y(y);
+	dirtyRect->set_width(width);
+	dirtyRect->set_height(height);
+
+	std::string fieldsPrefix;
+	grabResult.SerializeToString(&fieldsPrefix);
+
+	return EncodeChunks(fieldsPrefix, pictureData);
+}
+
+std::vector<::grpc::ByteBuffer> EncodeRegionsGrabResultChunks(
+	const std::vector<ImageRegion>& regions,
+	const FrameBuffer& pictureData)
+{
+	::tvimageservice::RegionsGrabResult grabResult;
+	grabResult.set_chunks(static_cast<uint32_t>(GrabResultChunkCount(pictureData.size())));
+	grabResult.mutable_regions()->Reserve(static_cast<int>(regions.size()));
+	for (const ImageRegion& region : regions)
+	{
+		::tvimageservice::Rect* rect = grabResult.add_regions();
+		rect->set_x(region.x);
+		rect->set_y(region.y);
+		rect->set_width(region.width);
+		rect->set_height(region.height);
+	}
+
+	std::string fieldsPrefix;
+	grabResult.SerializeToString(&fieldsPrefix);
+
+	return EncodeChunks(fieldsPrefix, pictureData);
+}
+
+} // namespace ImageService
+} // namespace TVRemoteScreenSDKCommunication
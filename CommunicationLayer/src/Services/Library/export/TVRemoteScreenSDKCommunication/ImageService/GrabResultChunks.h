@@ -0,0 +1,61 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include "GrabResultLimits.h"
+#include "ImageRegion.h"
+
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/FrameBuffer.h>
+
+#include <grpc++/support/byte_buffer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace TVRemoteScreenSDKCommunication
+{
+namespace ImageService
+{
+
+// Serializes picture data into the stream of GrabResult messages of ImageService::UpdateImage.
+// Only the few bytes around the pixel data are copied, every chunk references its part of the
+// picture data and shares its owner until gRPC has sent it. Unowned picture data has to be kept
+// alive by the caller until the buffers have been sent.
+std::vector<::grpc::ByteBuffer> EncodeGrabResultChunks(
+	int32_t x,
+	int32_t y,
+	int32_t width,
+	int32_t height,
+	const FrameBuffer& pictureData);
+
+// Serializes picture data into the stream of RegionsGrabResult messages of ImageService::UpdateImageRegions,
+// referencing the picture data like EncodeGrabResultChunks.
+std::vector<::grpc::ByteBuffer> EncodeRegionsGrabResultChunks(
+	const std::vector<ImageRegion>& regions,
+	const FrameBuffer& pictureData);
+
+} // namespace ImageService
+} // namespace TVRemoteScreenSDKCommunication
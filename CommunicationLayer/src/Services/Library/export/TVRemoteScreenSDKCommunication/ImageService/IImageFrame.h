@@ -0,0 +1,57 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/CallStatus.h>
+
+#include <functional>
+#include <string>
+
+namespace TVRemoteScreenSDKCommunication
+{
+namespace ImageService
+{
+
+// The picture data of one image update, received chunk by chunk from an IImageFrameSink.
+// Its calls are made one after another, though not necessarily from the same thread,
+// and end with either End or Abort.
+class IImageFrame
+{
+public:
+	using ResponseCallback = std::function<void(const CallStatus& callStatus)>;
+
+	virtual ~IImageFrame() = default;
+
+	// the chunk may be swapped out to keep it without a copy
+	virtual void AddChunk(std::string& chunk) = 0;
+
+	// all chunks have been added, response has to be called with the result
+	virtual void End(const ResponseCallback& response) = 0;
+
+	// the frame ended before all chunks were received
+	virtual void Abort() = 0;
+};
+
+} // namespace ImageService
+} // namespace TVRemoteScreenSDKCommunication
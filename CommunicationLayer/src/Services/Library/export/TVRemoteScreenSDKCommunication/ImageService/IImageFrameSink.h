@@ -0,0 +1,59 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include "IImageFrame.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace TVRemoteScreenSDKCommunication
+{
+namespace ImageService
+{
+
+// Receives the picture data of image updates chunk by chunk as it is read, instead of
+// joined into one string for the UpdateImage callback. Frames of different connections and
+// streams may be received concurrently, each through the IImageFrame it began with.
+class IImageFrameSink
+{
+public:
+	virtual ~IImageFrameSink() = default;
+
+	// pictureSizeHint is a reservation hint for the picture data to follow, it may be smaller than the picture.
+	// Returning nullptr rejects the frame, its chunks are dropped and the call fails with UNAVAILABLE.
+	virtual std::unique_ptr<IImageFrame> BeginFrame(
+		const std::string& comId,
+		int32_t x,
+		int32_t y,
+		int32_t width,
+		int32_t height,
+		uint32_t chunks,
+		size_t pictureSizeHint) = 0;
+};
+
+} // namespace ImageService
+} // namespace TVRemoteScreenSDKCommunication
@@ -0,0 +1,72 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include "PixelDataEncoding.h"
+
+#include <cstdint>
+
+namespace TVRemoteScreenSDKCommunication
+{
+namespace ImageService
+{
+
+namespace
+{
+
+// field numbers and wire types of pixelData in GrabResult and RegionsGrabResult and of PixelData.picture
+constexpr uint8_t PixelDataTag = (2 << 3) | 2;
+constexpr uint8_t PictureTag = (1 << 3) | 2;
+
+void AppendVarint(std::string& buffer, uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		buffer.push_back(static_cast<char>((value & 0x7F) | 0x80));
+		value >>= 7;
+	}
+	buffer.push_back(static_cast<char>(value));
+}
+
+size_t VarintSize(uint64_t value)
+{
+	size_t size = 1;
+	while (value >= 0x80)
+	{
+		value >>= 7;
+		++size;
+	}
+	return size;
+}
+
+} // namespace
+
+void AppendPixelDataHeader(std::string& buffer, size_t pictureSize)
+{
+	buffer.push_back(static_cast<char>(PixelDataTag));
+	AppendVarint(buffer, 1 + VarintSize(pictureSize) + pictureSize);
+	buffer.push_back(static_cast<char>(PictureTag));
+	AppendVarint(buffer, pictureSize);
+}
+
+} // namespace ImageService
+} // namespace TVRemoteScreenSDKCommunication
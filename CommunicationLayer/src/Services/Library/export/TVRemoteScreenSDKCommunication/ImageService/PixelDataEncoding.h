@@ -0,0 +1,49 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include "GrabResultLimits.h"
+
+#include <cstddef>
+#include <string>
+
+namespace TVRemoteScreenSDKCommunication
+{
+namespace ImageService
+{
+
+// Number of chunks a picture of the given size is sent in, 0 for an empty one.
+inline size_t GrabResultChunkCount(size_t pictureSize)
+{
+	return (pictureSize + GrabResultChunkSize - 1) / GrabResultChunkSize;
+}
+
+// Appends the field headers in front of the picture bytes of the pixelData field of GrabResult
+// and RegionsGrabResult. The other fields serialized in front of them followed by the picture bytes
+// form a valid message, so the picture bytes can be sent from where they are instead of being copied
+// into the message. The order of fields on the wire does not matter.
+void AppendPixelDataHeader(std::string& buffer, size_t pictureSize);
+
+} // namespace ImageService
+} // namespace TVRemoteScreenSDKCommunication
@@ -0,0 +1,264 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include "SharedFrameBuffer.h"
+
+#if !defined(_WIN32) && !defined(_WINCE)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TV_SHARED_FRAME_BUFFER_SUPPORTED
+#endif // !_WIN32 && !_WINCE
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+namespace TVRemoteScreenSDKCommunication
+{
+namespace ImageService
+{
+
+namespace
+{
+
+constexpr const char* LogPrefix = "[SharedFrameBuffer] ";
+
+// slot states in the control block
+constexpr uint32_t SlotReleased = 0; // the zero filled memory of a new buffer
+constexpr uint32_t SlotInUse = 1;
+
+// the control block is shared between processes, so its atomics must not need a lock
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "unexpected size of atomic slot state");
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "slot states need lock free atomics");
+
+bool TotalSize(uint32_t slotCount, uint64_t slotSize, size_t& totalSize)
+{
+	const uint64_t maxSize = std::min<uint64_t>(std::numeric_limits<size_t>::max(), std::numeric_limits<int64_t>::max());
+	if (slotCount == 0 || slotCount > SharedFrameBuffer::MaxSlotCount || slotSize == 0
+		|| slotSize > (maxSize - SharedFrameBuffer::ControlBlockSize) / slotCount)
+	{
+		return false;
+	}
+	totalSize = static_cast<size_t>(SharedFrameBuffer::ControlBlockSize + slotSize * slotCount);
+	return true;
+}
+
+} // namespace
+
+#if defined(TV_SHARED_FRAME_BUFFER_SUPPORTED)
+
+std::unique_ptr<SharedFrameBuffer> SharedFrameBuffer::Create(
+	const std::string& name,
+	uint32_t slotCount,
+	uint64_t slotSize,
+	uint32_t permissions)
+{
+	size_t totalSize = 0;
+	if (!TotalSize(slotCount, slotSize, totalSize))
+	{
+		std::cerr << LogPrefix << "invalid layout for " << name << std::endl;
+		return nullptr;
+	}
+
+	const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, static_cast<mode_t>(permissions));
+	if (fd < 0)
+	{
+		std::cerr << LogPrefix << "shm_open failed for " << name << std::endl;
+		return nullptr;
+	}
+
+	// shm_open applies the umask, the permissions are meant to be used as given
+	if (::fchmod(fd, static_cast<mode_t>(permissions)) != 0)
+	{
+		std::cerr << LogPrefix << "fchmod failed for " << name << std::endl;
+		::close(fd);
+		::shm_unlink(name.c_str());
+		return nullptr;
+	}
+
+	if (::ftruncate(fd, static_cast<off_t>(totalSize)) != 0)
+	{
+		std::cerr << LogPrefix << "ftruncate failed for " << name << std::endl;
+		::close(fd);
+		::shm_unlink(name.c_str());
+		return nullptr;
+	}
+
+	void* memory = ::mmap(nullptr, totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (memory == MAP_FAILED)
+	{
+		std::cerr << LogPrefix << "mmap failed for " << name << std::endl;
+		::shm_unlink(name.c_str());
+		return nullptr;
+	}
+
+	return std::unique_ptr<SharedFrameBuffer>(new SharedFrameBuffer(name, slotCount, slotSize, memory, true));
+}
+
+std::unique_ptr<SharedFrameBuffer> SharedFrameBuffer::Open(const std::string& name, uint32_t slotCount, uint64_t slotSize)
+{
+	size_t totalSize = 0;
+	if (!TotalSize(slotCount, slotSize, totalSize))
+	{
+		std::cerr << LogPrefix << "invalid layout for " << name << std::endl;
+		return nullptr;
+	}
+
+	const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+	if (fd < 0)
+	{
+		std::cerr << LogPrefix << "shm_open failed for " << name << std::endl;
+		return nullptr;
+	}
+
+	// never map beyond the end of the object, the creator could have announced a wrong size
+	struct stat status{};
+	if (::fstat(fd, &status) != 0 || static_cast<uint64_t>(status.st_size) < totalSize)
+	{
+		std::cerr << LogPrefix << "unexpected size of " << name << std::endl;
+		::close(fd);
+		return nullptr;
+	}
+
+	void* memory = ::mmap(nullptr, totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (memory == MAP_FAILED)
+	{
+		std::cerr << LogPrefix << "mmap failed for " << name << std::endl;
+		return nullptr;
+	}
+
+	return std::unique_ptr<SharedFrameBuffer>(new SharedFrameBuffer(name, slotCount, slotSize, memory, false));
+}
+
+SharedFrameBuffer::~SharedFrameBuffer()
+{
+	::munmap(m_memory, static_cast<size_t>(ControlBlockSize + m_slotSize * m_slotCount));
+	if (m_owner)
+	{
+		::shm_unlink(m_name.c_str());
+	}
+}
+
+#else // TV_SHARED_FRAME_BUFFER_SUPPORTED
+
+std::unique_ptr<SharedFrameBuffer> SharedFrameBuffer::Create(
+	const std::string& /*name*/,
+	uint32_t /*slotCount*/,
+	uint64_t /*slotSize*/,
+	uint32_t /*permissions*/)
+{
+	return nullptr;
+}
+
+std::unique_ptr<SharedFrameBuffer> SharedFrameBuffer::Open(const std::string& /*name*/, uint32_t /*slotCount*/, uint64_t /*slotSize*/)
+{
+	return nullptr;
+}
+
+SharedFrameBuffer::~SharedFrameBuffer() = default;
+
+#endif // TV_SHARED_FRAME_BUFFER_SUPPORTED
+
+SharedFrameBuffer::SharedFrameBuffer(std::string name, uint32_t slotCount, uint64_t slotSize, void* memory, bool owner)
+	: m_name{std::move(name)}
+	, m_slotCount{slotCount}
+	, m_slotSize{slotSize}
+	, m_memory{memory}
+	, m_owner{owner}
+{
+}
+
+const std::string& SharedFrameBuffer::GetName() const
+{
+	return m_name;
+}
+
+uint32_t SharedFrameBuffer::GetSlotCount() const
+{
+	return m_slotCount;
+}
+
+uint64_t SharedFrameBuffer::GetSlotSize() const
+{
+	return m_slotSize;
+}
+
+char* SharedFrameBuffer::Slot(uint32_t slot)
+{
+	if (slot >= m_slotCount)
+	{
+		return nullptr;
+	}
+	return static_cast<char*>(m_memory) + ControlBlockSize + slot * m_slotSize;
+}
+
+const char* SharedFrameBuffer::Slot(uint32_t slot) const
+{
+	if (slot >= m_slotCount)
+	{
+		return nullptr;
+	}
+	return static_cast<const char*>(m_memory) + ControlBlockSize + slot * m_slotSize;
+}
+
+bool SharedFrameBuffer::Acquire(uint32_t& slot)
+{
+	for (uint32_t i = 0; i < m_slotCount; ++i)
+	{
+		const uint32_t candidate = (m_nextSlot + i) % m_slotCount;
+
+		// pairs with Release, the agent is done reading before the slot gets overwritten
+		std::atomic<uint32_t>* state = SlotState(candidate);
+		if (state->load(std::memory_order_acquire) == SlotReleased)
+		{
+			// only the writer marks slots as in use
+			state->store(SlotInUse, std::memory_order_relaxed);
+			m_nextSlot = (candidate + 1) % m_slotCount;
+			slot = candidate;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void SharedFrameBuffer::Release(uint32_t slot)
+{
+	if (slot < m_slotCount)
+	{
+		SlotState(slot)->store(SlotReleased, std::memory_order_release);
+	}
+}
+
+std::atomic<uint32_t>* SharedFrameBuffer::SlotState(uint32_t slot) const
+{
+	return static_cast<std::atomic<uint32_t>*>(m_memory) + slot;
+}
+
+} // namespace ImageService
+} // namespace TVRemoteScreenSDKCommunication
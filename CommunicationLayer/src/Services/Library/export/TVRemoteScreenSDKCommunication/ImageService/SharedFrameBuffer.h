@@ -0,0 +1,103 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace TVRemoteScreenSDKCommunication
+{
+namespace ImageService
+{
+
+// Ring of equally sized frame slots in named shared memory.
+// The SDK creates the buffer and writes pixel data into a slot, the agent opens it by name
+// and only receives the slot index over ImageService::UpdateImageFromSharedFrameBuffer.
+// A control block in front of the slots holds the state of each slot. The writer only reuses
+// a slot after the agent has released it, so a slot stays valid until the agent calls Release.
+class SharedFrameBuffer final
+{
+public:
+	static constexpr uint32_t DefaultSlotCount = 3;
+
+	// Access permissions of the shared memory object, the agent needs read and write access
+	// to release slots. The default limits access to the user creating the buffer.
+	static constexpr uint32_t DefaultPermissions = 0600;
+
+	// in bytes, in front of the first slot
+	static constexpr uint64_t ControlBlockSize = 4096;
+	static constexpr uint32_t MaxSlotCount = ControlBlockSize / sizeof(uint32_t);
+
+	// Creates and maps a new buffer. The name is removed again when the returned object is destroyed.
+	// Returns nullptr if shared memory is not available on this platform or creation failed.
+	static std::unique_ptr<SharedFrameBuffer> Create(
+		const std::string& name,
+		uint32_t slotCount,
+		uint64_t slotSize,
+		uint32_t permissions = DefaultPermissions);
+
+	// Maps a buffer created by another process. Slots are only read, the control block is written by Release.
+	static std::unique_ptr<SharedFrameBuffer> Open(const std::string& name, uint32_t slotCount, uint64_t slotSize);
+
+	~SharedFrameBuffer();
+
+	SharedFrameBuffer(const SharedFrameBuffer&) = delete;
+	SharedFrameBuffer& operator=(const SharedFrameBuffer&) = delete;
+
+	const std::string& GetName() const;
+	uint32_t GetSlotCount() const;
+	uint64_t GetSlotSize() const;
+
+	// Returns nullptr for an invalid slot index.
+	char* Slot(uint32_t slot);
+	const char* Slot(uint32_t slot) const;
+
+	// Writer side: reserves the next slot released by the agent.
+	// Returns false while the agent holds all slots.
+	bool Acquire(uint32_t& slot);
+
+	// Agent side: hands a slot back once its frame has been consumed.
+	// The writer releases a slot it acquired but did not hand over.
+	void Release(uint32_t slot);
+
+private:
+	SharedFrameBuffer(std::string name, uint32_t slotCount, uint64_t slotSize, void* memory, bool owner);
+
+	std::atomic<uint32_t>* SlotState(uint32_t slot) const;
+
+	const std::string m_name;
+	const uint32_t m_slotCount;
+	const uint64_t m_slotSize;
+	void* const m_memory;
+	const bool m_owner;
+
+	// writer side, where Acquire starts looking for a released slot
+	uint32_t m_nextSlot = 0;
+};
+
+} // namespace ImageService
+} // namespace TVRemoteScreenSDKCommunication
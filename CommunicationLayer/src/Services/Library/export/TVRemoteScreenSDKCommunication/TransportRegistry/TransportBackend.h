@@ -0,0 +1,54 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/IServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/IServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/ServiceType.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TVRemoteScreenSDKCommunication
+{
+
+/**
+ * @brief TransportBackend creates the servers and clients of all services for one transport framework.
+ * It is a plain table of functions so that a backend built into a plugin can hand it out through a C entry point.
+ */
+struct TransportBackend
+{
+	// returns the server of the given service type, its concrete type is I<Service>Server
+	std::unique_ptr<IServiceServer> (*createServer)(ServiceType serviceType, const TransportOptions& transportOptions);
+
+	// returns the client of the given service type, its concrete type is I<Service>Client
+	std::unique_ptr<IServiceClient> (*createClient)(ServiceType serviceType, const TransportOptions& transportOptions);
+
+	// starts one server shared by the services listening on the given locations, null if not supported
+	std::shared_ptr<void> (*createSharedServer)(const std::vector<std::string>& locations, const TransportOptions& transportOptions);
+};
+
+} // namespace TVRemoteScreenSDKCommunication
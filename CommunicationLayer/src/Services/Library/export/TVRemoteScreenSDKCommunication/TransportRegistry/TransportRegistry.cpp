@@ -0,0 +1,117 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include "TransportRegistry.h"
+
+#include "internal/TransportRegistry/TransportBackends.h"
+
+#if defined(TV_COMM_ENABLE_GRPC) && !defined(TV_COMM_GRPC_IMPLEMENTATION)
+#include <dlfcn.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#endif
+
+namespace TVRemoteScreenSDKCommunication
+{
+
+namespace
+{
+
+#if defined(TV_COMM_ENABLE_GRPC) && !defined(TV_COMM_GRPC_IMPLEMENTATION)
+const char* const gRPCPluginFile = TV_COMM_GRPC_PLUGIN_FILE;
+const char* const gRPCPluginEntryPoint = "TVCommGetgRPCTransportBackend";
+
+// The plugin is looked up next to the module containing this code first, then in the default search path.
+// It stays loaded until the process exits, the services created by it may outlive any owner.
+const TransportBackend* LoadgRPCPlugin()
+{
+	std::vector<std::string> candidates;
+
+	Dl_info moduleInfo{};
+	if (dladdr(reinterpret_cast<const void*>(&gRPCPluginFile), &moduleInfo) != 0 && moduleInfo.dli_fname)
+	{
+		const std::string modulePath = moduleInfo.dli_fname;
+		const std::string::size_type separator = modulePath.rfind('/');
+		if (separator != std::string::npos)
+		{
+			candidates.push_back(modulePath.substr(0, separator + 1) + gRPCPluginFile);
+		}
+	}
+	candidates.emplace_back(gRPCPluginFile);
+
+	for (const std::string& candidate : candidates)
+	{
+		void* plugin = dlopen(candidate.c_str(), RTLD_NOW | RTLD_LOCAL);
+		if (!plugin)
+		{
+			continue;
+		}
+
+		using GetBackend = const TransportBackend* (*)();
+		const auto getBackend = reinterpret_cast<GetBackend>(dlsym(plugin, gRPCPluginEntryPoint));
+		if (!getBackend)
+		{
+			std::cerr << "[TransportRegistry] " << candidate << " has no gRPC transport backend: " << dlerror() << std::endl;
+			dlclose(plugin);
+			return nullptr;
+		}
+		return getBackend();
+	}
+
+	std::cerr << "[TransportRegistry] Failed to load the gRPC transport plugin: " << dlerror() << std::endl;
+	return nullptr;
+}
+#endif
+
+} // namespace
+
+const TransportBackend* TransportRegistry::Get(TransportFramework framework)
+{
+	switch (framework)
+	{
+		case TransportFramework::gRPCTransport:
+#if defined(TV_COMM_GRPC_IMPLEMENTATION)
+			return TVCommGetgRPCTransportBackend();
+#elif defined(TV_COMM_ENABLE_GRPC)
+		{
+			static const TransportBackend* const gRPCBackend = LoadgRPCPlugin();
+			return gRPCBackend;
+		}
+#else
+			break;
+#endif
+		case TransportFramework::TCPSocketTransport:
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
+			return TransportBackends::GetSocketIOTransportBackend();
+#else
+			break;
+#endif
+		case TransportFramework::UnknownTransport:
+			break;
+	}
+	return nullptr;
+}
+
+} // namespace TVRemoteScreenSDKCommunication
@@ -27,12 +27,12 @@
 
 #include "InServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/AccessControlInServicegRPCServer.h"
 #include "internal/Client/AccessControlInServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/AccessControlInServiceSocketIOServer.h"
 #include "internal/Client/AccessControlInServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace AccessControlService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<IAccessControlInServiceServer> InServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<IAccessControlInServiceServer> InServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IAccessControlInServiceServer>{new AccessControlInServicegRPCServer};
+	return std::unique_ptr<IAccessControlInServiceServer>{new AccessControlInServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IAccessControlInServiceClient> InServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<IAccessControlInServiceClient> InServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IAccessControlInServiceClient>{new AccessControlInServicegRPCClient};
+	return std::unique_ptr<IAccessControlInServiceClient>{new AccessControlInServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<IAccessControlInServiceServer> InServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<IAccessControlInServiceServer> InServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IAccessControlInServiceServer>{new AccessControlInServiceSocketIOServer};
+	return std::unique_ptr<IAccessControlInServiceServer>{new AccessControlInServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IAccessControlInServiceClient> InServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<IAccessControlInServiceClient> InServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IAccessControlInServiceClient>{new AccessControlInServiceSocketIOClient};
+	return std::unique_ptr<IAccessControlInServiceClient>{new AccessControlInServiceSocketIOClient{transportOptions}};
 }
 #endif
 
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportFramework.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 
 #include <memory>
 
@@ -42,10 +43,10 @@ class IAccessControlInServiceClient;
 struct InServiceFactory
 {
 	template<TransportFramework Framework = DefaultFramework>
-	static std::unique_ptr<IAccessControlInServiceServer> CreateServer();
+	static std::unique_ptr<IAccessControlInServiceServer> CreateServer(const TransportOptions& transportOptions = TransportOptions{});
 
 	template<TransportFramework Framework = DefaultFramework>
-	static std::unique_ptr<IAccessControlInServiceClient> CreateClient();
+	static std::unique_ptr<IAccessControlInServiceClient> CreateClient(const TransportOptions& transportOptions = TransportOptions{});
 };
 
 } // namespace AccessControlService
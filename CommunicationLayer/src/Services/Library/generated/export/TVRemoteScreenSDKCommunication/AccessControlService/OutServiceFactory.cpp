@@ -27,12 +27,12 @@
 
 #include "OutServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/AccessControlOutServicegRPCServer.h"
 #include "internal/Client/AccessControlOutServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/AccessControlOutServiceSocketIOServer.h"
 #include "internal/Client/AccessControlOutServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace AccessControlService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<IAccessControlOutServiceServer> OutServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<IAccessControlOutServiceServer> OutServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IAccessControlOutServiceServer>{new AccessControlOutServicegRPCServer};
+	return std::unique_ptr<IAccessControlOutServiceServer>{new AccessControlOutServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IAccessControlOutServiceClient> OutServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<IAccessControlOutServiceClient> OutServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IAccessControlOutServiceClient>{new AccessControlOutServicegRPCClient};
+	return std::unique_ptr<IAccessControlOutServiceClient>{new AccessControlOutServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<IAccessControlOutServiceServer> OutServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<IAccessControlOutServiceServer> OutServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IAccessControlOutServiceServer>{new AccessControlOutServiceSocketIOServer};
+	return std::unique_ptr<IAccessControlOutServiceServer>{new AccessControlOutServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IAccessControlOutServiceClient> OutServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<IAccessControlOutServiceClient> OutServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IAccessControlOutServiceClient>{new AccessControlOutServiceSocketIOClient};
+	return std::unique_ptr<IAccessControlOutServiceClient>{new AccessControlOutServiceSocketIOClient{transportOptions}};
 }
 #endif
 
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportFramework.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 
 #include <memory>
 
@@ -42,10 +43,10 @@ class IAccessControlOutServiceClient;
 struct OutServiceFactory
 {
 	template<TransportFramework Framework = DefaultFramework>
-	static std::unique_ptr<IAccessControlOutServiceServer> CreateServer();
+	static std::unique_ptr<IAccessControlOutServiceServer> CreateServer(const TransportOptions& transportOptions = TransportOptions{});
 
 	template<TransportFramework Framework = DefaultFramework>
-	static std::unique_ptr<IAccessControlOutServiceClient> CreateClient();
+	static std::unique_ptr<IAccessControlOutServiceClient> CreateClient(const TransportOptions& transportOptions = TransportOptions{});
 };
 
 } // namespace AccessControlService
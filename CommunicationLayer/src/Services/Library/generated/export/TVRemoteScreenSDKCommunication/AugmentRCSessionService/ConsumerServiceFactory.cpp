@@ -27,12 +27,12 @@
 
 #include "ConsumerServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/AugmentRCSessionConsumerServicegRPCServer.h"
 #include "internal/Client/AugmentRCSessionConsumerServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/AugmentRCSessionConsumerServiceSocketIOServer.h"
 #include "internal/Client/AugmentRCSessionConsumerServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace AugmentRCSessionService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<IAugmentRCSessionConsumerServiceServer> ConsumerServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<IAugmentRCSessionConsumerServiceServer> ConsumerServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IAugmentRCSessionConsumerServiceServer>{new AugmentRCSessionConsumerServicegRPCServer};
+	return std::unique_ptr<IAugmentRCSessionConsumerServiceServer>{new AugmentRCSessionConsumerServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IAugmentRCSessionConsumerServiceClient> ConsumerServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<IAugmentRCSessionConsumerServiceClient> ConsumerServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IAugmentRCSessionConsumerServiceClient>{new AugmentRCSessionConsumerServicegRPCClient};
+	return std::unique_ptr<IAugmentRCSessionConsumerServiceClient>{new AugmentRCSessionConsumerServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<IAugmentRCSessionConsumerServiceServer> ConsumerServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<IAugmentRCSessionConsumerServiceServer> ConsumerServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IAugmentRCSessionConsumerServiceServer>{new AugmentRCSessionConsumerServiceSocketIOServer};
+	return std::unique_ptr<IAugmentRCSessionConsumerServiceServer>{new AugmentRCSessionConsumerServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IAugmentRCSessionConsumerServiceClient> ConsumerServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<IAugmentRCSessionConsumerServiceClient> ConsumerServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IAugmentRCSessionConsumerServiceClient>{new AugmentRCSessionConsumerServiceSocketIOClient};
+	return std::unique_ptr<IAugmentRCSessionConsumerServiceClient>{new AugmentRCSessionConsumerServiceSocketIOClient{transportOptions}};
 }
 #endif
 
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportFramework.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 
 #include <memory>
 
@@ -42,10 +43,10 @@ class IAugmentRCSessionConsumerServiceClient;
 struct ConsumerServiceFactory
 {
 	template<TransportFramework Framework = DefaultFramework>
-	static std::unique_ptr<IAugmentRCSessionConsumerServiceServer> CreateServer();
+	static std::unique_ptr<IAugmentRCSessionConsumerServiceServer> CreateServer(const TransportOptions& transportOptions = TransportOptions{});
 
 	template<TransportFramework Framework = DefaultFramework>
-	static std::unique_ptr<IAugmentRCSessionConsumerServiceClient> CreateClient();
+	static std::unique_ptr<IAugmentRCSessionConsumerServiceClient> CreateClient(const TransportOptions& transportOptions = TransportOptions{});
 };
 
 } // namespace AugmentRCSessionService
@@ -27,12 +27,12 @@
 
 #include "ControlServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/AugmentRCSessionControlServicegRPCServer.h"
 #include "internal/Client/AugmentRCSessionControlServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/AugmentRCSessionControlServiceSocketIOServer.h"
 #include "internal/Client/AugmentRCSessionControlServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace AugmentRCSessionService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<IAugmentRCSessionControlServiceServer> ControlServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<IAugmentRCSessionControlServiceServer> ControlServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IAugmentRCSessionControlServiceServer>{new AugmentRCSessionControlServicegRPCServer};
+	return std::unique_ptr<IAugmentRCSessionControlServiceServer>{new AugmentRCSessionControlServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IAugmentRCSessionControlServiceClient> ControlServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<IAugmentRCSessionControlServiceClient> ControlServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IAugmentRCSessionControlServiceClient>{new AugmentRCSessionControlServicegRPCClient};
+	return std::unique_ptr<IAugmentRCSessionControlServiceClient>{new AugmentRCSessionControlServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<IAugmentRCSessionControlServiceServer> ControlServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<IAugmentRCSessionControlServiceServer> ControlServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IAugmentRCSessionControlServiceServer>{new AugmentRCSessionControlServiceSocketIOServer};
+	return std::unique_ptr<IAugmentRCSessionControlServiceServer>{new AugmentRCSessionControlServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IAugmentRCSessionControlServiceClient> ControlServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<IAugmentRCSessionControlServiceClient> ControlServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IAugmentRCSessionControlServiceClient>{new AugmentRCSessionControlServiceSocketIOClient};
+	return std::unique_ptr<IAugmentRCSessionControlServiceClient>{new AugmentRCSessionControlServiceSocketIOClient{transportOptions}};
 }
 #endif
 
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportFramework.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 
 #include <memory>
 
@@ -42,10 +43,10 @@ class IAugmentRCSessionControlServiceClient;
 struct ControlServiceFactory
 {
 	template<TransportFramework Framework = DefaultFramework>
-	static std::unique_ptr<IAugmentRCSessionControlServiceServer> CreateServer();
+	static std::unique_ptr<IAugmentRCSessionControlServiceServer> CreateServer(const TransportOptions& transportOptions = TransportOptions{});
 
 	template<TransportFramework Framework = DefaultFramework>
-	static std::unique_ptr<IAugmentRCSessionControlServiceClient> CreateClient();
+	static std::unique_ptr<IAugmentRCSessionControlServiceClient> CreateClient(const TransportOptions& transportOptions = TransportOptions{});
 };
 
 } // namespace AugmentRCSessionService
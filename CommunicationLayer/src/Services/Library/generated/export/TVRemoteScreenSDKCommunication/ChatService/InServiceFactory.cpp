@@ -27,12 +27,12 @@
 
 #include "InServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/ChatInServicegRPCServer.h"
 #include "internal/Client/ChatInServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/ChatInServiceSocketIOServer.h"
 #include "internal/Client/ChatInServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace ChatService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<IChatInServiceServer> InServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<IChatInServiceServer> InServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IChatInServiceServer>{new ChatInServicegRPCServer};
+	return std::unique_ptr<IChatInServiceServer>{new ChatInServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IChatInServiceClient> InServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<IChatInServiceClient> InServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IChatInServiceClient>{new ChatInServicegRPCClient};
+	return std::unique_ptr<IChatInServiceClient>{new ChatInServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<IChatInServiceServer> InServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<IChatInServiceServer> InServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IChatInServiceServer>{new ChatInServiceSocketIOServer};
+	return std::unique_ptr<IChatInServiceServer>{new ChatInServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IChatInServiceClient> InServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<IChatInServiceClient> InServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IChatInServiceClient>{new ChatInServiceSocketIOClient};
+	return std::unique_ptr<IChatInServiceClient>{new ChatInServiceSocketIOClient{transportOptions}};
 }
 #endif
 
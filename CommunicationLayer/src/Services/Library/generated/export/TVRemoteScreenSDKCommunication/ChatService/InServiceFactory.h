@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportFramework.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 
 #include <memory>
 
@@ -42,10 +43,10 @@ class IChatInServiceClient;
 struct InServiceFactory
 {
 	template<TransportFramework Framework = DefaultFramework>
-	static std::unique_ptr<IChatInServiceServer> CreateServer();
+	static std::unique_ptr<IChatInServiceServer> CreateServer(const TransportOptions& transportOptions = TransportOptions{});
 
 	template<TransportFramework Framework = DefaultFramework>
-	static std::unique_ptr<IChatInServiceClient> CreateClient();
+	static std::unique_ptr<IChatInServiceClient> CreateClient(const TransportOptions& transportOptions = TransportOptions{});
 };
 
 } // namespace ChatService
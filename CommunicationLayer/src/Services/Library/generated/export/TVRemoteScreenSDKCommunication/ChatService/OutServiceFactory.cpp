@@ -27,12 +27,12 @@
 
 #include "OutServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/ChatOutServicegRPCServer.h"
 #include "internal/Client/ChatOutServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/ChatOutServiceSocketIOServer.h"
 #include "internal/Client/ChatOutServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace ChatService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<IChatOutServiceServer> OutServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<IChatOutServiceServer> OutServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IChatOutServiceServer>{new ChatOutServicegRPCServer};
+	return std::unique_ptr<IChatOutServiceServer>{new ChatOutServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IChatOutServiceClient> OutServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<IChatOutServiceClient> OutServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IChatOutServiceClient>{new ChatOutServicegRPCClient};
+	return std::unique_ptr<IChatOutServiceClient>{new ChatOutServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<IChatOutServiceServer> OutServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<IChatOutServiceServer> OutServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IChatOutServiceServer>{new ChatOutServiceSocketIOServer};
+	return std::unique_ptr<IChatOutServiceServer>{new ChatOutServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IChatOutServiceClient> OutServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<IChatOutServiceClient> OutServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IChatOutServiceClient>{new ChatOutServiceSocketIOClient};
+	return std::unique_ptr<IChatOutServiceClient>{new ChatOutServiceSocketIOClient{transportOptions}};
 }
 #endif
 
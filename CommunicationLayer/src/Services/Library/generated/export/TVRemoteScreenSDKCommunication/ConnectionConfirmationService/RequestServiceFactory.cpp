@@ -27,12 +27,12 @@
 
 #include "RequestServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/ConnectionConfirmationRequestServicegRPCServer.h"
 #include "internal/Client/ConnectionConfirmationRequestServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/ConnectionConfirmationRequestServiceSocketIOServer.h"
 #include "internal/Client/ConnectionConfirmationRequestServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace ConnectionConfirmationService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<IConnectionConfirmationRequestServiceServer> RequestServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<IConnectionConfirmationRequestServiceServer> RequestServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IConnectionConfirmationRequestServiceServer>{new ConnectionConfirmationRequestServicegRPCServer};
+	return std::unique_ptr<IConnectionConfirmationRequestServiceServer>{new ConnectionConfirmationRequestServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IConnectionConfirmationRequestServiceClient> RequestServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<IConnectionConfirmationRequestServiceClient> RequestServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IConnectionConfirmationRequestServiceClient>{new ConnectionConfirmationRequestServicegRPCClient};
+	return std::unique_ptr<IConnectionConfirmationRequestServiceClient>{new ConnectionConfirmationRequestServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<IConnectionConfirmationRequestServiceServer> RequestServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<IConnectionConfirmationRequestServiceServer> RequestServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IConnectionConfirmationRequestServiceServer>{new ConnectionConfirmationRequestServiceSocketIOServer};
+	return std::unique_ptr<IConnectionConfirmationRequestServiceServer>{new ConnectionConfirmationRequestServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IConnectionConfirmationRequestServiceClient> RequestServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<IConnectionConfirmationRequestServiceClient> RequestServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IConnectionConfirmationRequestServiceClient>{new ConnectionConfirmationRequestServiceSocketIOClient};
+	return std::unique_ptr<IConnectionConfirmationRequestServiceClient>{new ConnectionConfirmationRequestServiceSocketIOClient{transportOptions}};
 }
 #endif
 
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportFramework.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 
 #include <memory>
 
@@ -42,10 +43,10 @@ class IConnectionConfirmationRequestServiceClient;
 struct RequestServiceFactory
 {
 	template<TransportFramework Framework = DefaultFramework>
-	static std::unique_ptr<IConnectionConfirmationRequestServiceServer> CreateServer();
+	static std::unique_ptr<IConnectionConfirmationRequestServiceServer> CreateServer(const TransportOptions& transportOptions = TransportOptions{});
 
 	template<TransportFramework Framework = DefaultFramework>
-	static std::unique_ptr<IConnectionConfirmationRequestServiceClient> CreateClient();
+	static std::unique_ptr<IConnectionConfirmationRequestServiceClient> CreateClient(const TransportOptions& transportOptions = TransportOptions{});
 };
 
 } // namespace ConnectionConfirmationService
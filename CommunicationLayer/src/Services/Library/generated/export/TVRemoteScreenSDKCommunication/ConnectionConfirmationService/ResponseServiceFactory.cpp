@@ -27,12 +27,12 @@
 
 #include "ResponseServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/ConnectionConfirmationResponseServicegRPCServer.h"
 #include "internal/Client/ConnectionConfirmationResponseServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/ConnectionConfirmationResponseServiceSocketIOServer.h"
 #include "internal/Client/ConnectionConfirmationResponseServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace ConnectionConfirmationService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<IConnectionConfirmationResponseServiceServer> ResponseServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<IConnectionConfirmationResponseServiceServer> ResponseServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IConnectionConfirmationResponseServiceServer>{new ConnectionConfirmationResponseServicegRPCServer};
+	return std::unique_ptr<IConnectionConfirmationResponseServiceServer>{new ConnectionConfirmationResponseServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IConnectionConfirmationResponseServiceClient> ResponseServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<IConnectionConfirmationResponseServiceClient> ResponseServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IConnectionConfirmationResponseServiceClient>{new ConnectionConfirmationResponseServicegRPCClient};
+	return std::unique_ptr<IConnectionConfirmationResponseServiceClient>{new ConnectionConfirmationResponseServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<IConnectionConfirmationResponseServiceServer> ResponseServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<IConnectionConfirmationResponseServiceServer> ResponseServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IConnectionConfirmationResponseServiceServer>{new ConnectionConfirmationResponseServiceSocketIOServer};
+	return std::unique_ptr<IConnectionConfirmationResponseServiceServer>{new ConnectionConfirmationResponseServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IConnectionConfirmationResponseServiceClient> ResponseServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<IConnectionConfirmationResponseServiceClient> ResponseServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IConnectionConfirmationResponseServiceClient>{new ConnectionConfirmationResponseServiceSocketIOClient};
+	return std::unique_ptr<IConnectionConfirmationResponseServiceClient>{new ConnectionConfirmationResponseServiceSocketIOClient{transportOptions}};
 }
 #endif
 
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportFramework.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 
 #include <memory>
 
@@ -42,10 +43,10 @@ class IConnectionConfirmationResponseServiceClient;
 struct ResponseServiceFactory
 {
 	template<TransportFramework Framework = DefaultFramework>
-	static std::unique_ptr<IConnectionConfirmationResponseServiceServer> CreateServer();
+	static std::unique_ptr<IConnectionConfirmationResponseServiceServer> CreateServer(const TransportOptions& transportOptions = TransportOptions{});
 
 	template<TransportFramework Framework = DefaultFramework>
-	static std::unique_ptr<IConnectionConfirmationResponseServiceClient> CreateClient();
+	static std::unique_ptr<IConnectionConfirmationResponseServiceClient> CreateClient(const TransportOptions& transportOptions = TransportOptions{});
 };
 
 } // namespace ConnectionConfirmationService
@@ -27,12 +27,12 @@
 
 #include "ServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/ConnectivityServicegRPCServer.h"
 #include "internal/Client/ConnectivityServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/ConnectivityServiceSocketIOServer.h"
 #include "internal/Client/ConnectivityServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace ConnectivityService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<IConnectivityServiceServer> ServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<IConnectivityServiceServer> ServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IConnectivityServiceServer>{new ConnectivityServicegRPCServer};
+	return std::unique_ptr<IConnectivityServiceServer>{new ConnectivityServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IConnectivityServiceClient> ServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<IConnectivityServiceClient> ServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IConnectivityServiceClient>{new ConnectivityServicegRPCClient};
+	return std::unique_ptr<IConnectivityServiceClient>{new ConnectivityServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<IConnectivityServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<IConnectivityServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IConnectivityServiceServer>{new ConnectivityServiceSocketIOServer};
+	return std::unique_ptr<IConnectivityServiceServer>{new ConnectivityServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IConnectivityServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<IConnectivityServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IConnectivityServiceClient>{new ConnectivityServiceSocketIOClient};
+	return std::unique_ptr<IConnectivityServiceClient>{new ConnectivityServiceSocketIOClient{transportOptions}};
 }
 #endif
 
@@ -27,12 +27,12 @@
 
 #include "ServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/ImageNotificationServicegRPCServer.h"
 #include "internal/Client/ImageNotificationServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/ImageNotificationServiceSocketIOServer.h"
 #include "internal/Client/ImageNotificationServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace ImageNotificationService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<IImageNotificationServiceServer> ServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<IImageNotificationServiceServer> ServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IImageNotificationServiceServer>{new ImageNotificationServicegRPCServer};
+	return std::unique_ptr<IImageNotificationServiceServer>{new ImageNotificationServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IImageNotificationServiceClient> ServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<IImageNotificationServiceClient> ServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IImageNotificationServiceClient>{new ImageNotificationServicegRPCClient};
+	return std::unique_ptr<IImageNotificationServiceClient>{new ImageNotificationServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<IImageNotificationServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<IImageNotificationServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IImageNotificationServiceServer>{new ImageNotificationServiceSocketIOServer};
+	return std::unique_ptr<IImageNotificationServiceServer>{new ImageNotificationServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IImageNotificationServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<IImageNotificationServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IImageNotificationServiceClient>{new ImageNotificationServiceSocketIOClient};
+	return std::unique_ptr<IImageNotificationServiceClient>{new ImageNotificationServiceSocketIOClient{transportOptions}};
 }
 #endif
 
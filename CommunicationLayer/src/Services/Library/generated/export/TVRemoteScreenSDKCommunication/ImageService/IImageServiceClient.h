@@ -27,9 +27,11 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/CallStatus.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/FrameBuffer.h>
 #include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/IServiceClient.h>
 
 #include <TVRemoteScreenSDKCommunication/ImageService/ColorFormat.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/ImageRegion.h>
 
 #include <cstdint>
 #include <string>
@@ -47,7 +49,10 @@ public:
 	virtual ~IImageServiceClient() = default;
 
 	// rpc call UpdateImage
+	// The picture data is sent from where it is. UpdateImageFrame takes a reference to it, so the caller
+	// does not need to hold it in a string.
 	virtual CallStatus UpdateImage(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const std::string& pictureData) = 0;
+	virtual CallStatus UpdateImageFrame(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const FrameBuffer& pictureData) = 0;
 
 	// rpc call UpdateImageDefinition
 	virtual CallStatus UpdateImageDefinition(const std::string& comId,
@@ -56,6 +61,25 @@ public:
 		int32_t height,
 		ColorFormat format,
 		double dpi) = 0;
+
+	// rpc call AnnounceSharedFrameBuffer
+	virtual CallStatus AnnounceSharedFrameBuffer(const std::string& comId, const std::string& name, uint32_t slotCount, uint64_t slotSize) = 0;
+
+	// rpc call UpdateImageFromSharedFrameBuffer
+	virtual CallStatus UpdateImageFromSharedFrameBuffer(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, uint32_t slot, uint64_t size) = 0;
+
+	// rpc call UpdateImageStream
+	// Frames are written to one stream which stays open between calls until StopImageStream or a change of comId.
+	// A call returns once the frame is written and the agent has acknowledged enough frames to take the next one.
+	// UpdateImageStreamFrame keeps the picture data until its frame is acknowledged, UpdateImageStream awaits the
+	// acknowledgement, as its picture data is only alive during the call.
+	virtual CallStatus UpdateImageStream(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const std::string& pictureData) = 0;
+	virtual CallStatus UpdateImageStreamFrame(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const FrameBuffer& pictureData) = 0;
+	virtual void StopImageStream() = 0;
+
+	// rpc call UpdateImageRegions
+	// pictureData holds the pixels of all regions one after another, each region line by line without padding.
+	virtual CallStatus UpdateImageRegions(const std::string& comId, const std::vector<ImageRegion>& regions, const std::string& pictureData) = 0;
 };
 
 } // namespace ImageService
@@ -30,9 +30,12 @@
 #include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/IServiceServer.h>
 
 #include <TVRemoteScreenSDKCommunication/ImageService/ColorFormat.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/IImageFrameSink.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/ImageRegion.h>
 
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -55,6 +58,9 @@ public:
 		std::function<void(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const std::string& pictureData, const UpdateImageResponseCallback& response)>;
 	virtual void SetUpdateImageCallback(const ProcessUpdateImageRequestCallback& requestProcessing) = 0;
 
+	// takes precedence over the UpdateImage callback for UpdateImage and UpdateImageStream when set
+	virtual void SetUpdateImageFrameSink(const std::shared_ptr<IImageFrameSink>& frameSink) = 0;
+
 	// rpc call UpdateImageDefinition
 	using UpdateImageDefinitionResponseCallback = std::function<void(
 
@@ -69,6 +75,30 @@ public:
 		double dpi,
 		const UpdateImageDefinitionResponseCallback& response)>;
 	virtual void SetUpdateImageDefinitionCallback(const ProcessUpdateImageDefinitionRequestCallback& requestProcessing) = 0;
+
+	// rpc call AnnounceSharedFrameBuffer
+	using AnnounceSharedFrameBufferResponseCallback = std::function<void(
+
+		const CallStatus& callStatus)>;
+	using ProcessAnnounceSharedFrameBufferRequestCallback =
+		std::function<void(const std::string& comId, const std::string& name, uint32_t slotCount, uint64_t slotSize, const AnnounceSharedFrameBufferResponseCallback& response)>;
+	virtual void SetAnnounceSharedFrameBufferCallback(const ProcessAnnounceSharedFrameBufferRequestCallback& requestProcessing) = 0;
+
+	// rpc call UpdateImageFromSharedFrameBuffer
+	using UpdateImageFromSharedFrameBufferResponseCallback = std::function<void(
+
+		const CallStatus& callStatus)>;
+	using ProcessUpdateImageFromSharedFrameBufferRequestCallback =
+		std::function<void(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, uint32_t slot, uint64_t size, const UpdateImageFromSharedFrameBufferResponseCallback& response)>;
+	virtual void SetUpdateImageFromSharedFrameBufferCallback(const ProcessUpdateImageFromSharedFrameBufferRequestCallback& requestProcessing) = 0;
+
+	// rpc call UpdateImageRegions
+	using UpdateImageRegionsResponseCallback = std::function<void(
+
+		const CallStatus& callStatus)>;
+	using ProcessUpdateImageRegionsRequestCallback =
+		std::function<void(const std::string& comId, const std::vector<ImageRegion>& regions, const std::string& pictureData, const UpdateImageRegionsResponseCallback& response)>;
+	virtual void SetUpdateImageRegionsCallback(const ProcessUpdateImageRegionsRequestCallback& requestProcessing) = 0;
 };
 
 } // namespace ImageService
@@ -27,12 +27,12 @@
 
 #include "ServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/ImageServicegRPCServer.h"
 #include "internal/Client/ImageServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/ImageServiceSocketIOServer.h"
 #include "internal/Client/ImageServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace ImageService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<IImageServiceServer> ServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<IImageServiceServer> ServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IImageServiceServer>{new ImageServicegRPCServer};
+	return std::unique_ptr<IImageServiceServer>{new ImageServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IImageServiceClient> ServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<IImageServiceClient> ServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IImageServiceClient>{new ImageServicegRPCClient};
+	return std::unique_ptr<IImageServiceClient>{new ImageServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<IImageServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<IImageServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IImageServiceServer>{new ImageServiceSocketIOServer};
+	return std::unique_ptr<IImageServiceServer>{new ImageServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IImageServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<IImageServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IImageServiceClient>{new ImageServiceSocketIOClient};
+	return std::unique_ptr<IImageServiceClient>{new ImageServiceSocketIOClient{transportOptions}};
 }
 #endif
 
@@ -27,12 +27,12 @@
 
 #include "ServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/InputServicegRPCServer.h"
 #include "internal/Client/InputServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/InputServiceSocketIOServer.h"
 #include "internal/Client/InputServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace InputService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<IInputServiceServer> ServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<IInputServiceServer> ServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IInputServiceServer>{new InputServicegRPCServer};
+	return std::unique_ptr<IInputServiceServer>{new InputServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IInputServiceClient> ServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<IInputServiceClient> ServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IInputServiceClient>{new InputServicegRPCClient};
+	return std::unique_ptr<IInputServiceClient>{new InputServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<IInputServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<IInputServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IInputServiceServer>{new InputServiceSocketIOServer};
+	return std::unique_ptr<IInputServiceServer>{new InputServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IInputServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<IInputServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IInputServiceClient>{new InputServiceSocketIOClient};
+	return std::unique_ptr<IInputServiceClient>{new InputServiceSocketIOClient{transportOptions}};
 }
 #endif
 
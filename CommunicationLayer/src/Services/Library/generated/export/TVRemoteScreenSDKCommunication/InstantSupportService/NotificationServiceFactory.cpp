@@ -27,12 +27,12 @@
 
 #include "NotificationServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/InstantSupportNotificationServicegRPCServer.h"
 #include "internal/Client/InstantSupportNotificationServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/InstantSupportNotificationServiceSocketIOServer.h"
 #include "internal/Client/InstantSupportNotificationServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace InstantSupportService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<IInstantSupportNotificationServiceServer> NotificationServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<IInstantSupportNotificationServiceServer> NotificationServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IInstantSupportNotificationServiceServer>{new InstantSupportNotificationServicegRPCServer};
+	return std::unique_ptr<IInstantSupportNotificationServiceServer>{new InstantSupportNotificationServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IInstantSupportNotificationServiceClient> NotificationServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<IInstantSupportNotificationServiceClient> NotificationServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IInstantSupportNotificationServiceClient>{new InstantSupportNotificationServicegRPCClient};
+	return std::unique_ptr<IInstantSupportNotificationServiceClient>{new InstantSupportNotificationServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<IInstantSupportNotificationServiceServer> NotificationServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<IInstantSupportNotificationServiceServer> NotificationServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IInstantSupportNotificationServiceServer>{new InstantSupportNotificationServiceSocketIOServer};
+	return std::unique_ptr<IInstantSupportNotificationServiceServer>{new InstantSupportNotificationServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IInstantSupportNotificationServiceClient> NotificationServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<IInstantSupportNotificationServiceClient> NotificationServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IInstantSupportNotificationServiceClient>{new InstantSupportNotificationServiceSocketIOClient};
+	return std::unique_ptr<IInstantSupportNotificationServiceClient>{new InstantSupportNotificationServiceSocketIOClient{transportOptions}};
 }
 #endif
 
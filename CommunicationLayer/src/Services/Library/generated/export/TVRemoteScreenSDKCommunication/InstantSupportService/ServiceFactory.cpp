@@ -27,12 +27,12 @@
 
 #include "ServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/InstantSupportServicegRPCServer.h"
 #include "internal/Client/InstantSupportServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/InstantSupportServiceSocketIOServer.h"
 #include "internal/Client/InstantSupportServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace InstantSupportService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<IInstantSupportServiceServer> ServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<IInstantSupportServiceServer> ServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IInstantSupportServiceServer>{new InstantSupportServicegRPCServer};
+	return std::unique_ptr<IInstantSupportServiceServer>{new InstantSupportServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IInstantSupportServiceClient> ServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<IInstantSupportServiceClient> ServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IInstantSupportServiceClient>{new InstantSupportServicegRPCClient};
+	return std::unique_ptr<IInstantSupportServiceClient>{new InstantSupportServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<IInstantSupportServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<IInstantSupportServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IInstantSupportServiceServer>{new InstantSupportServiceSocketIOServer};
+	return std::unique_ptr<IInstantSupportServiceServer>{new InstantSupportServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IInstantSupportServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<IInstantSupportServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IInstantSupportServiceClient>{new InstantSupportServiceSocketIOClient};
+	return std::unique_ptr<IInstantSupportServiceClient>{new InstantSupportServiceSocketIOClient{transportOptions}};
 }
 #endif
 
@@ -27,12 +27,12 @@
 
 #include "ServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/RegistrationServicegRPCServer.h"
 #include "internal/Client/RegistrationServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/RegistrationServiceSocketIOServer.h"
 #include "internal/Client/RegistrationServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace RegistrationService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<IRegistrationServiceServer> ServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<IRegistrationServiceServer> ServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IRegistrationServiceServer>{new RegistrationServicegRPCServer};
+	return std::unique_ptr<IRegistrationServiceServer>{new RegistrationServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IRegistrationServiceClient> ServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<IRegistrationServiceClient> ServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IRegistrationServiceClient>{new RegistrationServicegRPCClient};
+	return std::unique_ptr<IRegistrationServiceClient>{new RegistrationServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<IRegistrationServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<IRegistrationServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IRegistrationServiceServer>{new RegistrationServiceSocketIOServer};
+	return std::unique_ptr<IRegistrationServiceServer>{new RegistrationServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IRegistrationServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<IRegistrationServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IRegistrationServiceClient>{new RegistrationServiceSocketIOClient};
+	return std::unique_ptr<IRegistrationServiceClient>{new RegistrationServiceSocketIOClient{transportOptions}};
 }
 #endif
 
@@ -27,12 +27,12 @@
 
 #include "ServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/SessionControlServicegRPCServer.h"
 #include "internal/Client/SessionControlServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/SessionControlServiceSocketIOServer.h"
 #include "internal/Client/SessionControlServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace SessionControlService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<ISessionControlServiceServer> ServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<ISessionControlServiceServer> ServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<ISessionControlServiceServer>{new SessionControlServicegRPCServer};
+	return std::unique_ptr<ISessionControlServiceServer>{new SessionControlServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<ISessionControlServiceClient> ServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<ISessionControlServiceClient> ServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<ISessionControlServiceClient>{new SessionControlServicegRPCClient};
+	return std::unique_ptr<ISessionControlServiceClient>{new SessionControlServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<ISessionControlServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<ISessionControlServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<ISessionControlServiceServer>{new SessionControlServiceSocketIOServer};
+	return std::unique_ptr<ISessionControlServiceServer>{new SessionControlServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<ISessionControlServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<ISessionControlServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<ISessionControlServiceClient>{new SessionControlServiceSocketIOClient};
+	return std::unique_ptr<ISessionControlServiceClient>{new SessionControlServiceSocketIOClient{transportOptions}};
 }
 #endif
 
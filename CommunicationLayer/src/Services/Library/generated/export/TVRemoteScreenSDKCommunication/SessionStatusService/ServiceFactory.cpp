@@ -27,12 +27,12 @@
 
 #include "ServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/SessionStatusServicegRPCServer.h"
 #include "internal/Client/SessionStatusServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/SessionStatusServiceSocketIOServer.h"
 #include "internal/Client/SessionStatusServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace SessionStatusService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<ISessionStatusServiceServer> ServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<ISessionStatusServiceServer> ServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<ISessionStatusServiceServer>{new SessionStatusServicegRPCServer};
+	return std::unique_ptr<ISessionStatusServiceServer>{new SessionStatusServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<ISessionStatusServiceClient> ServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<ISessionStatusServiceClient> ServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<ISessionStatusServiceClient>{new SessionStatusServicegRPCClient};
+	return std::unique_ptr<ISessionStatusServiceClient>{new SessionStatusServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<ISessionStatusServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<ISessionStatusServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<ISessionStatusServiceServer>{new SessionStatusServiceSocketIOServer};
+	return std::unique_ptr<ISessionStatusServiceServer>{new SessionStatusServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<ISessionStatusServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<ISessionStatusServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<ISessionStatusServiceClient>{new SessionStatusServiceSocketIOClient};
+	return std::unique_ptr<ISessionStatusServiceClient>{new SessionStatusServiceSocketIOClient{transportOptions}};
 }
 #endif
 
@@ -27,12 +27,12 @@
 
 #include "ServiceFactory.h"
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 #include "internal/Server/ViewGeometryServicegRPCServer.h"
 #include "internal/Client/ViewGeometryServicegRPCClient.h"
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 #include "internal/Server/ViewGeometryServiceSocketIOServer.h"
 #include "internal/Client/ViewGeometryServiceSocketIOClient.h"
 #endif
@@ -43,31 +43,31 @@ namespace TVRemoteScreenSDKCommunication
 namespace ViewGeometryService
 {
 
-#ifdef TV_COMM_ENABLE_GRPC
+#ifdef TV_COMM_GRPC_IMPLEMENTATION
 template<>
-std::unique_ptr<IViewGeometryServiceServer> ServiceFactory::CreateServer<gRPCTransport>()
+std::unique_ptr<IViewGeometryServiceServer> ServiceFactory::CreateServer<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IViewGeometryServiceServer>{new ViewGeometryServicegRPCServer};
+	return std::unique_ptr<IViewGeometryServiceServer>{new ViewGeometryServicegRPCServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IViewGeometryServiceClient> ServiceFactory::CreateClient<gRPCTransport>()
+std::unique_ptr<IViewGeometryServiceClient> ServiceFactory::CreateClient<gRPCTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IViewGeometryServiceClient>{new ViewGeometryServicegRPCClient};
+	return std::unique_ptr<IViewGeometryServiceClient>{new ViewGeometryServicegRPCClient{transportOptions}};
 }
 #endif
 
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
+#ifdef TV_COMM_PLAIN_SOCKET_IMPLEMENTATION
 template<>
-std::unique_ptr<IViewGeometryServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>()
+std::unique_ptr<IViewGeometryServiceServer> ServiceFactory::CreateServer<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IViewGeometryServiceServer>{new ViewGeometryServiceSocketIOServer};
+	return std::unique_ptr<IViewGeometryServiceServer>{new ViewGeometryServiceSocketIOServer{transportOptions}};
 }
 
 template<>
-std::unique_ptr<IViewGeometryServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>()
+std::unique_ptr<IViewGeometryServiceClient> ServiceFactory::CreateClient<TCPSocketTransport>(const TransportOptions& transportOptions)
 {
-	return std::unique_ptr<IViewGeometryServiceClient>{new ViewGeometryServiceSocketIOClient};
+	return std::unique_ptr<IViewGeometryServiceClient>{new ViewGeometryServiceSocketIOClient{transportOptions}};
 }
 #endif
 
@@ -52,7 +52,10 @@ void AccessControlInServiceSocketIOClient::StartClient(const std::string& destin
 {
 	m_destination = destination;
 
-	m_channel.reset(new Transport::SocketIO::ChannelInterface(m_destination));
+	m_channel.reset(new Transport::SocketIO::ChannelInterface(
+		m_destination,
+		Transport::SocketIO::ConnectionPolicy{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 }
 
 void AccessControlInServiceSocketIOClient::StopClient(bool /*force*/)
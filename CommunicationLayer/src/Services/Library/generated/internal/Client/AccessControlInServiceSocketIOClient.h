@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/AccessControlService/IAccessControlInServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIOTransport.h>
 
 #include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIO/ChannelInterface.h>
@@ -46,6 +47,10 @@ public:
 	using TransportFW = Transport::TCPSocket;
 
 	AccessControlInServiceSocketIOClient() = default;
+	explicit AccessControlInServiceSocketIOClient(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~AccessControlInServiceSocketIOClient() override = default;
 
 	void StartClient(const std::string& destination) override;
@@ -78,6 +83,7 @@ public:
 
 private:
 	std::string m_destination;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<TransportFW::ChannelInterface> m_channel;
 };
 
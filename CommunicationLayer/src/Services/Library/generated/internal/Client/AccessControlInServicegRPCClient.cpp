@@ -44,7 +44,7 @@ void AccessControlInServicegRPCClient::StartClient(const std::string& destinatio
 {
 	m_destination = destination;
 
-	m_channel = ::grpc::CreateChannel(m_destination, ::grpc::InsecureChannelCredentials());
+	m_channel = TransportFW::CreateChannel(m_destination, m_transportOptions);
 	m_stub = ::tvaccesscontrolservice::AccessControlInService::NewStub(m_channel);
 }
 
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/AccessControlService/IAccessControlInServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "AccessControlInService.grpc.pb.h"
@@ -45,6 +46,10 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	AccessControlInServicegRPCClient() = default;
+	explicit AccessControlInServicegRPCClient(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~AccessControlInServicegRPCClient() override = default;
 
 	void StartClient(const std::string& destination) override;
@@ -75,6 +80,7 @@ public:
 
 private:
 	std::string m_destination;
+	TransportOptions m_transportOptions;
 	std::shared_ptr<::grpc::ChannelInterface> m_channel;
 	std::unique_ptr<::tvaccesscontrolservice::AccessControlInService::Stub> m_stub;
 };
@@ -45,7 +45,10 @@ void AccessControlOutServiceSocketIOClient::StartClient(const std::string& desti
 {
 	m_destination = destination;
 
-	m_channel.reset(new Transport::SocketIO::ChannelInterface(m_destination));
+	m_channel.reset(new Transport::SocketIO::ChannelInterface(
+		m_destination,
+		Transport::SocketIO::ConnectionPolicy{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 }
 
 void AccessControlOutServiceSocketIOClient::StopClient(bool /*force*/)
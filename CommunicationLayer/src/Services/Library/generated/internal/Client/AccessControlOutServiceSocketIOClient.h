@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/AccessControlService/IAccessControlOutServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIOTransport.h>
 
 #include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIO/ChannelInterface.h>
@@ -46,6 +47,10 @@ public:
 	using TransportFW = Transport::TCPSocket;
 
 	AccessControlOutServiceSocketIOClient() = default;
+	explicit AccessControlOutServiceSocketIOClient(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~AccessControlOutServiceSocketIOClient() override = default;
 
 	void StartClient(const std::string& destination) override;
@@ -72,6 +77,7 @@ public:
 
 private:
 	std::string m_destination;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<TransportFW::ChannelInterface> m_channel;
 };
 
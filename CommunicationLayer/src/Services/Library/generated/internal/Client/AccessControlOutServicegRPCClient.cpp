@@ -42,7 +42,7 @@ void AccessControlOutServicegRPCClient::StartClient(const std::string& destinati
 {
 	m_destination = destination;
 
-	m_channel = ::grpc::CreateChannel(m_destination, ::grpc::InsecureChannelCredentials());
+	m_channel = TransportFW::CreateChannel(m_destination, m_transportOptions);
 	m_stub = ::tvaccesscontrolservice::AccessControlOutService::NewStub(m_channel);
 }
 
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/AccessControlService/IAccessControlOutServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "AccessControlOutService.grpc.pb.h"
@@ -45,6 +46,10 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	AccessControlOutServicegRPCClient() = default;
+	explicit AccessControlOutServicegRPCClient(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~AccessControlOutServicegRPCClient() override = default;
 
 	void StartClient(const std::string& destination) override;
@@ -69,6 +74,7 @@ public:
 
 private:
 	std::string m_destination;
+	TransportOptions m_transportOptions;
 	std::shared_ptr<::grpc::ChannelInterface> m_channel;
 	std::unique_ptr<::tvaccesscontrolservice::AccessControlOutService::Stub> m_stub;
 };
@@ -44,7 +44,10 @@ void AugmentRCSessionConsumerServiceSocketIOClient::StartClient(const std::strin
 {
 	m_destination = destination;
 
-	m_channel.reset(new Transport::SocketIO::ChannelInterface(m_destination));
+	m_channel.reset(new Transport::SocketIO::ChannelInterface(
+		m_destination,
+		Transport::SocketIO::ConnectionPolicy{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 }
 
 void AugmentRCSessionConsumerServiceSocketIOClient::StopClient(bool /*force*/)
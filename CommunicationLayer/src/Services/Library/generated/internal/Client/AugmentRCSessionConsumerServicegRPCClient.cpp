@@ -42,7 +42,7 @@ void AugmentRCSessionConsumerServicegRPCClient::StartClient(const std::string& d
 {
 	m_destination = destination;
 
-	m_channel = ::grpc::CreateChannel(m_destination, ::grpc::InsecureChannelCredentials());
+	m_channel = TransportFW::CreateChannel(m_destination, m_transportOptions);
 	m_stub = ::tvaugmentrcsessionservice::AugmentRCSessionConsumerService::NewStub(m_channel);
 }
 
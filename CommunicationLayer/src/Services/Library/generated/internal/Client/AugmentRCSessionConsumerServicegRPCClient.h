@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/AugmentRCSessionService/IAugmentRCSessionConsumerServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "AugmentRCSessionConsumerService.grpc.pb.h"
@@ -45,6 +46,10 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	AugmentRCSessionConsumerServicegRPCClient() = default;
+	explicit AugmentRCSessionConsumerServicegRPCClient(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~AugmentRCSessionConsumerServicegRPCClient() override = default;
 
 	void StartClient(const std::string& destination) override;
@@ -61,6 +66,7 @@ public:
 
 private:
 	std::string m_destination;
+	TransportOptions m_transportOptions;
 	std::shared_ptr<::grpc::ChannelInterface> m_channel;
 	std::unique_ptr<::tvaugmentrcsessionservice::AugmentRCSessionConsumerService::Stub> m_stub;
 };
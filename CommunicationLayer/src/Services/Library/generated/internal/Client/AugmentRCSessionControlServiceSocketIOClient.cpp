@@ -45,7 +45,10 @@ void AugmentRCSessionControlServiceSocketIOClient::StartClient(const std::string
 {
 	m_destination = destination;
 
-	m_channel.reset(new Transport::SocketIO::ChannelInterface(m_destination));
+	m_channel.reset(new Transport::SocketIO::ChannelInterface(
+		m_destination,
+		Transport::SocketIO::ConnectionPolicy{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 }
 
 void AugmentRCSessionControlServiceSocketIOClient::StopClient(bool /*force*/)
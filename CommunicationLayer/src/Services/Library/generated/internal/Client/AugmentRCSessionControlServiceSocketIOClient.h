@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/AugmentRCSessionService/IAugmentRCSessionControlServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIOTransport.h>
 
 #include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIO/ChannelInterface.h>
@@ -46,6 +47,10 @@ public:
 	using TransportFW = Transport::TCPSocket;
 
 	AugmentRCSessionControlServiceSocketIOClient() = default;
+	explicit AugmentRCSessionControlServiceSocketIOClient(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~AugmentRCSessionControlServiceSocketIOClient() override = default;
 
 	void StartClient(const std::string& destination) override;
@@ -75,6 +80,7 @@ public:
 
 private:
 	std::string m_destination;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<TransportFW::ChannelInterface> m_channel;
 };
 
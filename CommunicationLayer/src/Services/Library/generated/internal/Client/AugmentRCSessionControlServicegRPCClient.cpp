@@ -42,7 +42,7 @@ void AugmentRCSessionControlServicegRPCClient::StartClient(const std::string& de
 {
 	m_destination = destination;
 
-	m_channel = ::grpc::CreateChannel(m_destination, ::grpc::InsecureChannelCredentials());
+	m_channel = TransportFW::CreateChannel(m_destination, m_transportOptions);
 	m_stub = ::tvaugmentrcsessionservice::AugmentRCSessionControlService::NewStub(m_channel);
 }
 
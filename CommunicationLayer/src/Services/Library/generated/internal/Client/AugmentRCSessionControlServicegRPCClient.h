@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/AugmentRCSessionService/IAugmentRCSessionControlServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "AugmentRCSessionControlService.grpc.pb.h"
@@ -45,6 +46,10 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	AugmentRCSessionControlServicegRPCClient() = default;
+	explicit AugmentRCSessionControlServicegRPCClient(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~AugmentRCSessionControlServicegRPCClient() override = default;
 
 	void StartClient(const std::string& destination) override;
@@ -71,6 +76,7 @@ public:
 
 private:
 	std::string m_destination;
+	TransportOptions m_transportOptions;
 	std::shared_ptr<::grpc::ChannelInterface> m_channel;
 	std::unique_ptr<::tvaugmentrcsessionservice::AugmentRCSessionControlService::Stub> m_stub;
 };
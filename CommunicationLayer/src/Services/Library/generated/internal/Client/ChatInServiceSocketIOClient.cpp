@@ -45,7 +45,10 @@ void ChatInServiceSocketIOClient::StartClient(const std::string& destination)
 {
 	m_destination = destination;
 
-	m_channel.reset(new Transport::SocketIO::ChannelInterface(m_destination));
+	m_channel.reset(new Transport::SocketIO::ChannelInterface(
+		m_destination,
+		Transport::SocketIO::ConnectionPolicy{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 }
 
 void ChatInServiceSocketIOClient::StopClient(bool /*force*/)
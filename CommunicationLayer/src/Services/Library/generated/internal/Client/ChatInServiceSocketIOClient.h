@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/ChatService/IChatInServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIOTransport.h>
 
 #include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIO/ChannelInterface.h>
@@ -46,6 +47,10 @@ public:
 	using TransportFW = Transport::TCPSocket;
 
 	ChatInServiceSocketIOClient() = default;
+	explicit ChatInServiceSocketIOClient(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~ChatInServiceSocketIOClient() override = default;
 
 	void StartClient(const std::string& destination) override;
@@ -96,6 +101,7 @@ public:
 
 private:
 	std::string m_destination;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<TransportFW::ChannelInterface> m_channel;
 };
 
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/ChatService/IChatInServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "ChatInService.grpc.pb.h"
@@ -45,6 +46,10 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	ChatInServicegRPCClient() = default;
+	explicit ChatInServicegRPCClient(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~ChatInServicegRPCClient() override = default;
 
 	void StartClient(const std::string& destination) override;
@@ -90,6 +95,7 @@ public:
 
 private:
 	std::string m_destination;
+	TransportOptions m_transportOptions;
 	std::shared_ptr<::grpc::ChannelInterface> m_channel;
 	std::unique_ptr<::tvchatservice::ChatInService::Stub> m_stub;
 };
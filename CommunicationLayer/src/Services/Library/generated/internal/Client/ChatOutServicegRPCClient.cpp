@@ -42,7 +42,7 @@ void ChatOutServicegRPCClient::StartClient(const std::string& destination)
 {
 	m_destination = destination;
 
-	m_channel = ::grpc::CreateChannel(m_destination, ::grpc::InsecureChannelCredentials());
+	m_channel = TransportFW::CreateChannel(m_destination, m_transportOptions);
 	m_stub = ::tvchatservice::ChatOutService::NewStub(m_channel);
 }
 
@@ -42,7 +42,7 @@ void ConnectionConfirmationRequestServicegRPCClient::StartClient(const std::stri
 {
 	m_destination = destination;
 
-	m_channel = ::grpc::CreateChannel(m_destination, ::grpc::InsecureChannelCredentials());
+	m_channel = TransportFW::CreateChannel(m_destination, m_transportOptions);
 	m_stub = ::tvconnectionconfirmationservice::ConnectionConfirmationRequestService::NewStub(m_channel);
 }
 
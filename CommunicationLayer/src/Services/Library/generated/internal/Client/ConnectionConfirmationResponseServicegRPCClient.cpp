@@ -42,7 +42,7 @@ void ConnectionConfirmationResponseServicegRPCClient::StartClient(const std::str
 {
 	m_destination = destination;
 
-	m_channel = ::grpc::CreateChannel(m_destination, ::grpc::InsecureChannelCredentials());
+	m_channel = TransportFW::CreateChannel(m_destination, m_transportOptions);
 	m_stub = ::tvconnectionconfirmationservice::ConnectionConfirmationResponseService::NewStub(m_channel);
 }
 
@@ -47,7 +47,10 @@ void ConnectivityServiceSocketIOClient::StartClient(const std::string& destinati
 {
 	m_destination = destination;
 
-	m_channel.reset(new Transport::SocketIO::ChannelInterface(m_destination));
+	m_channel.reset(new Transport::SocketIO::ChannelInterface(
+		m_destination,
+		Transport::SocketIO::ConnectionPolicy{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 }
 
 void ConnectivityServiceSocketIOClient::StopClient(bool /*force*/)
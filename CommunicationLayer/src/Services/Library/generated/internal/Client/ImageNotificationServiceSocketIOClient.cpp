@@ -47,7 +47,10 @@ void ImageNotificationServiceSocketIOClient::StartClient(const std::string& dest
 {
 	m_destination = destination;
 
-	m_channel.reset(new Transport::SocketIO::ChannelInterface(m_destination));
+	m_channel.reset(new Transport::SocketIO::ChannelInterface(
+		m_destination,
+		Transport::SocketIO::ConnectionPolicy{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 }
 
 void ImageNotificationServiceSocketIOClient::StopClient(bool /*force*/)
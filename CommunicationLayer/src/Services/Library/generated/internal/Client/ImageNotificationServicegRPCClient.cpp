@@ -42,7 +42,7 @@ void ImageNotificationServicegRPCClient::StartClient(const std::string& destinat
 {
 	m_destination = destination;
 
-	m_channel = ::grpc::CreateChannel(m_destination, ::grpc::InsecureChannelCredentials());
+	m_channel = TransportFW::CreateChannel(m_destination, m_transportOptions);
 	m_stub = ::tvimagenotificationservice::ImageNotificationService::NewStub(m_channel);
 }
 
@@ -27,6 +27,8 @@
 
 #include "ImageServiceSocketIOClient.h"
 
+#include <TVRemoteScreenSDKCommunication/ImageService/GrabResultLimits.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/PixelDataEncoding.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/ClientErrorMessage.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/RequestMetadata.h>
 
@@ -37,6 +39,12 @@
 #include "ImageDefinitionRequest.pb.h"
 #include "ImageDefinitionResponse.pb.h"
 #include "ImageUpdateResponse.pb.h"
+#include "RegionsGrabResult.pb.h"
+#include "SharedFrameBufferRequest.pb.h"
+#include "SharedFrameBufferResponse.pb.h"
+#include "SharedFrameUpdate.pb.h"
+
+#include <algorithm>
 
 namespace TVRemoteScreenSDKCommunication
 {
@@ -44,11 +52,110 @@ namespace TVRemoteScreenSDKCommunication
 namespace ImageService
 {
 
+namespace
+{
+
+// Sends the message followed by the picture data, as a stream of messages if the picture is larger
+// than one chunk, like the gRPC client stream. The picture bytes are sent from where they are
+// instead of being copied into the messages. Each message of a stream repeats the other fields.
+// Peers not supporting streams get the whole picture in a single message, since the picture of
+// concatenated messages would be the one of the last message only.
+template<typename Message>
+Transport::SocketIO::Status SendPicture(Transport::SocketIO::ChannelInterface& channel,
+	const std::string& comId,
+	int64_t functionId,
+	Message& message,
+	const FrameBuffer& pictureData)
+{
+	using namespace Transport::SocketIO;
+
+	const size_t chunks = GrabResultChunkCount(pictureData.size());
+
+	std::unique_ptr<ChannelInterface::ClientStream> stream;
+	bool streamsSupported = false;
+	if (chunks > 1)
+	{
+		stream = channel.OpenStream(comId, functionId);
+		const Status status = stream->Open(streamsSupported);
+		if (!status.ok())
+		{
+			return status;
+		}
+	}
+
+	std::shared_ptr<std::string> responseRaw;
+	if (!streamsSupported)
+	{
+		message.set_chunks(1);
+
+		std::shared_ptr<std::string> request = std::make_shared<std::string>();
+		if (!message.SerializeToString(request.get()))
+		{
+			return {StatusCode::LOGIC_ERROR, "ImageServiceSocketIOClient: serializing request failed"};
+		}
+		AppendPixelDataHeader(*request, pictureData.size());
+
+		const Status status = channel.Call(comId, functionId, std::move(request), pictureData, responseRaw);
+		if (!status.ok())
+		{
+			return status;
+		}
+	}
+	else
+	{
+		message.set_chunks(static_cast<uint32_t>(chunks));
+
+		std::string fieldsPrefix;
+		if (!message.SerializeToString(&fieldsPrefix))
+		{
+			return {StatusCode::LOGIC_ERROR, "ImageServiceSocketIOClient: serializing request failed"};
+		}
+
+		for (size_t chunk = 0; chunk < chunks; ++chunk)
+		{
+			const size_t offset = chunk * GrabResultChunkSize;
+			const size_t chunkSize = std::min(GrabResultChunkSize, pictureData.size() - offset);
+
+			std::shared_ptr<std::string> frame = std::make_shared<std::string>(fieldsPrefix);
+			AppendPixelDataHeader(*frame, chunkSize);
+
+			const Status status = chunk + 1 < chunks
+				? stream->Write(std::move(frame), pictureData.Slice(offset, chunkSize))
+				: stream->Finish(std::move(frame), pictureData.Slice(offset, chunkSize), responseRaw);
+			if (!status.ok())
+			{
+				return status;
+			}
+		}
+	}
+
+	::tvimageservice::ImageUpdateResponse response{};
+	if (!response.ParseFromString(*responseRaw))
+	{
+		return {StatusCode::LOGIC_ERROR, "ImageServiceSocketIOClient: parsing response failed"};
+	}
+
+	return Status::OK;
+}
+
+void SetRect(::tvimageservice::Rect* rect, int32_t x, int32_t y, int32_t width, int32_t height)
+{
+	rect->set_x(x);
+	rect->set_y(y);
+	rect->set_height(height);
+	rect->set_width(width);
+}
+
+} // namespace
+
 void ImageServiceSocketIOClient::StartClient(const std::string& destination)
 {
 	m_destination = destination;
 
-	m_channel.reset(new Transport::SocketIO::ChannelInterface(m_destination));
+	m_channel.reset(new Transport::SocketIO::ChannelInterface(
+		m_destination,
+		Transport::SocketIO::ConnectionPolicy{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 }
 
 void ImageServiceSocketIOClient::StopClient(bool /*force*/)
@@ -67,12 +174,23 @@ const std::string& ImageServiceSocketIOClient::GetDestination() const
 }
 
 // rpc call UpdateImage
+// the caller keeps the picture data alive until the call returns
 auto ImageServiceSocketIOClient::UpdateImage(const std::string& comId,
 	int32_t x,
 	int32_t y,
 	int32_t width,
 	int32_t height,
 	const std::string& pictureData) -> CallStatus
+{
+	return UpdateImageFrame(comId, x, y, width, height, FrameBuffer::Unowned(pictureData.data(), pictureData.size()));
+}
+
+auto ImageServiceSocketIOClient::UpdateImageFrame(const std::string& comId,
+	int32_t x,
+	int32_t y,
+	int32_t width,
+	int32_t height,
+	const FrameBuffer& pictureData) -> CallStatus
 {
 	CallStatus returnValue{};
 
@@ -89,18 +207,9 @@ auto ImageServiceSocketIOClient::UpdateImage(const std::string& comId,
 	}
 
 	::tvimageservice::GrabResult request{};
+	SetRect(request.mutable_dirtyrect(), x, y, width, height);
 
-	request.set_chunks(1);
-	::tvimageservice::Rect* dirtyRect = request.mutable_dirtyrect();
-	dirtyRect->set_x(x);
-	dirtyRect->set_y(y);
-	dirtyRect->set_height(height);
-	dirtyRect->set_width(width);
-	request.mutable_pixeldata()->set_picture(pictureData);
-
-	::tvimageservice::ImageUpdateResponse response{};
-
-	Transport::SocketIO::Status status = m_channel->Call(comId, Function_UpdateImage, request, response);
+	const Transport::SocketIO::Status status = SendPicture(*m_channel, comId, Function_UpdateImage, request, pictureData);
 
 	if (status.ok())
 	{
@@ -185,6 +294,158 @@ auto ImageServiceSocketIOClient::UpdateImageDefinition(const std::string& comId,
 	return returnValue;
 }
 
+// rpc call AnnounceSharedFrameBuffer
+auto ImageServiceSocketIOClient::AnnounceSharedFrameBuffer(const std::string& comId,
+	const std::string& name,
+	uint32_t slotCount,
+	uint64_t slotSize) -> CallStatus
+{
+	CallStatus returnValue{};
+
+	if (m_channel == nullptr)
+	{
+		returnValue.errorMessage = TvServiceBase::ErrorMessage_MissingStartClient;
+		return returnValue;
+	}
+
+	if (comId.empty())
+	{
+		returnValue.errorMessage = TvServiceBase::ErrorMessage_InvalidInputParameter;
+		return returnValue;
+	}
+
+	::tvimageservice::SharedFrameBufferRequest request{};
+
+	request.set_name(name);
+
+	request.set_slotcount(slotCount);
+
+	request.set_slotsize(slotSize);
+
+	::tvimageservice::SharedFrameBufferResponse response{};
+
+	Transport::SocketIO::Status status = m_channel->Call(comId, Function_AnnounceSharedFrameBuffer, request, response);
+
+	if (status.ok())
+	{
+		returnValue = CallStatus{CallState::Ok};
+	}
+	else
+	{
+		returnValue.errorMessage = status.error_message();
+	}
+
+	return returnValue;
+}
+
+// rpc call UpdateImageFromSharedFrameBuffer
+auto ImageServiceSocketIOClient::UpdateImageFromSharedFrameBuffer(const std::string& comId,
+	int32_t x,
+	int32_t y,
+	int32_t width,
+	int32_t height,
+	uint32_t slot,
+	uint64_t size) -> CallStatus
+{
+	CallStatus returnValue{};
+
+	if (m_channel == nullptr)
+	{
+		returnValue.errorMessage = TvServiceBase::ErrorMessage_MissingStartClient;
+		return returnValue;
+	}
+
+	if (comId.empty())
+	{
+		returnValue.errorMessage = TvServiceBase::ErrorMessage_InvalidInputParameter;
+		return returnValue;
+	}
+
+	::tvimageservice::SharedFrameUpdate request{};
+
+	::tvimageservice::Rect* dirtyRect = request.mutable_dirtyrect();
+	dirtyRect->set_x(x);
+	dirtyRect->set_y(y);
+	dirtyRect->set_height(height);
+	dirtyRect->set_width(width);
+	request.set_slot(slot);
+	request.set_size(size);
+
+	::tvimageservice::ImageUpdateResponse response{};
+
+	Transport::SocketIO::Status status = m_channel->Call(comId, Function_UpdateImageFromSharedFrameBuffer, request, response);
+
+	if (status.ok())
+	{
+		returnValue = CallStatus{CallState::Ok};
+	}
+	else
+	{
+		returnValue.errorMessage = status.error_message();
+	}
+
+	return returnValue;
+}
+
+// rpc call UpdateImageStream
+// The channel already stays connected between calls and every frame is answered
+// before the next one is sent, so a frame on the stream is a plain UpdateImage.
+auto ImageServiceSocketIOClient::UpdateImageStream(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const std::string& pictureData)
+	-> CallStatus
+{
+	return UpdateImage(comId, x, y, width, height, pictureData);
+}
+
+auto ImageServiceSocketIOClient::UpdateImageStreamFrame(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const FrameBuffer& pictureData)
+	-> CallStatus
+{
+	return UpdateImageFrame(comId, x, y, width, height, pictureData);
+}
+
+void ImageServiceSocketIOClient::StopImageStream()
+{
+}
+
+// rpc call UpdateImageRegions
+auto ImageServiceSocketIOClient::UpdateImageRegions(const std::string& comId, const std::vector<ImageRegion>& regions, const std::string& pictureData)
+	-> CallStatus
+{
+	CallStatus returnValue{};
+
+	if (m_channel == nullptr)
+	{
+		returnValue.errorMessage = TvServiceBase::ErrorMessage_MissingStartClient;
+		return returnValue;
+	}
+
+	if (comId.empty() || regions.empty())
+	{
+		returnValue.errorMessage = TvServiceBase::ErrorMessage_InvalidInputParameter;
+		return returnValue;
+	}
+
+	::tvimageservice::RegionsGrabResult request{};
+	request.mutable_regions()->Reserve(static_cast<int>(regions.size()));
+	for (const ImageRegion& region : regions)
+	{
+		SetRect(request.add_regions(), region.x, region.y, region.width, region.height);
+	}
+
+	const Transport::SocketIO::Status status = SendPicture(
+		*m_channel, comId, Function_UpdateImageRegions, request, FrameBuffer::Unowned(pictureData.data(), pictureData.size()));
+
+	if (status.ok())
+	{
+		returnValue = CallStatus{CallState::Ok};
+	}
+	else
+	{
+		returnValue.errorMessage = status.error_message();
+	}
+
+	return returnValue;
+}
+
 } // namespace ImageService
 
 } // namespace TVRemoteScreenSDKCommunication
\ No newline at end of file
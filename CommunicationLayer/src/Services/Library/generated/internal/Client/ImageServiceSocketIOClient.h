@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/ImageService/IImageServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIOTransport.h>
 
 #include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIO/ChannelInterface.h>
@@ -46,6 +47,10 @@ public:
 	using TransportFW = Transport::TCPSocket;
 
 	ImageServiceSocketIOClient() = default;
+	explicit ImageServiceSocketIOClient(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~ImageServiceSocketIOClient() override = default;
 
 	void StartClient(const std::string& destination) override;
@@ -57,6 +62,7 @@ public:
 	// rpc call UpdateImage
 
 	CallStatus UpdateImage(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const std::string& pictureData) override;
+	CallStatus UpdateImageFrame(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const FrameBuffer& pictureData) override;
 
 	// rpc call UpdateImageDefinition
 
@@ -69,8 +75,23 @@ public:
 		ColorFormat format,
 		double dpi) override;
 
+	// rpc call AnnounceSharedFrameBuffer
+	CallStatus AnnounceSharedFrameBuffer(const std::string& comId, const std::string& name, uint32_t slotCount, uint64_t slotSize) override;
+
+	// rpc call UpdateImageFromSharedFrameBuffer
+	CallStatus UpdateImageFromSharedFrameBuffer(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, uint32_t slot, uint64_t size) override;
+
+	// rpc call UpdateImageStream
+	CallStatus UpdateImageStream(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const std::string& pictureData) override;
+	CallStatus UpdateImageStreamFrame(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const FrameBuffer& pictureData) override;
+	void StopImageStream() override;
+
+	// rpc call UpdateImageRegions
+	CallStatus UpdateImageRegions(const std::string& comId, const std::vector<ImageRegion>& regions, const std::string& pictureData) override;
+
 private:
 	std::string m_destination;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<TransportFW::ChannelInterface> m_channel;
 };
 
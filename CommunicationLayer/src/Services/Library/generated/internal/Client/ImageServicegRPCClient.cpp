@@ -30,7 +30,14 @@
 #include <TVRemoteScreenSDKCommunication/ServiceBase/ClientErrorMessage.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/RequestMetadata.h>
 
+#include <TVRemoteScreenSDKCommunication/ImageService/GrabResultChunks.h>
+
 #include <grpc++/create_channel.h>
+#include <grpc++/generic/generic_stub.h>
+
+#include <deque>
+#include <utility>
+#include <vector>
 
 namespace TVRemoteScreenSDKCommunication
 {
@@ -38,16 +45,288 @@ namespace TVRemoteScreenSDKCommunication
 namespace ImageService
 {
 
+namespace
+{
+
+// frames written to an image stream which the agent has not acknowledged yet
+constexpr uint32_t ImageStreamMaxFramesInFlight = 2;
+
+// Writes the encoded chunks of an image update on a generic call of the client streaming method
+// and reads its response.
+::grpc::Status WriteChunks(const std::shared_ptr<::grpc::ChannelInterface>& channel,
+	::grpc::ClientContext& context,
+	const char* methodName,
+	const std::vector<::grpc::ByteBuffer>& chunks,
+	::tvimageservice::ImageUpdateResponse& response)
+{
+	const std::string method = std::string{"/"} + ::tvimageservice::ImageService::service_full_name() + "/" + methodName;
+
+	::grpc::CompletionQueue completionQueue;
+	::grpc::GenericStub genericStub{channel};
+	std::unique_ptr<::grpc::GenericClientAsyncReaderWriter> call =
+		genericStub.PrepareCall(&context, method, &completionQueue);
+
+	// operations are started one after another, so the next event always belongs to the last one
+	void* const operationTag = call.get();
+	auto awaitOperation = [&completionQueue]()
+	{
+		void* tag = nullptr;
+		bool ok = false;
+		return completionQueue.Next(&tag, &ok) && ok;
+	};
+
+	call->StartCall(operationTag);
+	bool streamOk = awaitOperation();
+
+	for (const ::grpc::ByteBuffer& chunk : chunks)
+	{
+		if (!streamOk)
+		{
+			break;
+		}
+
+		call->Write(chunk, operationTag);
+		streamOk = awaitOperation();
+	}
+
+	if (streamOk)
+	{
+		call->WritesDone(operationTag);
+		streamOk = awaitOperation();
+	}
+
+	::grpc::ByteBuffer responseBuffer;
+	if (streamOk)
+	{
+		call->Read(&responseBuffer, operationTag);
+		streamOk = awaitOperation();
+	}
+
+	::grpc::Status callStatus;
+	call->Finish(&callStatus, operationTag);
+	awaitOperation();
+
+	completionQueue.Shutdown();
+	void* tag = nullptr;
+	bool ok = false;
+	while (completionQueue.Next(&tag, &ok))
+	{
+	}
+
+	if (!callStatus.ok())
+	{
+		return callStatus;
+	}
+
+	if (!streamOk)
+	{
+		return ::grpc::Status{::grpc::StatusCode::UNKNOWN, "stream closed before response"};
+	}
+
+	return ::grpc::SerializationTraits<::tvimageservice::ImageUpdateResponse>::Deserialize(&responseBuffer, &response);
+}
+
+} // namespace
+
+// Frames are written as raw chunks like in UpdateImage, acknowledgements are read concurrently.
+// A caller holds the mutex while using the stream, so one thread at a time drives the completion
+// queue, on which at most one call operation and one read are outstanding.
+struct ImageServicegRPCClient::ImageStream
+{
+	explicit ImageStream(std::string _comId)
+		: comId(std::move(_comId))
+	{
+	}
+
+	~ImageStream()
+	{
+		Close(true);
+	}
+
+	bool Open(const std::shared_ptr<::grpc::ChannelInterface>& channel)
+	{
+		const std::string method = std::string{"/"} + ::tvimageservice::ImageService::service_full_name() + "/UpdateImageStream";
+
+		context.AddMetadata(ServiceBase::CommunicationIdToken, comId);
+		genericStub.reset(new ::grpc::GenericStub{channel});
+		call = genericStub->PrepareCall(&context, method, &completionQueue);
+
+		call->StartCall(OperationTag());
+		if (!AwaitOperation())
+		{
+			return false;
+		}
+
+		Read();
+		return true;
+	}
+
+	bool IsOpen() const
+	{
+		return call != nullptr;
+	}
+
+	// may be called without holding the mutex, to unblock its holder
+	void Cancel()
+	{
+		context.TryCancel();
+	}
+
+	bool Write(const ::grpc::ByteBuffer& message)
+	{
+		call->Write(message, OperationTag());
+		return AwaitOperation();
+	}
+
+	bool AwaitAcknowledgement()
+	{
+		void* tag = nullptr;
+		bool ok = false;
+		while (reading && completionQueue.Next(&tag, &ok))
+		{
+			if (tag == ReadTag())
+			{
+				return HandleAcknowledgement(ok);
+			}
+		}
+		return false;
+	}
+
+	::grpc::Status Close(bool cancel)
+	{
+		if (closed)
+		{
+			return status;
+		}
+		closed = true;
+
+		if (call)
+		{
+			if (cancel)
+			{
+				context.TryCancel();
+			}
+			else if (!finished)
+			{
+				// the agent ends the stream after acknowledging the frames in flight
+				call->WritesDone(OperationTag());
+				if (AwaitOperation())
+				{
+					while (AwaitAcknowledgement())
+					{
+					}
+				}
+			}
+
+			call->Finish(&status, OperationTag());
+			AwaitOperation();
+		}
+
+		completionQueue.Shutdown();
+		void* tag = nullptr;
+		bool ok = false;
+		while (completionQueue.Next(&tag, &ok))
+		{
+		}
+
+		return status;
+	}
+
+	std::mutex mutex;
+
+	const std::string comId;
+	bool closed = false;
+	// the chunks of a frame refer to its picture data, which is kept until the agent has acknowledged it
+	std::deque<FrameBuffer> framesInFlight;
+	uint64_t framesAcknowledged = 0;
+	std::string rejection; // of a frame the agent did not process, reported by the next call
+
+private:
+	void* OperationTag()
+	{
+		return &call;
+	}
+
+	void* ReadTag()
+	{
+		return &acknowledgement;
+	}
+
+	void Read()
+	{
+		call->Read(&acknowledgement, ReadTag());
+		reading = true;
+	}
+
+	bool AwaitOperation()
+	{
+		void* tag = nullptr;
+		bool ok = false;
+		while (completionQueue.Next(&tag, &ok))
+		{
+			if (tag == ReadTag())
+			{
+				HandleAcknowledgement(ok);
+				continue;
+			}
+			return ok;
+		}
+		return false;
+	}
+
+	bool HandleAcknowledgement(bool ok)
+	{
+		reading = false;
+		if (!ok)
+		{
+			finished = true;
+			return false;
+		}
+
+		::tvimageservice::ImageStreamAck ack;
+		if (!::grpc::SerializationTraits<::tvimageservice::ImageStreamAck>::Deserialize(&acknowledgement, &ack).ok())
+		{
+			ack.set_ok(false);
+			ack.set_errormessage(TvServiceBase::ErrorMessage_InvalidResponseValue);
+		}
+
+		if (!framesInFlight.empty())
+		{
+			framesInFlight.pop_front();
+		}
+		++framesAcknowledged;
+
+		if (!ack.ok())
+		{
+			rejection = ack.errormessage().empty() ? std::string{"Frame rejected"} : ack.errormessage();
+		}
+
+		Read();
+		return true;
+	}
+
+	::grpc::ClientContext context;
+	::grpc::CompletionQueue completionQueue;
+	std::unique_ptr<::grpc::GenericStub> genericStub;
+	std::unique_ptr<::grpc::GenericClientAsyncReaderWriter> call;
+	::grpc::ByteBuffer acknowledgement;
+	::grpc::Status status{::grpc::StatusCode::CANCELLED, "Image stream not opened"};
+	bool reading = false;
+	bool finished = false; // no more acknowledgements will arrive
+};
+
 void ImageServicegRPCClient::StartClient(const std::string& destination)
 {
 	m_destination = destination;
 
-	m_channel = ::grpc::CreateChannel(m_destination, ::grpc::InsecureChannelCredentials());
+	m_channel = TransportFW::CreateChannel(m_destination, m_transportOptions);
 	m_stub = ::tvimageservice::ImageService::NewStub(m_channel);
 }
 
-void ImageServicegRPCClient::StopClient(bool /*force*/)
+void ImageServicegRPCClient::StopClient(bool force)
 {
+	CloseImageStream(force);
+
 	m_stub.reset();
 	m_channel.reset();
 }
@@ -63,8 +342,15 @@ const std::string& ImageServicegRPCClient::GetDestination() const
 }
 
 // rpc call UpdateImage
+// the caller keeps the picture data alive until the call returns
 auto ImageServicegRPCClient::UpdateImage(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const std::string& pictureData)
 	-> CallStatus
+{
+	return UpdateImageFrame(comId, x, y, width, height, FrameBuffer::Unowned(pictureData.data(), pictureData.size()));
+}
+
+auto ImageServicegRPCClient::UpdateImageFrame(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const FrameBuffer& pictureData)
+	-> CallStatus
 {
 	CallStatus returnValue{};
 
@@ -84,59 +370,12 @@ auto ImageServicegRPCClient::UpdateImage(const std::string& comId, int32_t x, in
 
 	context.AddMetadata(ServiceBase::CommunicationIdToken, comId);
 
-	::tvimageservice::GrabResult request{};
-
-	// no build request
-
 	::tvimageservice::ImageUpdateResponse response{};
 
-	::grpc::Status status = [this, &pictureData, &context, &request, &response, x, y, width, height]()
-	{
-		constexpr uint64_t ChunkSize = (2 * 1024 * 1024); // MB
-		std::unique_ptr<::grpc::ClientWriter<::tvimageservice::GrabResult>> writer = m_stub->UpdateImage(&context, &response);
-
-		size_t chunkCounter = 0;
-
-		size_t chunks = pictureData.size() / ChunkSize;
-
-		if (pictureData.size() % ChunkSize != 0)
-		{
-			chunks++;
-		}
-
-		for (chunkCounter = 0; chunkCounter < chunks; ++chunkCounter)
-		{
-			if (chunkCounter == 0)
-			{
-				request.set_chunks(chunks);
-				::tvimageservice::Rect* dirtyRect = request.mutable_dirtyrect();
-				dirtyRect->set_x(x);
-				dirtyRect->set_y(y);
-				dirtyRect->set_height(height);
-				dirtyRect->set_width(width);
-			}
-
-			auto buffer = new std::string();
-			if (chunkCounter == chunks - 1)
-			{
-				buffer->assign(pictureData.substr(chunkCounter * ChunkSize));
-			}
-			else
-			{
-				buffer->assign(pictureData.substr(chunkCounter * ChunkSize, ChunkSize));
-			}
-
-			request.mutable_pixeldata()->set_allocated_picture(buffer);
-
-			if (!writer->Write(request))
-			{
-				break;
-			}
-		}
-
-		writer->WritesDone();
-		return writer->Finish();
-	}();
+	// The chunks reference the picture data instead of carrying a copy of it,
+	// so they are written as raw messages on a generic call.
+	const ::grpc::Status status =
+		WriteChunks(m_channel, context, "UpdateImage", EncodeGrabResultChunks(x, y, width, height, pictureData), response);
 
 	if (status.ok())
 	{
@@ -225,6 +464,285 @@ auto ImageServicegRPCClient::UpdateImageDefinition(const std::string& comId,
 	return returnValue;
 }
 
+// rpc call AnnounceSharedFrameBuffer
+auto ImageServicegRPCClient::AnnounceSharedFrameBuffer(const std::string& comId,
+	const std::string& name,
+	uint32_t slotCount,
+	uint64_t slotSize) -> CallStatus
+{
+	CallStatus returnValue{};
+
+	if (m_channel == nullptr || m_stub == nullptr)
+	{
+		returnValue.errorMessage = TvServiceBase::ErrorMessage_MissingStartClient;
+		return returnValue;
+	}
+
+	if (comId.empty())
+	{
+		returnValue.errorMessage = TvServiceBase::ErrorMessage_InvalidInputParameter;
+		return returnValue;
+	}
+
+	::grpc::ClientContext context{};
+
+	context.AddMetadata(ServiceBase::CommunicationIdToken, comId);
+
+	::tvimageservice::SharedFrameBufferRequest request{};
+
+	request.set_name(name);
+
+	request.set_slotcount(slotCount);
+
+	request.set_slotsize(slotSize);
+
+	::tvimageservice::SharedFrameBufferResponse response{};
+
+	::grpc::Status status = m_stub->AnnounceSharedFrameBuffer(&context, request, &response);
+
+	if (status.ok())
+	{
+		returnValue = CallStatus{CallState::Ok};
+	}
+	else
+	{
+		returnValue.errorMessage = status.error_message();
+	}
+
+	return returnValue;
+}
+
+// rpc call UpdateImageFromSharedFrameBuffer
+auto ImageServicegRPCClient::UpdateImageFromSharedFrameBuffer(const std::string& comId,
+	int32_t x,
+	int32_t y,
+	int32_t width,
+	int32_t height,
+	uint32_t slot,
+	uint64_t size) -> CallStatus
+{
+	CallStatus returnValue{};
+
+	if (m_channel == nullptr || m_stub == nullptr)
+	{
+		returnValue.errorMessage = TvServiceBase::ErrorMessage_MissingStartClient;
+		return returnValue;
+	}
+
+	if (comId.empty())
+	{
+		returnValue.errorMessage = TvServiceBase::ErrorMessage_InvalidInputParameter;
+		return returnValue;
+	}
+
+	::grpc::ClientContext context{};
+
+	context.AddMetadata(ServiceBase::CommunicationIdToken, comId);
+
+	::tvimageservice::SharedFrameUpdate request{};
+
+	::tvimageservice::Rect* dirtyRect = request.mutable_dirtyrect();
+	dirtyRect->set_x(x);
+	dirtyRect->set_y(y);
+	dirtyRect->set_height(height);
+	dirtyRect->set_width(width);
+	request.set_slot(slot);
+	request.set_size(size);
+
+	::tvimageservice::ImageUpdateResponse response{};
+
+	::grpc::Status status = m_stub->UpdateImageFromSharedFrameBuffer(&context, request, &response);
+
+	if (status.ok())
+	{
+		returnValue = CallStatus{CallState::Ok};
+	}
+	else
+	{
+		returnValue.errorMessage = status.error_message();
+	}
+
+	return returnValue;
+}
+
+// rpc call UpdateImageStream
+// the caller keeps the picture data alive until the call returns
+auto ImageServicegRPCClient::UpdateImageStream(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const std::string& pictureData)
+	-> CallStatus
+{
+	return WriteImageStreamFrame(comId, x, y, width, height, FrameBuffer::Unowned(pictureData.data(), pictureData.size()), true);
+}
+
+auto ImageServicegRPCClient::UpdateImageStreamFrame(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const FrameBuffer& pictureData)
+	-> CallStatus
+{
+	return WriteImageStreamFrame(comId, x, y, width, height, pictureData, false);
+}
+
+auto ImageServicegRPCClient::WriteImageStreamFrame(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const FrameBuffer& pictureData, bool awaitFrame)
+	-> CallStatus
+{
+	CallStatus returnValue{};
+
+	if (m_channel == nullptr || m_stub == nullptr)
+	{
+		returnValue.errorMessage = TvServiceBase::ErrorMessage_MissingStartClient;
+		return returnValue;
+	}
+
+	if (comId.empty())
+	{
+		returnValue.errorMessage = TvServiceBase::ErrorMessage_InvalidInputParameter;
+		return returnValue;
+	}
+
+	const std::shared_ptr<ImageStream> stream = AcquireImageStream(comId);
+	std::lock_guard<std::mutex> streamLock(stream->mutex);
+
+	if (stream->closed)
+	{
+		returnValue.errorMessage = "Image stream stopped";
+		return returnValue;
+	}
+
+	bool ok = stream->IsOpen() || stream->Open(m_channel);
+
+	if (ok)
+	{
+		// in flight before its first chunk is written, the agent may acknowledge it while the last one is being written
+		stream->framesInFlight.push_back(pictureData);
+
+		for (const ::grpc::ByteBuffer& chunk : EncodeGrabResultChunks(x, y, width, height, pictureData))
+		{
+			ok = stream->Write(chunk);
+			if (!ok)
+			{
+				break;
+			}
+		}
+	}
+
+	if (ok)
+	{
+		// the first frame is awaited, so an agent not accepting the stream is noticed right away
+		const uint32_t maxFramesInFlight = (awaitFrame || stream->framesAcknowledged == 0) ? 1 : ImageStreamMaxFramesInFlight;
+		while (ok && stream->framesInFlight.size() >= maxFramesInFlight)
+		{
+			ok = stream->AwaitAcknowledgement();
+		}
+	}
+
+	if (!ok)
+	{
+		const ::grpc::Status status = stream->Close(true);
+		// no acknowledgements arrive on the closed stream anymore
+		stream->framesInFlight.clear();
+		ReleaseImageStream(stream);
+
+		returnValue.errorMessage = status.ok() ? "Image stream closed" : status.error_message();
+		return returnValue;
+	}
+
+	if (!stream->rejection.empty())
+	{
+		returnValue.errorMessage.swap(stream->rejection);
+		return returnValue;
+	}
+
+	return CallStatus{CallState::Ok};
+}
+
+void ImageServicegRPCClient::StopImageStream()
+{
+	CloseImageStream(false);
+}
+
+auto ImageServicegRPCClient::AcquireImageStream(const std::string& comId) -> std::shared_ptr<ImageStream>
+{
+	std::shared_ptr<ImageStream> replacedStream; // closed after the lock is released
+
+	std::lock_guard<std::mutex> lock(m_imageStreamMutex);
+	if (m_imageStream && m_imageStream->comId != comId)
+	{
+		replacedStream.swap(m_imageStream);
+	}
+
+	if (!m_imageStream)
+	{
+		m_imageStream = std::make_shared<ImageStream>(comId);
+	}
+
+	return m_imageStream;
+}
+
+void ImageServicegRPCClient::ReleaseImageStream(const std::shared_ptr<ImageStream>& stream)
+{
+	std::lock_guard<std::mutex> lock(m_imageStreamMutex);
+	if (m_imageStream == stream)
+	{
+		m_imageStream.reset();
+	}
+}
+
+void ImageServicegRPCClient::CloseImageStream(bool cancel)
+{
+	std::shared_ptr<ImageStream> stream;
+	{
+		std::lock_guard<std::mutex> lock(m_imageStreamMutex);
+		stream.swap(m_imageStream);
+	}
+
+	if (stream)
+	{
+		if (cancel)
+		{
+			stream->Cancel();
+		}
+
+		std::lock_guard<std::mutex> streamLock(stream->mutex);
+		stream->Close(cancel);
+	}
+}
+
+// rpc call UpdateImageRegions
+auto ImageServicegRPCClient::UpdateImageRegions(const std::string& comId, const std::vector<ImageRegion>& regions, const std::string& pictureData)
+	-> CallStatus
+{
+	CallStatus returnValue{};
+
+	if (m_channel == nullptr || m_stub == nullptr)
+	{
+		returnValue.errorMessage = TvServiceBase::ErrorMessage_MissingStartClient;
+		return returnValue;
+	}
+
+	if (comId.empty() || regions.empty())
+	{
+		returnValue.errorMessage = TvServiceBase::ErrorMessage_InvalidInputParameter;
+		return returnValue;
+	}
+
+	::grpc::ClientContext context{};
+
+	context.AddMetadata(ServiceBase::CommunicationIdToken, comId);
+
+	::tvimageservice::ImageUpdateResponse response{};
+
+	const ::grpc::Status status =
+		WriteChunks(m_channel, context, "UpdateImageRegions", EncodeRegionsGrabResultChunks(regions, FrameBuffer::Unowned(pictureData.data(), pictureData.size())), response);
+
+	if (status.ok())
+	{
+		returnValue = CallStatus{CallState::Ok};
+	}
+	else
+	{
+		returnValue.errorMessage = status.error_message();
+	}
+
+	return returnValue;
+}
+
 } // namespace ImageService
 
 } // namespace TVRemoteScreenSDKCommunication
\ No newline at end of file
@@ -27,10 +27,12 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/ImageService/IImageServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "ImageService.grpc.pb.h"
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace TVRemoteScreenSDKCommunication
@@ -45,6 +47,10 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	ImageServicegRPCClient() = default;
+	explicit ImageServicegRPCClient(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~ImageServicegRPCClient() override = default;
 
 	void StartClient(const std::string& destination) override;
@@ -55,6 +61,7 @@ public:
 
 	// rpc call UpdateImage
 	CallStatus UpdateImage(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const std::string& pictureData) override;
+	CallStatus UpdateImageFrame(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const FrameBuffer& pictureData) override;
 
 	// rpc call UpdateImageDefinition
 	CallStatus UpdateImageDefinition(
@@ -66,10 +73,37 @@ public:
 		ColorFormat format,
 		double dpi) override;
 
+	// rpc call AnnounceSharedFrameBuffer
+	CallStatus AnnounceSharedFrameBuffer(const std::string& comId, const std::string& name, uint32_t slotCount, uint64_t slotSize) override;
+
+	// rpc call UpdateImageFromSharedFrameBuffer
+	CallStatus UpdateImageFromSharedFrameBuffer(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, uint32_t slot, uint64_t size) override;
+
+	// rpc call UpdateImageStream
+	CallStatus UpdateImageStream(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const std::string& pictureData) override;
+	CallStatus UpdateImageStreamFrame(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const FrameBuffer& pictureData) override;
+	void StopImageStream() override;
+
+	// rpc call UpdateImageRegions
+	CallStatus UpdateImageRegions(const std::string& comId, const std::vector<ImageRegion>& regions, const std::string& pictureData) override;
+
 private:
+	struct ImageStream;
+
+	std::shared_ptr<ImageStream> AcquireImageStream(const std::string& comId);
+	void ReleaseImageStream(const std::shared_ptr<ImageStream>& stream);
+	void CloseImageStream(bool cancel);
+
+	// unowned picture data is only alive until the call returns, so its frame is awaited
+	CallStatus WriteImageStreamFrame(const std::string& comId, int32_t x, int32_t y, int32_t width, int32_t height, const FrameBuffer& pictureData, bool awaitFrame);
+
 	std::string m_destination;
+	TransportOptions m_transportOptions;
 	std::shared_ptr<::grpc::ChannelInterface> m_channel;
 	std::unique_ptr<::tvimageservice::ImageService::Stub> m_stub;
+
+	std::mutex m_imageStreamMutex;
+	std::shared_ptr<ImageStream> m_imageStream;
 };
 
 } // namespace ImageService
@@ -52,7 +52,10 @@ void InputServiceSocketIOClient::StartClient(const std::string& destination)
 {
 	m_destination = destination;
 
-	m_channel.reset(new Transport::SocketIO::ChannelInterface(m_destination));
+	m_channel.reset(new Transport::SocketIO::ChannelInterface(
+		m_destination,
+		Transport::SocketIO::ConnectionPolicy{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 }
 
 void InputServiceSocketIOClient::StopClient(bool /*force*/)
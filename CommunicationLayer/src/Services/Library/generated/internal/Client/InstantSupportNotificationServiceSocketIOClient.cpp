@@ -44,7 +44,10 @@ void InstantSupportNotificationServiceSocketIOClient::StartClient(const std::str
 {
 	m_destination = destination;
 
-	m_channel.reset(new Transport::SocketIO::ChannelInterface(m_destination));
+	m_channel.reset(new Transport::SocketIO::ChannelInterface(
+		m_destination,
+		Transport::SocketIO::ConnectionPolicy{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 }
 
 void InstantSupportNotificationServiceSocketIOClient::StopClient(bool /*force*/)
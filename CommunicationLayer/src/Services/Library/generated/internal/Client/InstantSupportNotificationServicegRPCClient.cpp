@@ -42,7 +42,7 @@ void InstantSupportNotificationServicegRPCClient::StartClient(const std::string&
 {
 	m_destination = destination;
 
-	m_channel = ::grpc::CreateChannel(m_destination, ::grpc::InsecureChannelCredentials());
+	m_channel = TransportFW::CreateChannel(m_destination, m_transportOptions);
 	m_stub = ::tvinstantsupportservice::InstantSupportNotificationService::NewStub(m_channel);
 }
 
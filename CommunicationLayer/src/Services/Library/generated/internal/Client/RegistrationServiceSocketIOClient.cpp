@@ -50,7 +50,10 @@ void RegistrationServiceSocketIOClient::StartClient(const std::string& destinati
 {
 	m_destination = destination;
 
-	m_channel.reset(new Transport::SocketIO::ChannelInterface(m_destination));
+	m_channel.reset(new Transport::SocketIO::ChannelInterface(
+		m_destination,
+		Transport::SocketIO::ConnectionPolicy{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 }
 
 void RegistrationServiceSocketIOClient::StopClient(bool /*force*/)
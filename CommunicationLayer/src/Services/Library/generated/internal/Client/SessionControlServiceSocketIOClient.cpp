@@ -49,7 +49,10 @@ void SessionControlServiceSocketIOClient::StartClient(const std::string& destina
 {
 	m_destination = destination;
 
-	m_channel.reset(new Transport::SocketIO::ChannelInterface(m_destination));
+	m_channel.reset(new Transport::SocketIO::ChannelInterface(
+		m_destination,
+		Transport::SocketIO::ConnectionPolicy{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 }
 
 void SessionControlServiceSocketIOClient::StopClient(bool /*force*/)
@@ -51,7 +51,10 @@ void SessionStatusServiceSocketIOClient::StartClient(const std::string& destinat
 {
 	m_destination = destination;
 
-	m_channel.reset(new Transport::SocketIO::ChannelInterface(m_destination));
+	m_channel.reset(new Transport::SocketIO::ChannelInterface(
+		m_destination,
+		Transport::SocketIO::ConnectionPolicy{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 }
 
 void SessionStatusServiceSocketIOClient::StopClient(bool /*force*/)
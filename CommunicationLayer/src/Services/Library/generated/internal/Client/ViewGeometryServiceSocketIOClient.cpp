@@ -48,7 +48,10 @@ void ViewGeometryServiceSocketIOClient::StartClient(const std::string& destinati
 {
 	m_destination = destination;
 
-	m_channel.reset(new Transport::SocketIO::ChannelInterface(m_destination));
+	m_channel.reset(new Transport::SocketIO::ChannelInterface(
+		m_destination,
+		Transport::SocketIO::ConnectionPolicy{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 }
 
 void ViewGeometryServiceSocketIOClient::StopClient(bool /*force*/)
@@ -38,6 +38,9 @@ enum Functions : int64_t
 {
 	Function_UpdateImage = 31,
 	Function_UpdateImageDefinition = 32,
+	Function_AnnounceSharedFrameBuffer = 33,
+	Function_UpdateImageFromSharedFrameBuffer = 34,
+	Function_UpdateImageRegions = 35,
 };
 
 } // namespace ImageService
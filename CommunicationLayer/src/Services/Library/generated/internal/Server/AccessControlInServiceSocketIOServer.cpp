@@ -375,7 +375,12 @@ bool AccessControlInServiceSocketIOServer::StartServer(const std::string& locati
 		};
 	}
 
-	m_server.reset(new Server(std::move(functions)));
+	m_server.reset(new Server(
+		std::move(functions),
+		Server::ConnectionMode::Multiplexed,
+		DefaultWorkerThreads,
+		Server::DispatchPolicyMap{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 
 	return m_server->Start(location);
 }
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/AccessControlService/IAccessControlInServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIOTransport.h>
 
 #include <memory>
@@ -44,6 +45,10 @@ public:
 	using TransportFW = Transport::TCPSocket;
 
 	AccessControlInServiceSocketIOServer() = default;
+	explicit AccessControlInServiceSocketIOServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~AccessControlInServiceSocketIOServer() override = default;
 
 	bool StartServer(const std::string& location) override;
@@ -61,6 +66,7 @@ public:
 
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<Transport::SocketIO::Server> m_server;
 
 	ProcessConfirmationReplyRequestCallback m_ConfirmationReplyProcessing;
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/AccessControlService/IAccessControlInServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "AccessControlInService.grpc.pb.h"
@@ -50,6 +51,10 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	AccessControlInServicegRPCServer() = default;
+	explicit AccessControlInServicegRPCServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~AccessControlInServicegRPCServer() override = default;
 
 	bool StartServer(const std::string& location) override;
@@ -80,6 +85,7 @@ public:
 
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<::grpc::Server> m_server;
 
 	ProcessConfirmationReplyRequestCallback m_confirmationReplyProcessing;
@@ -264,7 +264,12 @@ bool AccessControlOutServiceSocketIOServer::StartServer(const std::string& locat
 		};
 	}
 
-	m_server.reset(new Server(std::move(functions)));
+	m_server.reset(new Server(
+		std::move(functions),
+		Server::ConnectionMode::Multiplexed,
+		DefaultWorkerThreads,
+		Server::DispatchPolicyMap{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 
 	return m_server->Start(location);
 }
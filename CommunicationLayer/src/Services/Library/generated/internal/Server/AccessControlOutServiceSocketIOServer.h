@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/AccessControlService/IAccessControlOutServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIOTransport.h>
 
 #include <memory>
@@ -44,6 +45,10 @@ public:
 	using TransportFW = Transport::TCPSocket;
 
 	AccessControlOutServiceSocketIOServer() = default;
+	explicit AccessControlOutServiceSocketIOServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~AccessControlOutServiceSocketIOServer() override = default;
 
 	bool StartServer(const std::string& location) override;
@@ -59,6 +64,7 @@ public:
 
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<Transport::SocketIO::Server> m_server;
 
 	ProcessAskForConfirmationRequestCallback m_AskForConfirmationProcessing;
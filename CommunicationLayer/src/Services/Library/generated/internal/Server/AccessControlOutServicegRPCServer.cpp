@@ -38,18 +38,47 @@ namespace TVRemoteScreenSDKCommunication
 namespace AccessControlService
 {
 
+AccessControlOutServicegRPCServer::~AccessControlOutServicegRPCServer()
+{
+	// a shared host would keep calling into the destroyed instance
+	StopServer(true);
+}
+
 bool AccessControlOutServicegRPCServer::StartServer(const std::string& location)
 {
 	m_location = location;
 
+	// a host shared by the services listening on the location serves the calls asynchronously
+	m_asyncHost = Transport::gRPCAsyncServerHost::Find(m_location);
+	if (m_asyncHost)
+	{
+		using Host = Transport::gRPCAsyncServerHost;
+		if (!m_asyncHost->AddService(::tvaccesscontrolservice::AccessControlOutService::service_full_name(), Host::MethodHandlers{
+			{"AskForConfirmation", Host::MakeUnaryHandler(this, &AccessControlOutServicegRPCServer::AskForConfirmation)},
+			{"NotifyChange", Host::MakeUnaryHandler(this, &AccessControlOutServicegRPCServer::NotifyChange)}
+		}))
+		{
+			m_asyncHost.reset();
+		}
+
+		return m_asyncHost != nullptr;
+	}
+
 	m_server = TransportFW::CreateAndStartSyncServer(m_location,
-		this); // Register this "service" as the instance through which we'll communicate with clients.
+		this, // Register this "service" as the instance through which we'll communicate with clients.
+		m_transportOptions);
 
 	return m_server != nullptr;
 }
 
 void AccessControlOutServicegRPCServer::StopServer(bool /*force*/)
 {
+	if (m_asyncHost)
+	{
+		m_asyncHost->RemoveService(::tvaccesscontrolservice::AccessControlOutService::service_full_name());
+		m_asyncHost.reset();
+	}
+
 	if (m_server)
 	{
 		m_server->Shutdown();
@@ -27,6 +27,8 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/AccessControlService/IAccessControlOutServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCAsyncServerHost.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "AccessControlOutService.grpc.pb.h"
@@ -50,7 +52,11 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	AccessControlOutServicegRPCServer() = default;
-	~AccessControlOutServicegRPCServer() override = default;
+	explicit AccessControlOutServicegRPCServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
+	~AccessControlOutServicegRPCServer() override;
 
 	bool StartServer(const std::string& location) override;
 	void StopServer(bool force) override;
@@ -74,7 +80,9 @@ public:
 
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<::grpc::Server> m_server;
+	std::shared_ptr<Transport::gRPCAsyncServerHost> m_asyncHost;
 
 	ProcessAskForConfirmationRequestCallback m_askForConfirmationProcessing;
 	ProcessNotifyChangeRequestCallback m_notifyChangeProcessing;
@@ -112,7 +112,12 @@ bool AugmentRCSessionConsumerServiceSocketIOServer::StartServer(const std::strin
 		};
 	}
 
-	m_server.reset(new Server(std::move(functions)));
+	m_server.reset(new Server(
+		std::move(functions),
+		Server::ConnectionMode::Multiplexed,
+		DefaultWorkerThreads,
+		Server::DispatchPolicyMap{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 
 	return m_server->Start(location);
 }
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/AugmentRCSessionService/IAugmentRCSessionConsumerServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIOTransport.h>
 
 #include <memory>
@@ -44,6 +45,10 @@ public:
 	using TransportFW = Transport::TCPSocket;
 
 	AugmentRCSessionConsumerServiceSocketIOServer() = default;
+	explicit AugmentRCSessionConsumerServiceSocketIOServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~AugmentRCSessionConsumerServiceSocketIOServer() override = default;
 
 	bool StartServer(const std::string& location) override;
@@ -57,6 +62,7 @@ public:
 
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<Transport::SocketIO::Server> m_server;
 
 	ProcessReceivedInvitationRequestCallback m_ReceivedInvitationProcessing;
@@ -38,18 +38,46 @@ namespace TVRemoteScreenSDKCommunication
 namespace AugmentRCSessionService
 {
 
+AugmentRCSessionConsumerServicegRPCServer::~AugmentRCSessionConsumerServicegRPCServer()
+{
+	// a shared host would keep calling into the destroyed instance
+	StopServer(true);
+}
+
 bool AugmentRCSessionConsumerServicegRPCServer::StartServer(const std::string& location)
 {
 	m_location = location;
 
+	// a host shared by the services listening on the location serves the calls asynchronously
+	m_asyncHost = Transport::gRPCAsyncServerHost::Find(m_location);
+	if (m_asyncHost)
+	{
+		using Host = Transport::gRPCAsyncServerHost;
+		if (!m_asyncHost->AddService(::tvaugmentrcsessionservice::AugmentRCSessionConsumerService::service_full_name(), Host::MethodHandlers{
+			{"ReceivedInvitation", Host::MakeUnaryHandler(this, &AugmentRCSessionConsumerServicegRPCServer::ReceivedInvitation)}
+		}))
+		{
+			m_asyncHost.reset();
+		}
+
+		return m_asyncHost != nullptr;
+	}
+
 	m_server = TransportFW::CreateAndStartSyncServer(m_location,
-		this); // Register this "service" as the instance through which we'll communicate with clients.
+		this, // Register this "service" as the instance through which we'll communicate with clients.
+		m_transportOptions);
 
 	return m_server != nullptr;
 }
 
 void AugmentRCSessionConsumerServicegRPCServer::StopServer(bool /*force*/)
 {
+	if (m_asyncHost)
+	{
+		m_asyncHost->RemoveService(::tvaugmentrcsessionservice::AugmentRCSessionConsumerService::service_full_name());
+		m_asyncHost.reset();
+	}
+
 	if (m_server)
 	{
 		m_server->Shutdown();
@@ -27,6 +27,8 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/AugmentRCSessionService/IAugmentRCSessionConsumerServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCAsyncServerHost.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "AugmentRCSessionConsumerService.grpc.pb.h"
@@ -50,7 +52,11 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	AugmentRCSessionConsumerServicegRPCServer() = default;
-	~AugmentRCSessionConsumerServicegRPCServer() override = default;
+	explicit AugmentRCSessionConsumerServicegRPCServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
+	~AugmentRCSessionConsumerServicegRPCServer() override;
 
 	bool StartServer(const std::string& location) override;
 	void StopServer(bool force) override;
@@ -68,7 +74,9 @@ public:
 
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<::grpc::Server> m_server;
+	std::shared_ptr<Transport::gRPCAsyncServerHost> m_asyncHost;
 
 	ProcessReceivedInvitationRequestCallback m_receivedInvitationProcessing;
 };
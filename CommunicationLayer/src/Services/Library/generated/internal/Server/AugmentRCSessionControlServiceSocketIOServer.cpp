@@ -259,7 +259,12 @@ bool AugmentRCSessionControlServiceSocketIOServer::StartServer(const std::string
 		};
 	}
 
-	m_server.reset(new Server(std::move(functions)));
+	m_server.reset(new Server(
+		std::move(functions),
+		Server::ConnectionMode::Multiplexed,
+		DefaultWorkerThreads,
+		Server::DispatchPolicyMap{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 
 	return m_server->Start(location);
 }
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/AugmentRCSessionService/IAugmentRCSessionControlServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIOTransport.h>
 
 #include <memory>
@@ -44,6 +45,10 @@ public:
 	using TransportFW = Transport::TCPSocket;
 
 	AugmentRCSessionControlServiceSocketIOServer() = default;
+	explicit AugmentRCSessionControlServiceSocketIOServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~AugmentRCSessionControlServiceSocketIOServer() override = default;
 
 	bool StartServer(const std::string& location) override;
@@ -61,6 +66,7 @@ public:
 
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<Transport::SocketIO::Server> m_server;
 
 	ProcessStartListeningRequestCallback m_StartListeningProcessing;
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/AugmentRCSessionService/IAugmentRCSessionControlServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "AugmentRCSessionControlService.grpc.pb.h"
@@ -50,6 +51,10 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	AugmentRCSessionControlServicegRPCServer() = default;
+	explicit AugmentRCSessionControlServicegRPCServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~AugmentRCSessionControlServicegRPCServer() override = default;
 
 	bool StartServer(const std::string& location) override;
@@ -80,6 +85,7 @@ public:
 
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<::grpc::Server> m_server;
 
 	ProcessStartListeningRequestCallback m_startListeningProcessing;
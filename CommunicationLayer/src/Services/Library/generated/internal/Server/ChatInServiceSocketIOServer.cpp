@@ -489,7 +489,12 @@ bool ChatInServiceSocketIOServer::StartServer(const std::string& location)
 		};
 	}
 
-	m_server.reset(new Server(std::move(functions)));
+	m_server.reset(new Server(
+		std::move(functions),
+		Server::ConnectionMode::Multiplexed,
+		DefaultWorkerThreads,
+		Server::DispatchPolicyMap{},
+		TransportFW::MakeSocketOptions(m_transportOptions)));
 
 	return m_server->Start(location);
 }
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/ChatService/IChatInServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIOTransport.h>
 
 #include <memory>
@@ -44,6 +45,10 @@ public:
 	using TransportFW = Transport::TCPSocket;
 
 	ChatInServiceSocketIOServer() = default;
+	explicit ChatInServiceSocketIOServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~ChatInServiceSocketIOServer() override = default;
 
 	bool StartServer(const std::string& location) override;
@@ -67,6 +72,7 @@ public:
 
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<Transport::SocketIO::Server> m_server;
 
 	ProcessObtainChatsRequestCallback m_ObtainChatsProcessing;
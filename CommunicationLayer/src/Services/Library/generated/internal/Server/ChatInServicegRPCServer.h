@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/ChatService/IChatInServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "ChatInService.grpc.pb.h"
@@ -50,6 +51,10 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	ChatInServicegRPCServer() = default;
+	explicit ChatInServicegRPCServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~ChatInServicegRPCServer() override = default;
 
 	bool StartServer(const std::string& location) override;
@@ -98,6 +103,7 @@ public:
 
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<::grpc::Server> m_server;
 
 	ProcessObtainChatsRequestCallback m_obtainChatsProcessing;
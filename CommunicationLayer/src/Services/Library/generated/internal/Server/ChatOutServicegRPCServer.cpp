@@ -38,18 +38,53 @@ namespace TVRemoteScreenSDKCommunication
 namespace ChatService
 {
 
+ChatOutServicegRPCServer::~ChatOutServicegRPCServer()
+{
+	// a shared host would keep calling into the destroyed instance
+	StopServer(true);
+}
+
 bool ChatOutServicegRPCServer::StartServer(const std::string& location)
 {
 	m_location = location;
 
+	// a host shared by the services listening on the location serves the calls asynchronously
+	m_asyncHost = Transport::gRPCAsyncServerHost::Find(m_location);
+	if (m_asyncHost)
+	{
+		using Host = Transport::gRPCAsyncServerHost;
+		if (!m_asyncHost->AddService(::tvchatservice::ChatOutService::service_full_name(), Host::MethodHandlers{
+			{"ChatCreated", Host::MakeUnaryHandler(this, &ChatOutServicegRPCServer::ChatCreated)},
+			{"ChatsRemoved", Host::MakeUnaryHandler(this, &ChatOutServicegRPCServer::ChatsRemoved)},
+			{"ReceivedMessages", Host::MakeUnaryHandler(this, &ChatOutServicegRPCServer::ReceivedMessages)},
+			{"MessageSent", Host::MakeUnaryHandler(this, &ChatOutServicegRPCServer::MessageSent)},
+			{"MessageNotSent", Host::MakeUnaryHandler(this, &ChatOutServicegRPCServer::MessageNotSent)},
+			{"LoadedMessages", Host::MakeUnaryHandler(this, &ChatOutServicegRPCServer::LoadedMessages)},
+			{"DeletedHistory", Host::MakeUnaryHandler(this, &ChatOutServicegRPCServer::DeletedHistory)},
+			{"ClosedChat", Host::MakeUnaryHandler(this, &ChatOutServicegRPCServer::ClosedChat)}
+		}))
+		{
+			m_asyncHost.reset();
+		}
+
+		return m_asyncHost != nullptr;
+	}
+
 	m_server = TransportFW::CreateAndStartSyncServer(m_location,
-		this); // Register this "service" as the instance through which we'll communicate with clients.
+		this, // Register this "service" as the instance through which we'll communicate with clients.
+		m_transportOptions);
 
 	return m_server != nullptr;
 }
 
 void ChatOutServicegRPCServer::StopServer(bool /*force*/)
 {
+	if (m_asyncHost)
+	{
+		m_asyncHost->RemoveService(::tvchatservice::ChatOutService::service_full_name());
+		m_asyncHost.reset();
+	}
+
 	if (m_server)
 	{
 		m_server->Shutdown();
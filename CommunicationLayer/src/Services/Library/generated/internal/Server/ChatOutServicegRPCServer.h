@@ -27,6 +27,8 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/ChatService/IChatOutServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCAsyncServerHost.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "ChatOutService.grpc.pb.h"
@@ -50,7 +52,11 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	ChatOutServicegRPCServer() = default;
-	~ChatOutServicegRPCServer() override = default;
+	explicit ChatOutServicegRPCServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
+	~ChatOutServicegRPCServer() override;
 
 	bool StartServer(const std::string& location) override;
 	void StopServer(bool force) override;
@@ -110,7 +116,9 @@ public:
 
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<::grpc::Server> m_server;
+	std::shared_ptr<Transport::gRPCAsyncServerHost> m_asyncHost;
 
 	ProcessChatCreatedRequestCallback m_chatCreatedProcessing;
 	ProcessChatsRemovedRequestCallback m_chatsRemovedProcessing;
@@ -38,18 +38,46 @@ namespace TVRemoteScreenSDKCommunication
 namespace ConnectionConfirmationService
 {
 
+ConnectionConfirmationRequestServicegRPCServer::~ConnectionConfirmationRequestServicegRPCServer()
+{
+	// a shared host would keep calling into the destroyed instance
+	StopServer(true);
+}
+
 bool ConnectionConfirmationRequestServicegRPCServer::StartServer(const std::string& location)
 {
 	m_location = location;
 
+	// a host shared by the services listening on the location serves the calls asynchronously
+	m_asyncHost = Transport::gRPCAsyncServerHost::Find(m_location);
+	if (m_asyncHost)
+	{
+		using Host = Transport::gRPCAsyncServerHost;
+		if (!m_asyncHost->AddService(::tvconnectionconfirmationservice::ConnectionConfirmationRequestService::service_full_name(), Host::MethodHandlers{
+			{"RequestConnectionConfirmation", Host::MakeUnaryHandler(this, &ConnectionConfirmationRequestServicegRPCServer::RequestConnectionConfirmation)}
+		}))
+		{
+			m_asyncHost.reset();
+		}
+
+		return m_asyncHost != nullptr;
+	}
+
 	m_server = TransportFW::CreateAndStartSyncServer(m_location,
-		this); // Register this "service" as the instance through which we'll communicate with clients.
+		this, // Register this "service" as the instance through which we'll communicate with clients.
+		m_transportOptions);
 
 	return m_server != nullptr;
 }
 
 void ConnectionConfirmationRequestServicegRPCServer::StopServer(bool /*force*/)
 {
+	if (m_asyncHost)
+	{
+		m_asyncHost->RemoveService(::tvconnectionconfirmationservice::ConnectionConfirmationRequestService::service_full_name());
+		m_asyncHost.reset();
+	}
+
 	if (m_server)
 	{
 		m_server->Shutdown();
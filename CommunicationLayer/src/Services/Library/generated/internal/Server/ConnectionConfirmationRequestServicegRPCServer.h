@@ -27,6 +27,8 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/ConnectionConfirmationService/IConnectionConfirmationRequestServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCAsyncServerHost.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "ConnectionConfirmationRequestService.grpc.pb.h"
@@ -50,7 +52,11 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	ConnectionConfirmationRequestServicegRPCServer() = default;
-	~ConnectionConfirmationRequestServicegRPCServer() override = default;
+	explicit ConnectionConfirmationRequestServicegRPCServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
+	~ConnectionConfirmationRequestServicegRPCServer() override;
 
 	bool StartServer(const std::string& location) override;
 	void StopServer(bool force) override;
@@ -69,7 +75,9 @@ public:
 
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<::grpc::Server> m_server;
+	std::shared_ptr<Transport::gRPCAsyncServerHost> m_asyncHost;
 
 	ProcessRequestConnectionConfirmationRequestCallback m_requestConnectionConfirmationProcessing;
 };
@@ -43,7 +43,8 @@ bool ConnectionConfirmationResponseServicegRPCServer::StartServer(const std::str
 	m_location = location;
 
 	m_server = TransportFW::CreateAndStartSyncServer(m_location,
-		this); // Register this "service" as the instance through which we'll communicate with clients.
+		this, // Register this "service" as the instance through which we'll communicate with clients.
+		m_transportOptions);
 
 	return m_server != nullptr;
 }
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/ConnectionConfirmationService/IConnectionConfirmationResponseServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "ConnectionConfirmationResponseService.grpc.pb.h"
@@ -50,6 +51,10 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	ConnectionConfirmationResponseServicegRPCServer() = default;
+	explicit ConnectionConfirmationResponseServicegRPCServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~ConnectionConfirmationResponseServicegRPCServer() override = default;
 
 	bool StartServer(const std::string& location) override;
@@ -68,6 +73,7 @@ public:
 
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<::grpc::Server> m_server;
 
 	ProcessConfirmConnectionRequestRequestCallback m_confirmConnectionRequestProcessing;
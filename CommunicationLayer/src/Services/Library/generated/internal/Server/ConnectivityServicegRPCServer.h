@@ -27,6 +27,8 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/ConnectivityService/IConnectivityServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCAsyncServerHost.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "ConnectivityService.grpc.pb.h"
@@ -50,7 +52,11 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	ConnectivityServicegRPCServer() = default;
-	~ConnectivityServicegRPCServer() override = default;
+	explicit ConnectivityServicegRPCServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
+	~ConnectivityServicegRPCServer() override;
 
 	bool StartServer(const std::string& location) override;
 	void StopServer(bool force) override;
@@ -74,7 +80,9 @@ public:
 
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<::grpc::Server> m_server;
+	std::shared_ptr<Transport::gRPCAsyncServerHost> m_asyncHost;
 
 	ProcessIsAvailableRequestCallback m_isAvailableProcessing;
 	ProcessDisconnectRequestCallback m_disconnectProcessing;
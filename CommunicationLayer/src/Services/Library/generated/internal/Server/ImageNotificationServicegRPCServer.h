@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/ImageNotificationService/IImageNotificationServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "ImageNotificationService.grpc.pb.h"
@@ -50,6 +51,10 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	ImageNotificationServicegRPCServer() = default;
+	explicit ImageNotificationServicegRPCServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~ImageNotificationServicegRPCServer() override = default;
 
 	bool StartServer(const std::string& location) override;
@@ -74,6 +79,7 @@ public:
 
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<::grpc::Server> m_server;
 
 	ProcessUpdateImageDefinitionRequestCallback m_updateImageDefinitionProcessing;
@@ -27,6 +27,7 @@
 
 #include "ImageServiceSocketIOServer.h"
 
+#include <TVRemoteScreenSDKCommunication/ImageService/GrabResultLimits.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/RequestMetadata.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/ServiceErrorMessage.h>
 
@@ -37,6 +38,12 @@
 #include "ImageDefinitionRequest.pb.h"
 #include "ImageDefinitionResponse.pb.h"
 #include "ImageUpdateResponse.pb.h"
+#include "RegionsGrabResult.pb.h"
+#include "SharedFrameBufferRequest.pb.h"
+#include "SharedFrameBufferResponse.pb.h"
+#include "SharedFrameUpdate.pb.h"
+
+#include <algorithm>
 
 namespace TVRemoteScreenSDKCommunication
 {
@@ -44,6 +51,296 @@ namespace TVRemoteScreenSDKCommunication
 namespace ImageService
 {
 
+namespace
+{
+
+// Receives the GrabResult messages of a streamed image update as they arrive. The chunks are
+// handed to the frame sink if set, joined for the request processing otherwise.
+class UpdateImageStream final : public Transport::SocketIO::Server::Stream
+{
+public:
+	using Status = Transport::SocketIO::Status;
+	using StatusCode = Transport::SocketIO::StatusCode;
+
+	UpdateImageStream(std::string comId,
+		std::shared_ptr<IImageFrameSink> frameSink,
+		const IImageServiceServer::ProcessUpdateImageRequestCallback& requestProcessing)
+		: m_comId(std::move(comId))
+		, m_frameSink(std::move(frameSink))
+		, m_requestProcessing(requestProcessing)
+	{
+	}
+
+	Status Read(std::string& frame) override
+	{
+		if (!m_message.ParseFromString(frame))
+		{
+			return Status(StatusCode::IO_ERROR, "error parsing request");
+		}
+		frame.clear();
+
+		std::string& chunk = *m_message.mutable_pixeldata()->mutable_picture();
+
+		if (m_receivedChunks == 0)
+		{
+			if (!m_requestProcessing && !m_frameSink)
+			{
+				return Status{StatusCode::UNAVAILABLE, TvServiceBase::ErrorMessage_NoProcessingCallback};
+			}
+
+			if (m_comId.empty())
+			{
+				return Status{StatusCode::FAILED_PRECONDITION, TvServiceBase::ErrorMessage_NoComId};
+			}
+
+			m_chunks = std::max<uint32_t>(m_message.chunks(), 1);
+
+			// all chunks but the last one have the size of the first
+			const size_t pictureSizeHint = std::min<uint64_t>(static_cast<uint64_t>(chunk.size()) * m_chunks, MaxPictureSizeHint);
+
+			const ::tvimageservice::Rect& dirtyRect = m_message.dirtyrect();
+			m_x = dirtyRect.x();
+			m_y = dirtyRect.y();
+			m_width = dirtyRect.width();
+			m_height = dirtyRect.height();
+
+			if (m_frameSink)
+			{
+				m_frame = m_frameSink->BeginFrame(m_comId, m_x, m_y, m_width, m_height, m_chunks, pictureSizeHint);
+				if (!m_frame)
+				{
+					return Status{StatusCode::UNAVAILABLE, TvServiceBase::ErrorMessage_FrameRejected};
+				}
+			}
+			else
+			{
+				m_pictureData.reserve(pictureSizeHint);
+			}
+		}
+		else if (m_receivedChunks == m_chunks)
+		{
+			return Status{StatusCode::ABORTED, "More chunks received than announced"};
+		}
+		++m_receivedChunks;
+
+		if (m_frame)
+		{
+			m_frame->AddChunk(chunk);
+		}
+		else
+		{
+			m_pictureData.append(chunk);
+		}
+
+		m_message.Clear();
+		return Status::OK;
+	}
+
+	Status Finish(std::string& responseRaw) override
+	{
+		if (m_receivedChunks < m_chunks)
+		{
+			Cancel();
+			return Status{StatusCode::ABORTED, "Reading chunks failed"};
+		}
+
+		Status returnStatus{StatusCode::CANCELLED, TvServiceBase::ErrorMessage_ResponseCallbackNotCalled};
+
+		auto responseProcessing = [&returnStatus](const CallStatus& callStatus)
+		{
+			if (callStatus.IsOk())
+			{
+				returnStatus = Status::OK;
+			}
+			else
+			{
+				returnStatus = Status{StatusCode::ABORTED, callStatus.errorMessage};
+			}
+		};
+
+		if (m_frame)
+		{
+			const std::unique_ptr<IImageFrame> frame = std::move(m_frame);
+			frame->End(responseProcessing);
+		}
+		else if (!m_requestProcessing)
+		{
+			return Status{StatusCode::UNAVAILABLE, TvServiceBase::ErrorMessage_NoProcessingCallback};
+		}
+		else
+		{
+			m_requestProcessing(m_comId, m_x, m_y, m_width, m_height, m_pictureData, responseProcessing);
+		}
+
+		if (!returnStatus.ok())
+		{
+			return returnStatus;
+		}
+
+		::tvimageservice::ImageUpdateResponse response;
+		if (!response.SerializeToString(&responseRaw))
+		{
+			return Status(StatusCode::IO_ERROR, "response serialization failed");
+		}
+
+		return returnStatus;
+	}
+
+	void Cancel() override
+	{
+		if (m_frame)
+		{
+			const std::unique_ptr<IImageFrame> frame = std::move(m_frame);
+			frame->Abort();
+		}
+	}
+
+private:
+	const std::string m_comId;
+	const std::shared_ptr<IImageFrameSink> m_frameSink;
+	const IImageServiceServer::ProcessUpdateImageRequestCallback& m_requestProcessing;
+
+	::tvimageservice::GrabResult m_message;
+	std::string m_pictureData;
+
+	uint32_t m_chunks = 1;
+	uint32_t m_receivedChunks = 0;
+	std::unique_ptr<IImageFrame> m_frame; // of the frame sink, until the frame has ended
+
+	int32_t m_x = 0;
+	int32_t m_y = 0;
+	int32_t m_width = 0;
+	int32_t m_height = 0;
+};
+
+// Receives the RegionsGrabResult messages of a multi-region image update and joins their chunks.
+// An update sent in a single call is read the same way as a stream of one message.
+class UpdateImageRegionsStream final : public Transport::SocketIO::Server::Stream
+{
+public:
+	using Status = Transport::SocketIO::Status;
+	using StatusCode = Transport::SocketIO::StatusCode;
+
+	UpdateImageRegionsStream(std::string comId, const IImageServiceServer::ProcessUpdateImageRegionsRequestCallback& requestProcessing)
+		: m_comId(std::move(comId))
+		, m_requestProcessing(requestProcessing)
+	{
+	}
+
+	Status Read(std::string& frame) override
+	{
+		if (!m_message.ParseFromString(frame))
+		{
+			return Status(StatusCode::IO_ERROR, "error parsing request");
+		}
+		frame.clear();
+
+		const std::string& chunk = m_message.pixeldata().picture();
+
+		if (m_receivedChunks == 0)
+		{
+			if (!m_requestProcessing)
+			{
+				return Status{StatusCode::UNAVAILABLE, TvServiceBase::ErrorMessage_NoProcessingCallback};
+			}
+
+			if (m_comId.empty())
+			{
+				return Status{StatusCode::FAILED_PRECONDITION, TvServiceBase::ErrorMessage_NoComId};
+			}
+
+			m_chunks = std::max<uint32_t>(m_message.chunks(), 1);
+
+			m_regions.reserve(m_message.regions_size());
+			for (const ::tvimageservice::Rect& rect : m_message.regions())
+			{
+				ImageRegion region;
+				region.x = rect.x();
+				region.y = rect.y();
+				region.width = rect.width();
+				region.height = rect.height();
+				m_regions.push_back(region);
+			}
+
+			if (m_chunks == 1)
+			{
+				m_pictureData.swap(*m_message.mutable_pixeldata()->mutable_picture());
+			}
+			else
+			{
+				m_pictureData.reserve(std::min<uint64_t>(static_cast<uint64_t>(chunk.size()) * m_chunks, MaxPictureSizeHint));
+			}
+		}
+		else if (m_receivedChunks == m_chunks)
+		{
+			return Status{StatusCode::ABORTED, "More chunks received than announced"};
+		}
+		++m_receivedChunks;
+
+		if (m_chunks > 1)
+		{
+			m_pictureData.append(chunk);
+		}
+
+		m_message.Clear();
+		return Status::OK;
+	}
+
+	Status Finish(std::string& responseRaw) override
+	{
+		if (m_receivedChunks < m_chunks)
+		{
+			return Status{StatusCode::ABORTED, "Reading chunks failed"};
+		}
+
+		Status returnStatus{StatusCode::CANCELLED, TvServiceBase::ErrorMessage_ResponseCallbackNotCalled};
+
+		auto responseProcessing = [&returnStatus](const CallStatus& callStatus)
+		{
+			if (callStatus.IsOk())
+			{
+				returnStatus = Status::OK;
+			}
+			else
+			{
+				returnStatus = Status{StatusCode::ABORTED, callStatus.errorMessage};
+			}
+		};
+
+		m_requestProcessing(m_comId, m_regions, m_pictureData, responseProcessing);
+
+		if (!returnStatus.ok())
+		{
+			return returnStatus;
+		}
+
+		::tvimageservice::ImageUpdateResponse response;
+		if (!response.SerializeToString(&responseRaw))
+		{
+			return Status(StatusCode::IO_ERROR, "response serialization failed");
+		}
+
+		return returnStatus;
+	}
+
+	void Cancel() override
+	{
+	}
+
+private:
+	const std::string m_comId;
+	const IImageServiceServer::ProcessUpdateImageRegionsRequestCallback& m_requestProcessing;
+
+	::tvimageservice::RegionsGrabResult m_message;
+	std::vector<ImageRegion> m_regions;
+	std::string m_pictureData;
+
+	uint32_t m_chunks = 1;
+	uint32_t m_receivedChunks = 0;
+};
+
+} // namespace
+
 bool ImageServiceSocketIOServer::StartServer(const std::string& location)
 {
 	using namespace Transport::SocketIO;
@@ -52,11 +349,12 @@ bool ImageServiceSocketIOServer::StartServer(const std::string& location)
 	Server::ServerFunctionMap functions;
 	{
 		auto* requestProcessing = &m_UpdateImageProcessing;
-		functions[Function_UpdateImage] = [requestProcessing](const std::string& comIdValue,
+		auto* frameSink = &m_UpdateImageFrameSink;
+		functions[Function_UpdateImage] = [requestProcessing, frameSink](const std::string& comIdValue,
 											  std::shared_ptr<std::string> requestRaw,
 											  std::shared_ptr<std::string> responseRaw)
 		{
-			if (!*requestProcessing)
+			if (!*requestProcessing && !*frameSink)
 			{
 				return Status{StatusCode::UNAVAILABLE, TvServiceBase::ErrorMessage_NoProcessingCallback};
 			}
@@ -105,6 +403,19 @@ bool ImageServiceSocketIOServer::StartServer(const std::string& location)
 				pictureData.swap(*request.mutable_pixeldata()->mutable_picture());
 				request.Clear();
 
+				// the picture arrives in one message here, so the sink gets it as a single chunk
+				if (const std::shared_ptr<IImageFrameSink> sink = *frameSink)
+				{
+					const std::unique_ptr<IImageFrame> frame = sink->BeginFrame(comId, x, y, width, height, 1, pictureData.size());
+					if (!frame)
+					{
+						return Status{StatusCode::UNAVAILABLE, TvServiceBase::ErrorMessage_FrameRejected};
+					}
+					frame->AddChunk(pictureData);
+					frame->End(responseProcessing);
+					return returnStatus;
+				}
+
 				m_updateImageProcessing(comId, x, y, width, height, pictureData, responseProcessing);
 
 				return returnStatus;
@@ -220,7 +531,187 @@ bool ImageServiceSocketIOServer::StartServer(const std::string& location)
 		};
 	}
 
-	m_server.reset(new Server(std::move(functions)));
+	{
+		auto* requestProcessing = &m_AnnounceSharedFrameBufferProcessing;
+		functions[Function_AnnounceSharedFrameBuffer] = [requestProcessing](const std::string& comIdValue,
+			std::shared_ptr<std::string> requestRaw,
+			std::shared_ptr<std::string> responseRaw)
+		{
+			if (!*requestProcessing)
+			{
+				return Status{StatusCode::UNAVAILABLE, TvServiceBase::ErrorMessage_NoProcessingCallback};
+			}
+			::tvimageservice::SharedFrameBufferRequest request;
+			if (!request.ParseFromString(*requestRaw))
+			{
+				return Status(StatusCode::IO_ERROR, "error parsing request");
+			}
+
+			requestRaw->clear();
+
+			::tvimageservice::SharedFrameBufferResponse response;
+
+			Status status = [&]()
+			{
+				std::string comId = comIdValue;
+
+				if (comIdValue.empty())
+				{
+					return Status{StatusCode::FAILED_PRECONDITION, TvServiceBase::ErrorMessage_NoComId};
+				}
+
+				Status returnStatus{StatusCode::CANCELLED, TvServiceBase::ErrorMessage_ResponseCallbackNotCalled};
+
+				auto responseProcessing = [&returnStatus](const CallStatus& callStatus)
+				{
+					if (callStatus.IsOk())
+					{
+						returnStatus = Status::OK;
+					}
+					else
+					{
+						returnStatus = Status{StatusCode::ABORTED, callStatus.errorMessage};
+					}
+				};
+
+				auto& m_announceSharedFrameBufferProcessing = *requestProcessing;
+
+				m_announceSharedFrameBufferProcessing(comId,
+					request.name(),
+
+					request.slotcount(),
+
+					request.slotsize(),
+
+					responseProcessing);
+
+				return returnStatus;
+			}();
+			if (!status.ok())
+			{
+				return status;
+			}
+
+			if (!response.SerializeToString(responseRaw.get()))
+			{
+				return Status(StatusCode::IO_ERROR, "response serialization failed");
+			}
+
+			return status;
+		};
+	}
+
+	{
+		auto* requestProcessing = &m_UpdateImageFromSharedFrameBufferProcessing;
+		functions[Function_UpdateImageFromSharedFrameBuffer] = [requestProcessing](const std::string& comIdValue,
+			std::shared_ptr<std::string> requestRaw,
+			std::shared_ptr<std::string> responseRaw)
+		{
+			if (!*requestProcessing)
+			{
+				return Status{StatusCode::UNAVAILABLE, TvServiceBase::ErrorMessage_NoProcessingCallback};
+			}
+			::tvimageservice::SharedFrameUpdate request;
+			if (!request.ParseFromString(*requestRaw))
+			{
+				return Status(StatusCode::IO_ERROR, "error parsing request");
+			}
+
+			requestRaw->clear();
+
+			::tvimageservice::ImageUpdateResponse response;
+
+			Status status = [&]()
+			{
+				std::string comId = comIdValue;
+
+				if (comIdValue.empty())
+				{
+					return Status{StatusCode::FAILED_PRECONDITION, TvServiceBase::ErrorMessage_NoComId};
+				}
+
+				Status returnStatus{StatusCode::CANCELLED, TvServiceBase::ErrorMessage_ResponseCallbackNotCalled};
+
+				auto responseProcessing = [&returnStatus](const CallStatus& callStatus)
+				{
+					if (callStatus.IsOk())
+					{
+						returnStatus = Status::OK;
+					}
+					else
+					{
+						returnStatus = Status{StatusCode::ABORTED, callStatus.errorMessage};
+					}
+				};
+
+				auto& m_updateImageFromSharedFrameBufferProcessing = *requestProcessing;
+
+				const ::tvimageservice::Rect& dirtyRect = request.dirtyrect();
+				const int32_t x = dirtyRect.x();
+				const int32_t y = dirtyRect.y();
+				const int32_t width = dirtyRect.width();
+				const int32_t height = dirtyRect.height();
+
+				m_updateImageFromSharedFrameBufferProcessing(comId, x, y, width, height, request.slot(), request.size(), responseProcessing);
+
+				return returnStatus;
+			}();
+			if (!status.ok())
+			{
+				return status;
+			}
+
+			if (!response.SerializeToString(responseRaw.get()))
+			{
+				return Status(StatusCode::IO_ERROR, "response serialization failed");
+			}
+
+			return status;
+		};
+	}
+
+	{
+		auto* requestProcessing = &m_UpdateImageRegionsProcessing;
+		functions[Function_UpdateImageRegions] = [requestProcessing](const std::string& comIdValue,
+													 std::shared_ptr<std::string> requestRaw,
+													 std::shared_ptr<std::string> responseRaw)
+		{
+			UpdateImageRegionsStream request{comIdValue, *requestProcessing};
+			const Status status = request.Read(*requestRaw);
+			if (!status.ok())
+			{
+				return status;
+			}
+			return request.Finish(*responseRaw);
+		};
+	}
+
+	// pictures larger than one chunk are streamed
+	Server::StreamFunctionMap streamFunctions;
+	{
+		auto* requestProcessing = &m_UpdateImageProcessing;
+		auto* frameSink = &m_UpdateImageFrameSink;
+		streamFunctions[Function_UpdateImage] = [requestProcessing, frameSink](const std::string& comId)
+			-> std::unique_ptr<Server::Stream>
+		{
+			return std::unique_ptr<Server::Stream>{new UpdateImageStream{comId, *frameSink, *requestProcessing}};
+		};
+	}
+	{
+		auto* requestProcessing = &m_UpdateImageRegionsProcessing;
+		streamFunctions[Function_UpdateImageRegions] = [requestProcessing](const std::string& comId) -> std::unique_ptr<Server::Stream>
+		{
+			return std::unique_ptr<Server::Stream>{new UpdateImageRegionsStream{comId, *requestProcessing}};
+		};
+	}
+
+	m_server.reset(new Server(
+		std::move(functions),
+		Server::ConnectionMode::Multiplexed,
+		DefaultWorkerThreads,
+		Server::DispatchPolicyMap{},
+		TransportFW::MakeSocketOptions(m_transportOptions),
+		std::move(streamFunctions)));
 
 	return m_server->Start(location);
 }
@@ -249,11 +740,31 @@ void ImageServiceSocketIOServer::SetUpdateImageCallback(const ProcessUpdateImage
 	m_UpdateImageProcessing = requestProcessing;
 }
 
+void ImageServiceSocketIOServer::SetUpdateImageFrameSink(const std::shared_ptr<IImageFrameSink>& frameSink)
+{
+	m_UpdateImageFrameSink = frameSink;
+}
+
 void ImageServiceSocketIOServer::SetUpdateImageDefinitionCallback(const ProcessUpdateImageDefinitionRequestCallback& requestProcessing)
 {
 	m_UpdateImageDefinitionProcessing = requestProcessing;
 }
 
+void ImageServiceSocketIOServer::SetAnnounceSharedFrameBufferCallback(const ProcessAnnounceSharedFrameBufferRequestCallback& requestProcessing)
+{
+	m_AnnounceSharedFrameBufferProcessing = requestProcessing;
+}
+
+void ImageServiceSocketIOServer::SetUpdateImageFromSharedFrameBufferCallback(const ProcessUpdateImageFromSharedFrameBufferRequestCallback& requestProcessing)
+{
+	m_UpdateImageFromSharedFrameBufferProcessing = requestProcessing;
+}
+
+void ImageServiceSocketIOServer::SetUpdateImageRegionsCallback(const ProcessUpdateImageRegionsRequestCallback& requestProcessing)
+{
+	m_UpdateImageRegionsProcessing = requestProcessing;
+}
+
 } // namespace ImageService
 
 } // namespace TVRemoteScreenSDKCommunication
\ No newline at end of file
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/ImageService/IImageServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIOTransport.h>
 
 #include <memory>
@@ -44,6 +45,10 @@ public:
 	using TransportFW = Transport::TCPSocket;
 
 	ImageServiceSocketIOServer() = default;
+	explicit ImageServiceSocketIOServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~ImageServiceSocketIOServer() override = default;
 
 	bool StartServer(const std::string& location) override;
@@ -55,14 +60,27 @@ public:
 	// public interface impl
 	void SetUpdateImageCallback(const ProcessUpdateImageRequestCallback& requestProcessing) override;
 
+	void SetUpdateImageFrameSink(const std::shared_ptr<IImageFrameSink>& frameSink) override;
+
 	void SetUpdateImageDefinitionCallback(const ProcessUpdateImageDefinitionRequestCallback& requestProcessing) override;
 
+	void SetAnnounceSharedFrameBufferCallback(const ProcessAnnounceSharedFrameBufferRequestCallback& requestProcessing) override;
+
+	void SetUpdateImageFromSharedFrameBufferCallback(const ProcessUpdateImageFromSharedFrameBufferRequestCallback& requestProcessing) override;
+
+	void SetUpdateImageRegionsCallback(const ProcessUpdateImageRegionsRequestCallback& requestProcessing) override;
+
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<Transport::SocketIO::Server> m_server;
 
 	ProcessUpdateImageRequestCallback m_UpdateImageProcessing;
+	std::shared_ptr<IImageFrameSink> m_UpdateImageFrameSink;
 	ProcessUpdateImageDefinitionRequestCallback m_UpdateImageDefinitionProcessing;
+	ProcessAnnounceSharedFrameBufferRequestCallback m_AnnounceSharedFrameBufferProcessing;
+	ProcessUpdateImageFromSharedFrameBufferRequestCallback m_UpdateImageFromSharedFrameBufferProcessing;
+	ProcessUpdateImageRegionsRequestCallback m_UpdateImageRegionsProcessing;
 };
 
 } // namespace ImageService
@@ -27,23 +27,222 @@
 
 #include "ImageServicegRPCServer.h"
 
+#include <TVRemoteScreenSDKCommunication/ImageService/GrabResultLimits.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/RequestMetadata.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/ServiceErrorMessage.h>
 
 #include <grpc++/grpc++.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace TVRemoteScreenSDKCommunication
 {
 
 namespace ImageService
 {
 
+namespace
+{
+
+enum class ReadGrabResultOutcome
+{
+	Complete,
+	NoMessage,
+	MissingChunks,
+	// read completely, but the frame sink did not begin a frame for it
+	Rejected
+};
+
+// Joins the chunks into one picture, reserving the size announced by the first chunk.
+// Kept across the frames of a stream, so the picture buffer is reused.
+struct JoinedPicture
+{
+	void Begin(uint32_t chunks, size_t pictureSizeHint)
+	{
+		singleChunk = chunks <= 1;
+		pictureData.clear();
+		if (!singleChunk)
+		{
+			pictureData.reserve(pictureSizeHint);
+		}
+	}
+
+	void Add(std::string& chunk)
+	{
+		if (singleChunk)
+		{
+			pictureData.swap(chunk);
+		}
+		else
+		{
+			pictureData.append(chunk);
+		}
+	}
+
+	void Abort()
+	{
+	}
+
+	std::string pictureData;
+	bool singleChunk = true;
+};
+
+struct JoinedFrame : JoinedPicture
+{
+	void Begin(const ::tvimageservice::GrabResult& message, uint32_t chunks, size_t pictureSizeHint)
+	{
+		const ::tvimageservice::Rect& dirtyRect = message.dirtyrect();
+		x = dirtyRect.x();
+		y = dirtyRect.y();
+		width = dirtyRect.width();
+		height = dirtyRect.height();
+
+		JoinedPicture::Begin(chunks, pictureSizeHint);
+	}
+
+	int32_t x = 0;
+	int32_t y = 0;
+	int32_t width = 0;
+	int32_t height = 0;
+};
+
+struct RegionsFrame : JoinedPicture
+{
+	void Begin(const ::tvimageservice::RegionsGrabResult& message, uint32_t chunks, size_t pictureSizeHint)
+	{
+		regions.clear();
+		regions.reserve(message.regions_size());
+		for (const ::tvimageservice::Rect& rect : message.regions())
+		{
+			ImageRegion region;
+			region.x = rect.x();
+			region.y = rect.y();
+			region.width = rect.width();
+			region.height = rect.height();
+			regions.push_back(region);
+		}
+
+		JoinedPicture::Begin(chunks, pictureSizeHint);
+	}
+
+	std::vector<ImageRegion> regions;
+};
+
+// Hands the chunks to a frame sink as they are read.
+struct SinkFrame
+{
+	void Begin(const ::tvimageservice::GrabResult& message, uint32_t chunks, size_t pictureSizeHint)
+	{
+		const ::tvimageservice::Rect& dirtyRect = message.dirtyrect();
+		frame = sink.BeginFrame(comId, dirtyRect.x(), dirtyRect.y(), dirtyRect.width(), dirtyRect.height(), chunks, pictureSizeHint);
+	}
+
+	// the chunks of a rejected frame are read and dropped
+	void Add(std::string& chunk)
+	{
+		if (frame)
+		{
+			frame->AddChunk(chunk);
+		}
+	}
+
+	void Abort()
+	{
+		if (frame)
+		{
+			frame->Abort();
+		}
+	}
+
+	IImageFrameSink& sink;
+	const std::string& comId;
+	std::unique_ptr<IImageFrame> frame;
+};
+
+// Reads the chunks of one image update from a stream of GrabResult or RegionsGrabResult messages.
+template<typename Reader, typename Message, typename Frame>
+ReadGrabResultOutcome ReadGrabResult(Reader& reader, Message& message, Frame& frame)
+{
+	if (!reader.Read(&message))
+	{
+		return ReadGrabResultOutcome::NoMessage;
+	}
+
+	const uint32_t chunks = std::max<uint32_t>(message.chunks(), 1);
+	std::string& firstChunk = *message.mutable_pixeldata()->mutable_picture();
+
+	// all chunks but the last one have the size of the first
+	const size_t pictureSizeHint = std::min<uint64_t>(static_cast<uint64_t>(firstChunk.size()) * chunks, MaxPictureSizeHint);
+
+	frame.Begin(message, chunks, pictureSizeHint);
+	frame.Add(firstChunk);
+
+	for (uint32_t chunkCounter = 1; chunkCounter < chunks; ++chunkCounter)
+	{
+		if (!reader.Read(&message))
+		{
+			message.Clear();
+			frame.Abort();
+			return ReadGrabResultOutcome::MissingChunks;
+		}
+		frame.Add(*message.mutable_pixeldata()->mutable_picture());
+	}
+
+	message.Clear();
+	return ReadGrabResultOutcome::Complete;
+}
+
+// Reads one image update and passes it to the frame sink if set, to the request processing otherwise.
+template<typename Reader>
+ReadGrabResultOutcome ReceiveImageUpdate(Reader& reader,
+	const std::string& comId,
+	const std::shared_ptr<IImageFrameSink>& frameSink,
+	const IImageServiceServer::ProcessUpdateImageRequestCallback& requestProcessing,
+	::tvimageservice::GrabResult& message,
+	JoinedFrame& joinedFrame,
+	const IImageServiceServer::UpdateImageResponseCallback& response)
+{
+	if (frameSink)
+	{
+		SinkFrame frame{*frameSink, comId, nullptr};
+		const ReadGrabResultOutcome outcome = ReadGrabResult(reader, message, frame);
+		if (outcome != ReadGrabResultOutcome::Complete)
+		{
+			return outcome;
+		}
+		if (!frame.frame)
+		{
+			return ReadGrabResultOutcome::Rejected;
+		}
+		frame.frame->End(response);
+		return outcome;
+	}
+
+	const ReadGrabResultOutcome outcome = ReadGrabResult(reader, message, joinedFrame);
+	if (outcome == ReadGrabResultOutcome::Complete)
+	{
+		requestProcessing(
+			comId,
+			joinedFrame.x,
+			joinedFrame.y,
+			joinedFrame.width,
+			joinedFrame.height,
+			joinedFrame.pictureData,
+			response);
+	}
+	return outcome;
+}
+
+} // namespace
+
 bool ImageServicegRPCServer::StartServer(const std::string& location)
 {
 	m_location = location;
 
 	m_server = TransportFW::CreateAndStartSyncServer(m_location,
-		this); // Register this "service" as the instance through which we'll communicate with clients.
+		this, // Register this "service" as the instance through which we'll communicate with clients.
+		m_transportOptions);
 
 	return m_server != nullptr;
 }
@@ -72,11 +271,31 @@ void ImageServicegRPCServer::SetUpdateImageCallback(const ProcessUpdateImageRequ
 	m_updateImageProcessing = requestProcessing;
 }
 
+void ImageServicegRPCServer::SetUpdateImageFrameSink(const std::shared_ptr<IImageFrameSink>& frameSink)
+{
+	m_updateImageFrameSink = frameSink;
+}
+
 void ImageServicegRPCServer::SetUpdateImageDefinitionCallback(const ProcessUpdateImageDefinitionRequestCallback& requestProcessing)
 {
 	m_updateImageDefinitionProcessing = requestProcessing;
 }
 
+void ImageServicegRPCServer::SetAnnounceSharedFrameBufferCallback(const ProcessAnnounceSharedFrameBufferRequestCallback& requestProcessing)
+{
+	m_announceSharedFrameBufferProcessing = requestProcessing;
+}
+
+void ImageServicegRPCServer::SetUpdateImageFromSharedFrameBufferCallback(const ProcessUpdateImageFromSharedFrameBufferRequestCallback& requestProcessing)
+{
+	m_updateImageFromSharedFrameBufferProcessing = requestProcessing;
+}
+
+void ImageServicegRPCServer::SetUpdateImageRegionsCallback(const ProcessUpdateImageRegionsRequestCallback& requestProcessing)
+{
+	m_updateImageRegionsProcessing = requestProcessing;
+}
+
 ::grpc::Status ImageServicegRPCServer::UpdateImage(::grpc::ServerContext* context,
 	::grpc::ServerReader<::tvimageservice::GrabResult>* reader,
 	::tvimageservice::ImageUpdateResponse* responsePtr)
@@ -86,7 +305,7 @@ void ImageServicegRPCServer::SetUpdateImageDefinitionCallback(const ProcessUpdat
 		return ::grpc::Status(::grpc::StatusCode::INTERNAL, std::string{});
 	}
 
-	if (!m_updateImageProcessing)
+	if (!m_updateImageProcessing && !m_updateImageFrameSink)
 	{
 		return ::grpc::Status(::grpc::StatusCode::UNAVAILABLE, TvServiceBase::ErrorMessage_NoProcessingCallback);
 	}
@@ -95,28 +314,13 @@ void ImageServicegRPCServer::SetUpdateImageDefinitionCallback(const ProcessUpdat
 	(void)response;
 
 	std::string comId;
-	::tvimageservice::GrabResult message;
-
-	int32_t x = 0;
-	int32_t y = 0;
-	int32_t width = 0;
-	int32_t height = 0;
-	std::string pictureData;
 
-	uint32_t chunksEntryInProtBuf = 0;
-	if (reader->Read(&message))
+	const auto searchComId = context->client_metadata().find(ServiceBase::CommunicationIdToken);
+	if (searchComId != context->client_metadata().end())
 	{
-		const auto searchComId = context->client_metadata().find(ServiceBase::CommunicationIdToken);
-		if (searchComId != context->client_metadata().end())
-		{
-			comId = std::string((searchComId->second).data(), (searchComId->second).length());
-		}
-		chunksEntryInProtBuf = message.chunks();
-	}
-	else
-	{
-		return ::grpc::Status::CANCELLED;
+		comId = std::string((searchComId->second).data(), (searchComId->second).length());
 	}
+
 	::grpc::Status returnStatus =
 		::grpc::Status(::grpc::StatusCode::CANCELLED, TvServiceBase::ErrorMessage_ResponseCallbackNotCalled);
 
@@ -132,51 +336,22 @@ void ImageServicegRPCServer::SetUpdateImageDefinitionCallback(const ProcessUpdat
 		}
 	};
 
-	if (chunksEntryInProtBuf == 0)
+	::tvimageservice::GrabResult message;
+	JoinedFrame joinedFrame;
+
+	const ReadGrabResultOutcome outcome = ReceiveImageUpdate(
+		*reader, comId, m_updateImageFrameSink, m_updateImageProcessing, message, joinedFrame, responseProcessing);
+	if (outcome == ReadGrabResultOutcome::NoMessage)
 	{
-		const ::tvimageservice::Rect& dirtyRect = message.dirtyrect();
-		x = dirtyRect.x();
-		y = dirtyRect.y();
-		height = dirtyRect.height();
-		width = dirtyRect.width();
-		pictureData.swap(*message.mutable_pixeldata()->mutable_picture());
-		message.Clear();
-		m_updateImageProcessing(comId, x, y, width, height, pictureData, responseProcessing);
+		return ::grpc::Status::CANCELLED;
 	}
-	else
+	if (outcome == ReadGrabResultOutcome::MissingChunks)
 	{
-		const ::tvimageservice::Rect& dirtyRect = message.dirtyrect();
-		x = dirtyRect.x();
-		y = dirtyRect.y();
-		height = dirtyRect.height();
-		width = dirtyRect.width();
-		pictureData.swap(*message.mutable_pixeldata()->mutable_picture());
-
-		bool error = false;
-
-		for (uint32_t chunkCounter = 1; chunkCounter < chunksEntryInProtBuf; ++chunkCounter)
-		{
-			if (reader->Read(&message))
-			{
-				pictureData += message.pixeldata().picture();
-			}
-			else
-			{
-				error = true;
-				break;
-			}
-		}
-
-		message.Clear();
-
-		if (!error)
-		{
-			m_updateImageProcessing(comId, x, y, width, height, pictureData, responseProcessing);
-		}
-		else
-		{
-			return ::grpc::Status{::grpc::StatusCode::ABORTED, "Reading chunks failed"};
-		}
+		return ::grpc::Status{::grpc::StatusCode::ABORTED, "Reading chunks failed"};
+	}
+	if (outcome == ReadGrabResultOutcome::Rejected)
+	{
+		return ::grpc::Status{::grpc::StatusCode::UNAVAILABLE, TvServiceBase::ErrorMessage_FrameRejected};
 	}
 
 	return returnStatus;
@@ -264,6 +439,232 @@ void ImageServicegRPCServer::SetUpdateImageDefinitionCallback(const ProcessUpdat
 	return returnStatus;
 }
 
+::grpc::Status ImageServicegRPCServer::AnnounceSharedFrameBuffer(::grpc::ServerContext* context,
+	const ::tvimageservice::SharedFrameBufferRequest* requestPtr,
+	::tvimageservice::SharedFrameBufferResponse* responsePtr)
+{
+	if (context == nullptr || requestPtr == nullptr || responsePtr == nullptr)
+	{
+		return ::grpc::Status(::grpc::StatusCode::INTERNAL, std::string{});
+	}
+
+	if (!m_announceSharedFrameBufferProcessing)
+	{
+		return ::grpc::Status(::grpc::StatusCode::UNAVAILABLE, TvServiceBase::ErrorMessage_NoProcessingCallback);
+	}
+	auto& request = *requestPtr;
+	(void)request;
+
+	auto& response = *responsePtr;
+	(void)response;
+
+	std::string comId;
+
+	const auto foundComId = context->client_metadata().find(ServiceBase::CommunicationIdToken);
+	if (foundComId == context->client_metadata().end())
+	{
+		return ::grpc::Status(::grpc::StatusCode::FAILED_PRECONDITION, TvServiceBase::ErrorMessage_NoComId);
+	}
+	comId = std::string((foundComId->second).data(), (foundComId->second).length());
+
+	::grpc::Status returnStatus =
+		::grpc::Status(::grpc::StatusCode::CANCELLED, TvServiceBase::ErrorMessage_ResponseCallbackNotCalled);
+
+	auto responseProcessing = [&returnStatus](const CallStatus& callStatus)
+	{
+		if (callStatus.IsOk())
+		{
+			returnStatus = ::grpc::Status::OK;
+		}
+		else
+		{
+			returnStatus = ::grpc::Status(::grpc::StatusCode::ABORTED, callStatus.errorMessage);
+		}
+	};
+
+	m_announceSharedFrameBufferProcessing(comId,
+		request.name(),
+
+		request.slotcount(),
+
+		request.slotsize(),
+
+		responseProcessing);
+
+	return returnStatus;
+}
+
+::grpc::Status ImageServicegRPCServer::UpdateImageFromSharedFrameBuffer(::grpc::ServerContext* context,
+	const ::tvimageservice::SharedFrameUpdate* requestPtr,
+	::tvimageservice::ImageUpdateResponse* responsePtr)
+{
+	if (context == nullptr || requestPtr == nullptr || responsePtr == nullptr)
+	{
+		return ::grpc::Status(::grpc::StatusCode::INTERNAL, std::string{});
+	}
+
+	if (!m_updateImageFromSharedFrameBufferProcessing)
+	{
+		return ::grpc::Status(::grpc::StatusCode::UNAVAILABLE, TvServiceBase::ErrorMessage_NoProcessingCallback);
+	}
+	auto& request = *requestPtr;
+	(void)request;
+
+	auto& response = *responsePtr;
+	(void)response;
+
+	std::string comId;
+
+	const auto foundComId = context->client_metadata().find(ServiceBase::CommunicationIdToken);
+	if (foundComId == context->client_metadata().end())
+	{
+		return ::grpc::Status(::grpc::StatusCode::FAILED_PRECONDITION, TvServiceBase::ErrorMessage_NoComId);
+	}
+	comId = std::string((foundComId->second).data(), (foundComId->second).length());
+
+	::grpc::Status returnStatus =
+		::grpc::Status(::grpc::StatusCode::CANCELLED, TvServiceBase::ErrorMessage_ResponseCallbackNotCalled);
+
+	auto responseProcessing = [&returnStatus](const CallStatus& callStatus)
+	{
+		if (callStatus.IsOk())
+		{
+			returnStatus = ::grpc::Status::OK;
+		}
+		else
+		{
+			returnStatus = ::grpc::Status(::grpc::StatusCode::ABORTED, callStatus.errorMessage);
+		}
+	};
+
+	const ::tvimageservice::Rect& dirtyRect = request.dirtyrect();
+
+	m_updateImageFromSharedFrameBufferProcessing(comId,
+		dirtyRect.x(),
+		dirtyRect.y(),
+		dirtyRect.width(),
+		dirtyRect.height(),
+		request.slot(),
+		request.size(),
+		responseProcessing);
+
+	return returnStatus;
+}
+
+::grpc::Status ImageServicegRPCServer::UpdateImageStream(::grpc::ServerContext* context,
+	::grpc::ServerReaderWriter<::tvimageservice::ImageStreamAck, ::tvimageservice::GrabResult>* stream)
+{
+	if (context == nullptr || stream == nullptr)
+	{
+		return ::grpc::Status(::grpc::StatusCode::INTERNAL, std::string{});
+	}
+
+	if (!m_updateImageProcessing && !m_updateImageFrameSink)
+	{
+		return ::grpc::Status(::grpc::StatusCode::UNAVAILABLE, TvServiceBase::ErrorMessage_NoProcessingCallback);
+	}
+
+	std::string comId;
+
+	const auto searchComId = context->client_metadata().find(ServiceBase::CommunicationIdToken);
+	if (searchComId != context->client_metadata().end())
+	{
+		comId = std::string((searchComId->second).data(), (searchComId->second).length());
+	}
+
+	::tvimageservice::GrabResult message;
+	::tvimageservice::ImageStreamAck ack;
+	JoinedFrame joinedFrame;
+
+	auto responseProcessing = [&ack](const CallStatus& callStatus)
+	{
+		ack.set_ok(callStatus.IsOk());
+		ack.set_errormessage(callStatus.IsOk() ? std::string{} : callStatus.errorMessage);
+	};
+
+	// every frame is acknowledged once processed, the client paces its frames by these
+	for (;;)
+	{
+		ack.set_ok(false);
+		ack.set_errormessage(TvServiceBase::ErrorMessage_ResponseCallbackNotCalled);
+
+		const ReadGrabResultOutcome outcome = ReceiveImageUpdate(
+			*stream, comId, m_updateImageFrameSink, m_updateImageProcessing, message, joinedFrame, responseProcessing);
+		if (outcome == ReadGrabResultOutcome::NoMessage)
+		{
+			return ::grpc::Status::OK;
+		}
+		if (outcome == ReadGrabResultOutcome::MissingChunks)
+		{
+			return ::grpc::Status{::grpc::StatusCode::ABORTED, "Reading chunks failed"};
+		}
+		if (outcome == ReadGrabResultOutcome::Rejected)
+		{
+			// the stream goes on with the next frame
+			ack.set_errormessage(TvServiceBase::ErrorMessage_FrameRejected);
+		}
+
+		if (!stream->Write(ack))
+		{
+			return ::grpc::Status::CANCELLED;
+		}
+	}
+}
+
+::grpc::Status ImageServicegRPCServer::UpdateImageRegions(::grpc::ServerContext* context,
+	::grpc::ServerReader<::tvimageservice::RegionsGrabResult>* reader,
+	::tvimageservice::ImageUpdateResponse* responsePtr)
+{
+	if (context == nullptr || reader == nullptr || responsePtr == nullptr)
+	{
+		return ::grpc::Status(::grpc::StatusCode::INTERNAL, std::string{});
+	}
+
+	if (!m_updateImageRegionsProcessing)
+	{
+		return ::grpc::Status(::grpc::StatusCode::UNAVAILABLE, TvServiceBase::ErrorMessage_NoProcessingCallback);
+	}
+
+	const auto foundComId = context->client_metadata().find(ServiceBase::CommunicationIdToken);
+	if (foundComId == context->client_metadata().end())
+	{
+		return ::grpc::Status(::grpc::StatusCode::FAILED_PRECONDITION, TvServiceBase::ErrorMessage_NoComId);
+	}
+	const std::string comId = std::string((foundComId->second).data(), (foundComId->second).length());
+
+	::grpc::Status returnStatus =
+		::grpc::Status(::grpc::StatusCode::CANCELLED, TvServiceBase::ErrorMessage_ResponseCallbackNotCalled);
+
+	auto responseProcessing = [&returnStatus](const CallStatus& callStatus)
+	{
+		if (callStatus.IsOk())
+		{
+			returnStatus = ::grpc::Status::OK;
+		}
+		else
+		{
+			returnStatus = ::grpc::Status(::grpc::StatusCode::ABORTED, callStatus.errorMessage);
+		}
+	};
+
+	::tvimageservice::RegionsGrabResult message;
+	RegionsFrame frame;
+
+	const ReadGrabResultOutcome outcome = ReadGrabResult(*reader, message, frame);
+	if (outcome == ReadGrabResultOutcome::NoMessage)
+	{
+		return ::grpc::Status::CANCELLED;
+	}
+	if (outcome == ReadGrabResultOutcome::MissingChunks)
+	{
+		return ::grpc::Status{::grpc::StatusCode::ABORTED, "Reading chunks failed"};
+	}
+
+	m_updateImageRegionsProcessing(comId, frame.regions, frame.pictureData, responseProcessing);
+
+	return returnStatus;
+}
+
 } // namespace ImageService
 
 } // namespace TVRemoteScreenSDKCommunication
\ No newline at end of file
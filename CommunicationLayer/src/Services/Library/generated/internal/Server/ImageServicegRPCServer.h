@@ -27,6 +27,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/ImageService/IImageServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCTransport.h>
 
 #include "ImageService.grpc.pb.h"
@@ -50,6 +51,10 @@ public:
 	using TransportFW = Transport::gRPC;
 
 	ImageServicegRPCServer() = default;
+	explicit ImageServicegRPCServer(TransportOptions transportOptions)
+		: m_transportOptions(std::move(transportOptions))
+	{
+	}
 	~ImageServicegRPCServer() override = default;
 
 	bool StartServer(const std::string& location) override;
@@ -61,8 +66,16 @@ public:
 	// public interface impl
 	void SetUpdateImageCallback(const ProcessUpdateImageRequestCallback& requestProcessing) override;
 
+	void SetUpdateImageFrameSink(const std::shared_ptr<IImageFrameSink>& frameSink) override;
+
 	void SetUpdateImageDefinitionCallback(const ProcessUpdateImageDefinitionRequestCallback& requestProcessing) override;
 
+	void SetAnnounceSharedFrameBufferCallback(const ProcessAnnounceSharedFrameBufferRequestCallback& requestProcessing) override;
+
+	void SetUpdateImageFromSharedFrameBufferCallback(const ProcessUpdateImageFromSharedFrameBufferRequestCallback& requestProcessing) override;
+
+	void SetUpdateImageRegionsCallback(const ProcessUpdateImageRegionsRequestCallback& requestProcessing) override;
+
 	// grpc service impl
 	::grpc::Status UpdateImage(::grpc::ServerContext* context,
 		::grpc::ServerReader<::tvimageservice::GrabResult>* reader,
@@ -72,12 +85,32 @@ public:
 		const ::tvimageservice::ImageDefinitionRequest* request,
 		::tvimageservice::ImageDefinitionResponse* response) override;
 
+	::grpc::Status AnnounceSharedFrameBuffer(::grpc::ServerContext* context,
+		const ::tvimageservice::SharedFrameBufferRequest* request,
+		::tvimageservice::SharedFrameBufferResponse* response) override;
+
+	::grpc::Status UpdateImageFromSharedFrameBuffer(::grpc::ServerContext* context,
+		const ::tvimageservice::SharedFrameUpdate* request,
+		::tvimageservice::ImageUpdateResponse* response) override;
+
+	::grpc::Status UpdateImageStream(::grpc::ServerContext* context,
+		::grpc::ServerReaderWriter<::tvimageservice::ImageStreamAck, ::tvimageservice::GrabResult>* stream) override;
+
+	::grpc::Status UpdateImageRegions(::grpc::ServerContext* context,
+		::grpc::ServerReader<::tvimageservice::RegionsGrabResult>* reader,
+		::tvimageservice::ImageUpdateResponse* response) override;
+
 private:
 	std::string m_location;
+	TransportOptions m_transportOptions;
 	std::unique_ptr<::grpc::Server> m_server;
 
 	ProcessUpdateImageRequestCallback m_updateImageProcessing;
+	std::shared_ptr<IImageFrameSink> m_updateImageFrameSink;
 	ProcessUpdateImageDefinitionRequestCallback m_updateImageDefinitionProcessing;
+	ProcessAnnounceSharedFrameBufferRequestCallback m_announceSharedFrameBufferProcessing;
+	ProcessUpdateImageFromSharedFrameBufferRequestCallback m_updateImageFromSharedFrameBufferProcessing;
+	ProcessUpdateImageRegionsRequestCallback m_updateImageRegionsProcessing;
 };
 
 } // namespace ImageService
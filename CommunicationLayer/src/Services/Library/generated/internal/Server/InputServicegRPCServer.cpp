@@ -38,18 +38,49 @@ namespace TVRemoteScreenSDKCommunication
 namespace InputService
 {
 
+InputServicegRPCServer::~InputServicegRPCServer()
+{
+	// a shared host would keep calling into the destroyed instance
+	StopServer(true);
+}
+
 bool InputServicegRPCServer::StartServer(const std::string& location)
 {
 	m_location = location;
 
+	// a host shared by the services listening on the location serves the calls asynchronously
+	m_asyncHost = Transport::gRPCAsyncServerHost::Find(m_location);
+	if (m_asyncHost)
+	{
+		using Host = Transport::gRPCAsyncServerHost;
+		if (!m_asyncHost->AddService(::tvinputservice::InputService::service_full_name(), Host::MethodHandlers{
+			{"SimulateKey", Host::MakeUnaryHandler(this, &InputServicegRPCServer::SimulateKey)},
+			{"SimulateMouseMove", Host::MakeUnaryHandler(this, &InputServicegRPCServer::SimulateMouseMove)},
+			{"SimulateMousePressRelease", Host::MakeUnaryHandler(this, &InputServicegRPCServer::SimulateMousePressRelease)},
+			{"SimulateMouseWheel", Host::MakeUnaryHandler(this, &InputServicegRPCServer::SimulateMouseWheel)}
+		}))
+		{
+			m_asyncHost.reset();
+		}
+
+		return m_asyncHost != nullptr;
+	}
+
 	m_server = TransportFW::CreateAndStartSyncServer(m_location,
-		this); // Register this "service" as the instance through which we'll communicate with clients.
+		this, // Register this "service" as the instance through which we'll communicate with clients.
+		m_transportOptions);
 
 	return m_server != nullptr;
 }
 
 void InputServicegRPCServer::StopServer(bool /*force*/)
 {
+	if (m_asyncHost)
+	{
+		m_asyncHost->RemoveService(::tvinputservice::InputService::service_full_name());
+		m_asyncHost.reset();
+	}
+
 	if (m_server)
 	{
 		m_server->Shutdown();
@@ -38,18 +38,47 @@ namespace TVRemoteScreenSDKCommunication
 namespace InstantSupportService
 {
 
+InstantSupportNotificationServicegRPCServer::~InstantSupportNotificationServicegRPCServer()
+{
+	// a shared host would keep calling into the destroyed instance
+	StopServer(true);
+}
+
 bool InstantSupportNotificationServicegRPCServer::StartServer(const std::string& location)
 {
 	m_location = location;
 
+	// a host shared by the services listening on the location serves the calls asynchronously
+	m_asyncHost = Transport::gRPCAsyncServerHost::Find(m_location);
+	if (m_asyncHost)
+	{
+		using Host = Transport::gRPCAsyncServerHost;
+		if (!m_asyncHost->AddService(::tvinstantsupportservice::InstantSupportNotificationService::service_full_name(), Host::MethodHandlers{
+			{"NotifyInstantSupportError", Host::MakeUnaryHandler(this, &InstantSupportNotificationServicegRPCServer::NotifyInstantSupportError)},
+			{"NotifyInstantSupportModified", Host::MakeUnaryHandler(this, &InstantSupportNotificationServicegRPCServer::NotifyInstantSupportModified)}
+		}))
+		{
+			m_asyncHost.reset();
+		}
+
+		return m_asyncHost != nullptr;
+	}
+
 	m_server = TransportFW::CreateAndStartSyncServer(m_location,
-		this); // Register this "service" as the instance through which we'll communicate with clients.
+		this, // Register this "service" as the instance through which we'll communicate with clients.
+		m_transportOptions);
 
 	return m_server != nullptr;
 }
 
 void InstantSupportNotificationServicegRPCServer::StopServer(bool /*force*/)
 {
+	if (m_asyncHost)
+	{
+		m_asyncHost->RemoveService(::tvinstantsupportservice::InstantSupportNotificationService::service_full_name());
+		m_asyncHost.reset();
+	}
+
 	if (m_server)
 	{
 		m_server->Shutdown();
@@ -38,18 +38,49 @@ namespace TVRemoteScreenSDKCommunication
 namespace SessionStatusService
 {
 
+SessionStatusServicegRPCServer::~SessionStatusServicegRPCServer()
+{
+	// a shared host would keep calling into the destroyed instance
+	StopServer(true);
+}
+
 bool SessionStatusServicegRPCServer::StartServer(const std::string& location)
 {
 	m_location = location;
 
+	// a host shared by the services listening on the location serves the calls asynchronously
+	m_asyncHost = Transport::gRPCAsyncServerHost::Find(m_location);
+	if (m_asyncHost)
+	{
+		using Host = Transport::gRPCAsyncServerHost;
+		if (!m_asyncHost->AddService(::tvsessionstatusservice::SessionStatusService::service_full_name(), Host::MethodHandlers{
+			{"RemoteControlStarted", Host::MakeUnaryHandler(this, &SessionStatusServicegRPCServer::RemoteControlStarted)},
+			{"RemoteControlStopped", Host::MakeUnaryHandler(this, &SessionStatusServicegRPCServer::RemoteControlStopped)},
+			{"TVSessionStarted", Host::MakeUnaryHandler(this, &SessionStatusServicegRPCServer::TVSessionStarted)},
+			{"TVSessionStopped", Host::MakeUnaryHandler(this, &SessionStatusServicegRPCServer::TVSessionStopped)}
+		}))
+		{
+			m_asyncHost.reset();
+		}
+
+		return m_asyncHost != nullptr;
+	}
+
 	m_server = TransportFW::CreateAndStartSyncServer(m_location,
-		this); // Register this "service" as the instance through which we'll communicate with clients.
+		this, // Register this "service" as the instance through which we'll communicate with clients.
+		m_transportOptions);
 
 	return m_server != nullptr;
 }
 
 void SessionStatusServicegRPCServer::StopServer(bool /*force*/)
 {
+	if (m_asyncHost)
+	{
+		m_asyncHost->RemoveService(::tvsessionstatusservice::SessionStatusService::service_full_name());
+		m_asyncHost.reset();
+	}
+
 	if (m_server)
 	{
 		m_server->Shutdown();
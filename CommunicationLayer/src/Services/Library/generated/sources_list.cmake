@@ -101,7 +101,7 @@ set(SOURCES_GENERATED
 )
 
 if(TV_COMM_ENABLE_GRPC)
-	list(APPEND SOURCES_GENERATED
+	set(SOURCES_GENERATED_GRPC
 		generated/internal/Client/AccessControlInServicegRPCClient.cpp
 		generated/internal/Client/AccessControlInServicegRPCClient.h
 		generated/internal/Client/AccessControlOutServicegRPCClient.cpp
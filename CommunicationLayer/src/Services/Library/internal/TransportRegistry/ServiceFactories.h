@@ -0,0 +1,191 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include <TVRemoteScreenSDKCommunication/AccessControlService/IAccessControlInServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/AccessControlService/IAccessControlInServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/AccessControlService/IAccessControlOutServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/AccessControlService/IAccessControlOutServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/AccessControlService/InServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/AccessControlService/OutServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/AugmentRCSessionService/ConsumerServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/AugmentRCSessionService/ControlServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/AugmentRCSessionService/IAugmentRCSessionConsumerServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/AugmentRCSessionService/IAugmentRCSessionConsumerServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/AugmentRCSessionService/IAugmentRCSessionControlServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/AugmentRCSessionService/IAugmentRCSessionControlServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/ChatService/IChatInServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/ChatService/IChatInServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/ChatService/IChatOutServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/ChatService/IChatOutServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/ChatService/InServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/ChatService/OutServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/ConnectionConfirmationService/IConnectionConfirmationRequestServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/ConnectionConfirmationService/IConnectionConfirmationRequestServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/ConnectionConfirmationService/IConnectionConfirmationResponseServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/ConnectionConfirmationService/IConnectionConfirmationResponseServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/ConnectionConfirmationService/RequestServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/ConnectionConfirmationService/ResponseServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/ConnectivityService/IConnectivityServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/ConnectivityService/IConnectivityServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/ConnectivityService/ServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/ImageNotificationService/IImageNotificationServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/ImageNotificationService/IImageNotificationServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/ImageNotificationService/ServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/IImageServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/IImageServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/ServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/InputService/IInputServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/InputService/IInputServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/InputService/ServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/InstantSupportService/IInstantSupportNotificationServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/InstantSupportService/IInstantSupportNotificationServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/InstantSupportService/IInstantSupportServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/InstantSupportService/IInstantSupportServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/InstantSupportService/NotificationServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/InstantSupportService/ServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/RegistrationService/IRegistrationServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/RegistrationService/IRegistrationServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/RegistrationService/ServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/SessionControlService/ISessionControlServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/SessionControlService/ISessionControlServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/SessionControlService/ServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/SessionStatusService/ISessionStatusServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/SessionStatusService/ISessionStatusServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/SessionStatusService/ServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/ViewGeometryService/IViewGeometryServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/ViewGeometryService/IViewGeometryServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/ViewGeometryService/ServiceFactory.h>
+
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/IServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/IServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportFramework.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
+
+#include <memory>
+
+namespace TVRemoteScreenSDKCommunication
+{
+
+namespace TransportBackends
+{
+
+// maps the service type known at runtime onto the factory of the service
+template<TransportFramework Framework>
+std::unique_ptr<IServiceServer> CreateServer(ServiceType serviceType, const TransportOptions& transportOptions)
+{
+	switch (serviceType)
+	{
+		case ServiceType::AccessControlIn:
+			return AccessControlService::InServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::AccessControlOut:
+			return AccessControlService::OutServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::AugmentRCSessionConsumer:
+			return AugmentRCSessionService::ConsumerServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::AugmentRCSessionControl:
+			return AugmentRCSessionService::ControlServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::ChatIn:
+			return ChatService::InServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::ChatOut:
+			return ChatService::OutServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::ConnectionConfirmationRequest:
+			return ConnectionConfirmationService::RequestServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::ConnectionConfirmationResponse:
+			return ConnectionConfirmationService::ResponseServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::Connectivity:
+			return ConnectivityService::ServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::Image:
+			return ImageService::ServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::ImageNotification:
+			return ImageNotificationService::ServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::Input:
+			return InputService::ServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::InstantSupport:
+			return InstantSupportService::ServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::InstantSupportNotification:
+			return InstantSupportService::NotificationServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::Registration:
+			return RegistrationService::ServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::SessionControl:
+			return SessionControlService::ServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::SessionStatus:
+			return SessionStatusService::ServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::ViewGeometry:
+			return ViewGeometryService::ServiceFactory::CreateServer<Framework>(transportOptions);
+		case ServiceType::Unknown:
+			break;
+	}
+	return {};
+}
+
+template<TransportFramework Framework>
+std::unique_ptr<IServiceClient> CreateClient(ServiceType serviceType, const TransportOptions& transportOptions)
+{
+	switch (serviceType)
+	{
+		case ServiceType::AccessControlIn:
+			return AccessControlService::InServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::AccessControlOut:
+			return AccessControlService::OutServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::AugmentRCSessionConsumer:
+			return AugmentRCSessionService::ConsumerServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::AugmentRCSessionControl:
+			return AugmentRCSessionService::ControlServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::ChatIn:
+			return ChatService::InServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::ChatOut:
+			return ChatService::OutServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::ConnectionConfirmationRequest:
+			return ConnectionConfirmationService::RequestServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::ConnectionConfirmationResponse:
+			return ConnectionConfirmationService::ResponseServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::Connectivity:
+			return ConnectivityService::ServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::Image:
+			return ImageService::ServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::ImageNotification:
+			return ImageNotificationService::ServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::Input:
+			return InputService::ServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::InstantSupport:
+			return InstantSupportService::ServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::InstantSupportNotification:
+			return InstantSupportService::NotificationServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::Registration:
+			return RegistrationService::ServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::SessionControl:
+			return SessionControlService::ServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::SessionStatus:
+			return SessionStatusService::ServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::ViewGeometry:
+			return ViewGeometryService::ServiceFactory::CreateClient<Framework>(transportOptions);
+		case ServiceType::Unknown:
+			break;
+	}
+	return {};
+}
+
+} // namespace TransportBackends
+
+} // namespace TVRemoteScreenSDKCommunication
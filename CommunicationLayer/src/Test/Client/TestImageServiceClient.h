@@ -25,12 +25,17 @@
 
 #include "TestData/TestDataImage.h"
 
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/AsyncServiceClient.h>
 #include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportFramework.h>
 
 #include <TVRemoteScreenSDKCommunication/ImageService/IImageServiceClient.h>
 #include <TVRemoteScreenSDKCommunication/ImageService/ServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/SharedFrameBuffer.h>
 
+#include <cstring>
+#include <future>
 #include <iostream>
+#include <string>
 
 namespace TestImageService
 {
@@ -79,6 +84,155 @@ int TestImageServiceClient(int /*argc*/, char** /*argv*/)
 		std::cout << LogPrefix << "UpdateImage successful" << std::endl;
 	}
 
+	const std::string sharedFrameBufferName = "/tvImageServiceTest-" + std::to_string(Framework);
+	const std::unique_ptr<SharedFrameBuffer> sharedFrameBuffer =
+		SharedFrameBuffer::Create(sharedFrameBufferName, SharedFrameBuffer::DefaultSlotCount, TestData::Picture().size());
+	if (!sharedFrameBuffer)
+	{
+		std::cerr << LogPrefix << "Creating shared frame buffer failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	response = client->AnnounceSharedFrameBuffer(
+		TestData::ComId,
+		sharedFrameBuffer->GetName(),
+		sharedFrameBuffer->GetSlotCount(),
+		sharedFrameBuffer->GetSlotSize());
+	if (response.IsOk())
+	{
+		std::cout << LogPrefix << "AnnounceSharedFrameBuffer successful" << std::endl;
+	}
+	else
+	{
+		std::cerr << LogPrefix << "AnnounceSharedFrameBuffer Error: " << response.errorMessage << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// the last slot, so an off-by-one in the slot offset gets noticed
+	uint32_t slot = 0;
+	for (uint32_t i = 0; i < sharedFrameBuffer->GetSlotCount(); ++i)
+	{
+		if (!sharedFrameBuffer->Acquire(slot))
+		{
+			std::cerr << LogPrefix << "Acquiring shared frame buffer slot failed" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	uint32_t unexpectedSlot = 0;
+	if (slot != sharedFrameBuffer->GetSlotCount() - 1 || sharedFrameBuffer->Acquire(unexpectedSlot))
+	{
+		std::cerr << LogPrefix << "Shared frame buffer slot reused before being released" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::memcpy(sharedFrameBuffer->Slot(slot), TestData::Picture().data(), TestData::Picture().size());
+
+	response = client->UpdateImageFromSharedFrameBuffer(
+		TestData::ComId,
+		TestData::X,
+		TestData::Y,
+		TestData::Width,
+		TestData::Height,
+		slot,
+		TestData::Picture().size());
+	if (response.IsOk())
+	{
+		std::cout << LogPrefix << "UpdateImageFromSharedFrameBuffer successful" << std::endl;
+	}
+	else
+	{
+		std::cerr << LogPrefix << "UpdateImageFromSharedFrameBuffer Error: " << response.errorMessage << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// the agent has released the slot after consuming the frame
+	uint32_t releasedSlot = 0;
+	if (!sharedFrameBuffer->Acquire(releasedSlot) || releasedSlot != slot)
+	{
+		std::cerr << LogPrefix << "Shared frame buffer slot not released" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	response = client->UpdateImageRegions(TestData::ComId, TestData::Regions(), TestData::Picture());
+	if (response.IsOk())
+	{
+		std::cout << LogPrefix << "UpdateImageRegions successful" << std::endl;
+	}
+	else
+	{
+		std::cerr << LogPrefix << "UpdateImageRegions Error: " << response.errorMessage << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// more frames than may be in flight, so the acknowledgements have to arrive
+	for (int frame = 0; frame < 3; ++frame)
+	{
+		response = client->UpdateImageStream(TestData::ComId, TestData::X, TestData::Y, TestData::Width, TestData::Height, TestData::Picture());
+		if (!response.IsOk())
+		{
+			std::cerr << LogPrefix << "UpdateImageStream Error: " << response.errorMessage << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	client->StopImageStream();
+	std::cout << LogPrefix << "UpdateImageStream successful" << std::endl;
+
+	{
+		using TVRemoteScreenSDKCommunication::AsyncServiceClient;
+		using TVRemoteScreenSDKCommunication::CallStatus;
+
+		// arguments are taken by forwarding reference, which would odr-use the static constants
+		const std::string comId = TestData::ComId;
+		const int32_t x = TestData::X;
+		const int32_t y = TestData::Y;
+		const int32_t width = TestData::Width;
+		const int32_t height = TestData::Height;
+		const double dpi = TestData::Dpi;
+		const ColorFormat format = TestData::ColorFormat;
+
+		AsyncServiceClient<IImageServiceClient> asyncClient{client};
+
+		std::promise<CallStatus> definitionStatus;
+		asyncClient.Call(
+			[&definitionStatus](const CallStatus& status)
+			{
+				definitionStatus.set_value(status);
+			},
+			&IImageServiceClient::UpdateImageDefinition,
+			comId,
+			std::string{TestData::ImageSourceTitle},
+			width,
+			height,
+			format,
+			dpi);
+
+		std::future<CallStatus> imageStatus = asyncClient.Call(
+			&IImageServiceClient::UpdateImage,
+			comId,
+			x,
+			y,
+			width,
+			height,
+			TestData::Picture());
+
+		response = definitionStatus.get_future().get();
+		if (!response.IsOk())
+		{
+			std::cerr << LogPrefix << "Async UpdateImageDefinition Error: " << response.errorMessage << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		response = imageStatus.get();
+		if (!response.IsOk())
+		{
+			std::cerr << LogPrefix << "Async UpdateImage Error: " << response.errorMessage << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		std::cout << LogPrefix << "Async UpdateImageDefinition and UpdateImage successful" << std::endl;
+	}
+
 	return EXIT_SUCCESS;
 }
 
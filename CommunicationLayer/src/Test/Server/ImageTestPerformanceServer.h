@@ -24,6 +24,7 @@
 #pragma once
 
 #include <TVRemoteScreenSDKCommunication/ImageService/ServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/IImageFrameSink.h>
 #include <TVRemoteScreenSDKCommunication/ImageService/IImageServiceServer.h>
 
 #include <atomic>
@@ -39,6 +40,57 @@ struct SharedInformation
 	std::atomic<uint64_t> counter{0};
 };
 
+// Counts the frames without joining their chunks, the picture data is not looked at.
+class CountingFrame : public TVRemoteScreenSDKCommunication::ImageService::IImageFrame
+{
+public:
+	explicit CountingFrame(SharedInformation& information)
+		: m_information(information)
+	{
+	}
+
+	void AddChunk(std::string& /*chunk*/) override
+	{
+	}
+
+	void End(const ResponseCallback& response) override
+	{
+		++m_information.counter;
+		response(TVRemoteScreenSDKCommunication::CallStatus::Ok);
+	}
+
+	void Abort() override
+	{
+	}
+
+private:
+	SharedInformation& m_information;
+};
+
+class CountingFrameSink : public TVRemoteScreenSDKCommunication::ImageService::IImageFrameSink
+{
+public:
+	explicit CountingFrameSink(SharedInformation& information)
+		: m_information(information)
+	{
+	}
+
+	std::unique_ptr<TVRemoteScreenSDKCommunication::ImageService::IImageFrame> BeginFrame(
+		const std::string& /*comId*/,
+		int32_t /*x*/,
+		int32_t /*y*/,
+		int32_t /*width*/,
+		int32_t /*height*/,
+		uint32_t /*chunks*/,
+		size_t /*pictureSizeHint*/) override
+	{
+		return std::unique_ptr<TVRemoteScreenSDKCommunication::ImageService::IImageFrame>{new CountingFrame{m_information}};
+	}
+
+private:
+	SharedInformation& m_information;
+};
+
 template<TVRemoteScreenSDKCommunication::TransportFramework Framework>
 std::shared_ptr<TVRemoteScreenSDKCommunication::ImageService::IImageServiceServer> TestImageService(
 	SharedInformation& information,
@@ -47,19 +99,7 @@ std::shared_ptr<TVRemoteScreenSDKCommunication::ImageService::IImageServiceServe
 	using namespace TVRemoteScreenSDKCommunication::ImageService;
 	const std::shared_ptr<IImageServiceServer> server = ServiceFactory::CreateServer<Framework>();
 
-	const auto receiveFunction = [&information](
-		const std::string& /*communicationId*/,
-		int32_t /*x*/,
-		int32_t /*y*/,
-		int32_t /*width*/,
-		int32_t /*height*/,
-		const std::string& /*pictureData*/,
-		const IImageServiceServer::UpdateImageResponseCallback& response)
-	{
-		++information.counter;
-		response(TVRemoteScreenSDKCommunication::CallStatus::Ok);
-	};
-	server->SetUpdateImageCallback(receiveFunction);
+	server->SetUpdateImageFrameSink(std::make_shared<CountingFrameSink>(information));
 
 	if (!server->StartServer(location))
 	{
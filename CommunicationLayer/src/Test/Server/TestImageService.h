@@ -27,7 +27,10 @@
 
 #include <TVRemoteScreenSDKCommunication/ImageService/IImageServiceServer.h>
 #include <TVRemoteScreenSDKCommunication/ImageService/ServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/SharedFrameBuffer.h>
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 namespace TestImageService
@@ -186,6 +189,113 @@ std::shared_ptr<TVRemoteScreenSDKCommunication::ImageService::IImageServiceServe
 
 	server->SetUpdateImageDefinitionCallback(processImageChanged);
 
+	const auto sharedFrameBuffer = std::make_shared<std::unique_ptr<SharedFrameBuffer>>();
+
+	const auto processAnnounceSharedFrameBuffer = [LogPrefix, sharedFrameBuffer](
+		const std::string& comId,
+		const std::string& name,
+		uint32_t slotCount,
+		uint64_t slotSize,
+		const IImageServiceServer::AnnounceSharedFrameBufferResponseCallback& response)
+	{
+		std::cout
+			<< LogPrefix
+			<< "Received AnnounceSharedFrameBuffer with: "
+			<< comId << "(comId), "
+			<< name << "(name), "
+			<< slotCount << "(slots), "
+			<< slotSize << "(slot bytes)"
+			<< std::endl;
+
+		if (comId != TestData::ComId)
+		{
+			std::cerr << LogPrefix << "Corrupted Data" << std::endl;
+			exit(EXIT_FAILURE);
+		}
+
+		*sharedFrameBuffer = SharedFrameBuffer::Open(name, slotCount, slotSize);
+		if (*sharedFrameBuffer)
+		{
+			response(CallStatus::Ok);
+		}
+		else
+		{
+			response(CallStatus{CallState::Failed, "opening shared frame buffer failed"});
+		}
+	};
+	server->SetAnnounceSharedFrameBufferCallback(processAnnounceSharedFrameBuffer);
+
+	const auto processImageUpdateFromSharedFrameBuffer = [LogPrefix, sharedFrameBuffer](
+		const std::string& comId,
+		int32_t x,
+		int32_t y,
+		int32_t width,
+		int32_t height,
+		uint32_t slot,
+		uint64_t size,
+		const IImageServiceServer::UpdateImageFromSharedFrameBufferResponseCallback& response)
+	{
+		std::cout
+			<< LogPrefix
+			<< "Received ImageUpdateFromSharedFrameBuffer with: "
+			<< comId << "(comId), "
+			<< x << "(x), "
+			<< y << "(y), "
+			<< width << "(w), "
+			<< height << "(h), "
+			<< slot << "(slot), "
+			<< size << "(pic bytes)"
+			<< std::endl;
+
+		const std::unique_ptr<SharedFrameBuffer>& buffer = *sharedFrameBuffer;
+		if (comId == TestData::ComId && x == TestData::X && y == TestData::Y && width == TestData::Width && height == TestData::Height
+			&& buffer && buffer->Slot(slot) && size == TestData::Picture().size() && size <= buffer->GetSlotSize()
+			&& std::memcmp(buffer->Slot(slot), TestData::Picture().data(), size) == 0)
+		{
+			buffer->Release(slot);
+			response(CallStatus::Ok);
+		}
+		else
+		{
+			std::cerr << LogPrefix << "Corrupted Data" << std::endl;
+			exit(EXIT_FAILURE);
+		}
+	};
+	server->SetUpdateImageFromSharedFrameBufferCallback(processImageUpdateFromSharedFrameBuffer);
+
+	const auto processImageRegionsUpdate = [LogPrefix](
+		const std::string& comId,
+		const std::vector<ImageRegion>& regions,
+		const std::string& pictureData,
+		const IImageServiceServer::UpdateImageRegionsResponseCallback& response)
+	{
+		std::cout
+			<< LogPrefix
+			<< "Received ImageRegionsUpdate with: "
+			<< comId << "(comId), "
+			<< regions.size() << "(regions), "
+			<< pictureData.size() << "(pic bytes)"
+			<< std::endl;
+
+		const std::vector<ImageRegion>& expectedRegions = TestData::Regions();
+		const bool regionsMatch = regions.size() == expectedRegions.size()
+			&& std::equal(regions.begin(), regions.end(), expectedRegions.begin(), [](const ImageRegion& lhs, const ImageRegion& rhs)
+				{
+					return lhs.x == rhs.x && lhs.y == rhs.y && lhs.width == rhs.width && lhs.height == rhs.height;
+				});
+
+		if (comId == TestData::ComId && regionsMatch && pictureData == TestData::Picture())
+		{
+			response(CallStatus::Ok);
+		}
+		else
+		{
+			std::cerr << LogPrefix << "Corrupted Data" << std::endl;
+			exit(EXIT_FAILURE);
+		}
+	};
+	server->SetUpdateImageRegionsCallback(processImageRegionsUpdate);
+
 	server->StartServer(TestData::Socket);
 	if (server->GetLocation() != TestData::Socket)
 	{
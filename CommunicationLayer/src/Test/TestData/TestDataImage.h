@@ -26,9 +26,11 @@
 #include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportFramework.h>
 
 #include <TVRemoteScreenSDKCommunication/ImageService/ColorFormat.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/ImageRegion.h>
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace TestImageService
 {
@@ -53,6 +55,14 @@ struct TestData<TVRemoteScreenSDKCommunication::gRPCTransport>
 		static const std::string pic(8294538, '*');
 		return pic;
 	}
+	// the upper and lower half of the image, the picture data holds both
+	static const std::vector<TVRemoteScreenSDKCommunication::ImageService::ImageRegion>& Regions()
+	{
+		static const std::vector<TVRemoteScreenSDKCommunication::ImageService::ImageRegion> regions{
+			{X, Y, Width, Height / 2},
+			{X, Y + Height / 2, Width, Height - Height / 2}};
+		return regions;
+	}
 };
 
 template<>
@@ -73,5 +83,13 @@ struct TestData<TVRemoteScreenSDKCommunication::TCPSocketTransport>
 		static const std::string pic(8294538, '+');
 		return pic;
 	}
+	// the upper and lower half of the image, the picture data holds both
+	static const std::vector<TVRemoteScreenSDKCommunication::ImageService::ImageRegion>& Regions()
+	{
+		static const std::vector<TVRemoteScreenSDKCommunication::ImageService::ImageRegion> regions{
+			{X, Y, Width, Height / 2},
+			{X, Y + Height / 2, Width, Height - Height / 2}};
+		return regions;
+	}
 };
 } // namespace TestImageService
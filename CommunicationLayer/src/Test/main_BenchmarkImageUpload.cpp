@@ -0,0 +1,210 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include <TVRemoteScreenSDKCommunication/ImageService/GrabResultChunks.h>
+
+#include "GrabResult.pb.h"
+
+#include <grpc++/impl/codegen/proto_utils.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+constexpr const char* LogPrefix = "[BenchmarkImageUpload] ";
+
+constexpr int32_t Width = 1920;
+constexpr int32_t Height = 1080;
+constexpr size_t BytesPerPixel = 4;
+constexpr int Iterations = 50;
+
+struct FrameStatistics
+{
+	size_t bytesCopied = 0;
+	size_t bytesSent = 0;
+	std::chrono::microseconds duration{0};
+};
+
+// Bytes of a buffer ready to be sent which do not reference the picture itself.
+size_t CopiedBytes(::grpc::ByteBuffer& buffer, const std::string& picture)
+{
+	std::vector<::grpc::Slice> slices;
+	buffer.Dump(&slices);
+
+	const char* const pictureBegin = picture.data();
+	const char* const pictureEnd = pictureBegin + picture.size();
+
+	size_t copiedBytes = 0;
+	for (const ::grpc::Slice& slice : slices)
+	{
+		const char* const sliceBegin = reinterpret_cast<const char*>(slice.begin());
+		if (sliceBegin < pictureBegin || sliceBegin >= pictureEnd)
+		{
+			copiedBytes += slice.size();
+		}
+	}
+	return copiedBytes;
+}
+
+// Chunks built as messages, the way ImageServicegRPCClient::UpdateImage used to.
+FrameStatistics UploadCopying(const std::string& picture)
+{
+	using TVRemoteScreenSDKCommunication::ImageService::GrabResultChunkSize;
+
+	FrameStatistics statistics;
+	const auto start = std::chrono::steady_clock::now();
+
+	const size_t chunks = (picture.size() + GrabResultChunkSize - 1) / GrabResultChunkSize;
+
+	::tvimageservice::GrabResult request;
+	request.set_chunks(static_cast<uint32_t>(chunks));
+	::tvimageservice::Rect* dirtyRect = request.mutable_dirtyrect();
+	dirtyRect->set_width(Width);
+	dirtyRect->set_height(Height);
+
+	for (size_t chunk = 0; chunk < chunks; ++chunk)
+	{
+		auto buffer = new std::string();
+		buffer->assign(picture.substr(chunk * GrabResultChunkSize, GrabResultChunkSize));
+
+		// one copy by substr and one by assign
+		statistics.bytesCopied += 2 * buffer->size();
+
+		request.mutable_pixeldata()->set_allocated_picture(buffer);
+
+		// what ClientWriter::Write does with the message
+		::grpc::ByteBuffer serialized;
+		bool ownBuffer = false;
+		::grpc::SerializationTraits<::tvimageservice::GrabResult>::Serialize(request, &serialized, &ownBuffer);
+
+		statistics.bytesCopied += CopiedBytes(serialized, picture);
+		statistics.bytesSent += serialized.Length();
+	}
+
+	statistics.duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	return statistics;
+}
+
+FrameStatistics UploadReferencing(const std::string& picture)
+{
+	FrameStatistics statistics;
+	const auto start = std::chrono::steady_clock::now();
+
+	const TVRemoteScreenSDKCommunication::FrameBuffer pictureData =
+		TVRemoteScreenSDKCommunication::FrameBuffer::Unowned(picture.data(), picture.size());
+	std::vector<::grpc::ByteBuffer> chunks =
+		TVRemoteScreenSDKCommunication::ImageService::EncodeGrabResultChunks(0, 0, Width, Height, pictureData);
+
+	for (::grpc::ByteBuffer& chunk : chunks)
+	{
+		statistics.bytesCopied += CopiedBytes(chunk, picture);
+		statistics.bytesSent += chunk.Length();
+	}
+
+	statistics.duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	return statistics;
+}
+
+template<typename Upload>
+FrameStatistics Measure(Upload upload, const std::string& picture)
+{
+	FrameStatistics total;
+	for (int i = 0; i < Iterations; ++i)
+	{
+		const FrameStatistics frame = upload(picture);
+		total.bytesCopied += frame.bytesCopied;
+		total.bytesSent += frame.bytesSent;
+		total.duration += frame.duration;
+	}
+
+	total.bytesCopied /= Iterations;
+	total.bytesSent /= Iterations;
+	total.duration /= Iterations;
+	return total;
+}
+
+void Print(const char* name, const FrameStatistics& statistics)
+{
+	std::cout << LogPrefix << name << ": "
+		<< statistics.bytesCopied << " bytes copied, "
+		<< statistics.bytesSent << " bytes sent, "
+		<< statistics.duration.count() << " us per frame" << std::endl;
+}
+
+// The chunks are sent after the caller has let go of the picture data, e.g. frames in flight on the image stream.
+bool ChunksKeepPictureDataAlive()
+{
+	std::shared_ptr<std::string> picture = std::make_shared<std::string>(static_cast<size_t>(Width) * Height * BytesPerPixel, '\x7f');
+	const std::weak_ptr<std::string> weakPicture = picture;
+
+	std::vector<::grpc::ByteBuffer> chunks = TVRemoteScreenSDKCommunication::ImageService::EncodeGrabResultChunks(
+		0, 0, Width, Height, TVRemoteScreenSDKCommunication::FrameBuffer{picture, picture->data(), picture->size()});
+	picture.reset();
+
+	if (weakPicture.expired())
+	{
+		return false;
+	}
+
+	chunks.clear();
+	return weakPicture.expired();
+}
+
+} // namespace
+
+int main()
+{
+	const std::string picture(static_cast<size_t>(Width) * Height * BytesPerPixel, '\x7f');
+
+	const FrameStatistics copying = Measure(&UploadCopying, picture);
+	const FrameStatistics referencing = Measure(&UploadReferencing, picture);
+
+	Print("message chunks  ", copying);
+	Print("referenced chunks", referencing);
+
+	if (copying.bytesSent != referencing.bytesSent)
+	{
+		std::cerr << LogPrefix << "ERROR: Encodings differ in size" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (referencing.bytesCopied >= picture.size())
+	{
+		std::cerr << LogPrefix << "ERROR: Picture data copied" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (!ChunksKeepPictureDataAlive())
+	{
+		std::cerr << LogPrefix << "ERROR: Chunks do not keep the picture data alive until they are released" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,378 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include <TVRemoteScreenSDKCommunication/ImageService/GrabResultLimits.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/IImageFrameSink.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/IImageServiceClient.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/IImageServiceServer.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/ServiceFactory.h>
+#include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIO/ChannelInterface.h>
+#include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIO/Socket.h>
+
+#include "internal/ImageServiceFunctions.h"
+
+#include "GrabResult.pb.h"
+#include "ImageUpdateResponse.pb.h"
+#include "RegionsGrabResult.pb.h"
+
+#if !defined(_WIN32) && !defined(_WINCE)
+#include <sys/socket.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace TVRemoteScreenSDKCommunication;
+using namespace TVRemoteScreenSDKCommunication::ImageService;
+using namespace Transport::SocketIO;
+
+namespace
+{
+
+constexpr const char* LogPrefix = "[ImageServiceSocketIOServer] ";
+constexpr const char* Location = "tcp+tv://127.0.0.1:9111";
+constexpr const char* ComId = "TestComId";
+
+constexpr uint32_t AnnouncedChunks = 2;
+
+// Counts the frames ending either way.
+class CountingFrameSink : public IImageFrameSink
+{
+public:
+	class Frame : public IImageFrame
+	{
+	public:
+		explicit Frame(CountingFrameSink& sink)
+			: m_sink(sink)
+		{
+		}
+
+		void AddChunk(std::string& /*chunk*/) override
+		{
+		}
+
+		void End(const ResponseCallback& response) override
+		{
+			++m_sink.ended;
+			response(CallStatus::Ok);
+		}
+
+		void Abort() override
+		{
+			++m_sink.aborted;
+		}
+
+	private:
+		CountingFrameSink& m_sink;
+	};
+
+	std::unique_ptr<IImageFrame> BeginFrame(
+		const std::string& /*comId*/,
+		int32_t /*x*/,
+		int32_t /*y*/,
+		int32_t /*width*/,
+		int32_t /*height*/,
+		uint32_t /*chunks*/,
+		size_t /*pictureSizeHint*/) override
+	{
+		if (rejectFrames)
+		{
+			return nullptr;
+		}
+		return std::unique_ptr<IImageFrame>{new Frame{*this}};
+	}
+
+	std::atomic<bool> rejectFrames{false};
+	std::atomic<int> ended{0};
+	std::atomic<int> aborted{0};
+};
+
+// Sends chunkCount chunks of a picture announced to consist of AnnouncedChunks chunks.
+template<typename Message>
+Status SendChunks(Functions function, Message message, uint32_t chunkCount)
+{
+	ChannelInterface channel{Location};
+	const std::unique_ptr<ChannelInterface::ClientStream> stream = channel.OpenStream(ComId, function);
+
+	message.set_chunks(AnnouncedChunks);
+	message.mutable_pixeldata()->set_picture(std::string(1024, '\x7f'));
+
+	std::shared_ptr<std::string> response;
+	for (uint32_t chunk = 0; chunk < chunkCount; ++chunk)
+	{
+		std::shared_ptr<std::string> frame = std::make_shared<std::string>();
+		message.SerializeToString(frame.get());
+
+		const Status status = chunk + 1 < chunkCount
+			? stream->Write(std::move(frame))
+			: stream->Finish(std::move(frame), response);
+		if (!status.ok())
+		{
+			return status;
+		}
+	}
+	return Status::OK;
+}
+
+Status SendImageChunks(uint32_t chunkCount)
+{
+	::tvimageservice::GrabResult message;
+	message.mutable_dirtyrect()->set_width(16);
+	message.mutable_dirtyrect()->set_height(16);
+	return SendChunks(Function_UpdateImage, message, chunkCount);
+}
+
+Status SendRegionsChunks(uint32_t chunkCount)
+{
+	::tvimageservice::RegionsGrabResult message;
+	::tvimageservice::Rect* region = message.add_regions();
+	region->set_width(16);
+	region->set_height(16);
+	return SendChunks(Function_UpdateImageRegions, message, chunkCount);
+}
+
+int TestImageChunks()
+{
+	const std::shared_ptr<IImageServiceServer> server = ServiceFactory::CreateServer<TransportFramework::TCPSocketTransport>();
+	const std::shared_ptr<CountingFrameSink> frameSink = std::make_shared<CountingFrameSink>();
+	server->SetUpdateImageFrameSink(frameSink);
+	if (!server->StartServer(Location))
+	{
+		std::cerr << LogPrefix << "ERROR: Starting server failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (!SendImageChunks(AnnouncedChunks).ok() || frameSink->ended != 1)
+	{
+		std::cerr << LogPrefix << "ERROR: Image update with the announced chunks failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const Status status = SendImageChunks(AnnouncedChunks + 1);
+	if (status.code() != StatusCode::ABORTED || frameSink->ended != 1 || frameSink->aborted != 1)
+	{
+		std::cerr << LogPrefix << "ERROR: Image update with more chunks than announced not rejected" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	frameSink->rejectFrames = true;
+	if (SendImageChunks(AnnouncedChunks).code() != StatusCode::UNAVAILABLE || frameSink->ended != 1)
+	{
+		std::cerr << LogPrefix << "ERROR: Image update rejected by the frame sink not failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Image update with more chunks than announced or rejected by the frame sink failed" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+int TestRegionsChunks()
+{
+	const std::shared_ptr<IImageServiceServer> server = ServiceFactory::CreateServer<TransportFramework::TCPSocketTransport>();
+	std::atomic<int> processed{0};
+	server->SetUpdateImageRegionsCallback([&processed](
+		const std::string& /*comId*/,
+		const std::vector<ImageRegion>& /*regions*/,
+		const std::string& /*pictureData*/,
+		const IImageServiceServer::UpdateImageRegionsResponseCallback& response)
+	{
+		++processed;
+		response(CallStatus::Ok);
+	});
+	if (!server->StartServer(Location))
+	{
+		std::cerr << LogPrefix << "ERROR: Starting server failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (!SendRegionsChunks(AnnouncedChunks).ok() || processed != 1)
+	{
+		std::cerr << LogPrefix << "ERROR: Regions update with the announced chunks failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const Status status = SendRegionsChunks(AnnouncedChunks + 1);
+	if (status.code() != StatusCode::ABORTED || processed != 1)
+	{
+		std::cerr << LogPrefix << "ERROR: Regions update with more chunks than announced not rejected" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Regions update with more chunks than announced rejected" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+struct SocketGuard final
+{
+	~SocketGuard()
+	{
+		CloseSocket(socket);
+	}
+
+	const socket_t socket;
+};
+
+// Listens without a Server, so the test can play a peer of an older release. Accepting times out instead of hanging a failed test.
+socket_t Listen(const char* location)
+{
+	SocketAddress address{};
+	if (!ParseLocationUri(location, address))
+	{
+		return InvalidSocket;
+	}
+
+	const socket_t socket = ::socket(address.family, SocketType, 0);
+	const int reuseAddress = 1;
+	if (socket == InvalidSocket
+		|| ::setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, &reuseAddress, sizeof(reuseAddress)) != 0
+		|| ::bind(socket, address.get(), address.length) != 0
+		|| ::listen(socket, MaxBacklogSize) != 0
+		|| !SetSocketTimeouts(socket, std::chrono::seconds{5}))
+	{
+		CloseSocket(socket);
+		return InvalidSocket;
+	}
+
+	return socket;
+}
+
+// Whether the request is a single message carrying the whole picture.
+bool ReceivedWholePicture(const Envelope& request, const std::string& picture)
+{
+	if (request.functionId == Function_UpdateImage)
+	{
+		::tvimageservice::GrabResult message;
+		return message.ParseFromString(*request.data) && message.chunks() == 1
+			&& message.dirtyrect().width() == 16 && message.pixeldata().picture() == picture;
+	}
+
+	::tvimageservice::RegionsGrabResult message;
+	return message.ParseFromString(*request.data) && message.chunks() == 1
+		&& message.regions_size() == 1 && message.pixeldata().picture() == picture;
+}
+
+int TestLegacyPeer()
+{
+	const socket_t listener = Listen(Location);
+	if (listener == InvalidSocket)
+	{
+		std::cerr << LogPrefix << "ERROR: Listening failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const SocketGuard listenerGuard{listener};
+
+	// larger than one chunk, every byte depends on its position
+	std::string picture(2 * GrabResultChunkSize + 1024, '\0');
+	for (size_t i = 0; i < picture.size(); ++i)
+	{
+		picture[i] = static_cast<char>(i % 251);
+	}
+
+	std::atomic<int> wholePictures{0};
+	std::thread peer{[&]()
+	{
+		// drops the connection on the handshake like peers predating it do
+		{
+			const socket_t endpoint = ::accept(listener, nullptr, nullptr);
+			const SocketGuard endpointGuard{endpoint};
+			FrameReader reader{endpoint};
+			uint32_t magic = 0;
+			if (!reader.ReceivePreamble(magic).ok() || magic != MagicHandshake)
+			{
+				return;
+			}
+		}
+
+		const socket_t endpoint = ::accept(listener, nullptr, nullptr);
+		const SocketGuard endpointGuard{endpoint};
+		FrameReader reader{endpoint};
+
+		::tvimageservice::ImageUpdateResponse response;
+		Envelope responseEnvelope{};
+		responseEnvelope.comId = ComId;
+		responseEnvelope.data = std::make_shared<std::string>(response.SerializeAsString());
+
+		Envelope request{};
+		for (int call = 0; call < 2 && reader.ReceivePreamble().ok() && reader.ReceiveEnvelope(request).ok(); ++call)
+		{
+			if (ReceivedWholePicture(request, picture))
+			{
+				++wholePictures;
+			}
+
+			responseEnvelope.functionId = request.functionId;
+			if (!SendEnvelope(endpoint, responseEnvelope, ProtocolRevision_Legacy).ok())
+			{
+				return;
+			}
+		}
+	}};
+
+	bool callsSucceeded = false;
+	{
+		const std::unique_ptr<IImageServiceClient> client = ServiceFactory::CreateClient<TransportFramework::TCPSocketTransport>();
+		client->StartClient(Location);
+
+		const ImageRegion region{0, 0, 16, 16};
+		callsSucceeded = client->UpdateImage(ComId, 0, 0, 16, 16, picture).IsOk()
+			&& client->UpdateImageRegions(ComId, {region}, picture).IsOk();
+	}
+
+	peer.join();
+
+	if (!callsSucceeded || wholePictures != 2)
+	{
+		std::cerr << LogPrefix << "ERROR: Peer not supporting streams did not receive the whole picture" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Peer not supporting streams received the whole picture" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main()
+{
+	if (TestImageChunks() == EXIT_FAILURE)
+	{
+		return EXIT_FAILURE;
+	}
+
+	if (TestRegionsChunks() == EXIT_FAILURE)
+	{
+		return EXIT_FAILURE;
+	}
+
+	if (TestLegacyPeer() == EXIT_FAILURE)
+	{
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
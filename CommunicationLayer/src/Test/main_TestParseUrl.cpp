@@ -61,6 +61,10 @@ const TestCase TestDataCorrect[] = {
 	{ "tv+tcp://myhost:2"                   , { "tv+tcp"  , "myhost"          , 2    , ""                   }, TCPSocketTransport },
 	{ "tv+tcp://myhost"                     , { "tv+tcp"  , "myhost"          , 0    , ""                   }, TCPSocketTransport },
 	{ "tcp+tv+2://192.168.52.1:999"         , { "tcp+tv+2", "192.168.52.1"    , 999  , ""                   }, UnknownTransport   },
+	{ "unix+tv:///tmp/tv.sock"              , { "unix+tv" , ""                , 0    , "/tmp/tv.sock"       }, TCPSocketTransport },
+	{ "UNIX+TV:///tmp/tv.sock"              , { "unix+tv" , ""                , 0    , "/tmp/tv.sock"       }, TCPSocketTransport },
+	{ "tv+unix:///tmp/TVQtRC/input/"        , { "tv+unix" , ""                , 0    , "/tmp/TVQtRC/input/" }, TCPSocketTransport },
+	{ "unix+tv+0:///tmp/tv.sock"            , { "unix+tv+0", ""               , 0    , "/tmp/tv.sock"       }, UnknownTransport   },
 };
 
 const std::string TestUrlsMalformed[] = {
@@ -0,0 +1,201 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIO/ChannelInterface.h>
+#include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIO/Server.h>
+#include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIO/Service.h>
+
+#include "Envelope.pb.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+
+using namespace TVRemoteScreenSDKCommunication::Transport::SocketIO;
+
+// The allocation counter replaces the global operator new of the whole executable,
+// which is why this test does not share its executable with the others.
+namespace
+{
+
+// allocations of all threads, the ones of the server included, counted while enabled
+std::atomic<bool> CountAllocations{false};
+std::atomic<size_t> Allocations{0};
+std::atomic<size_t> AllocatedBytes{0};
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+	if (CountAllocations)
+	{
+		++Allocations;
+		AllocatedBytes += size;
+	}
+
+	if (void* memory = std::malloc(size == 0 ? 1 : size))
+	{
+		return memory;
+	}
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+namespace
+{
+
+constexpr const char* LogPrefix = "[SocketIOAllocations] ";
+constexpr const char* Location = "tcp+tv://127.0.0.1:9102";
+constexpr const char* ComId = "TestComId";
+
+constexpr int64_t Function_Echo = 1;
+
+class EchoService final : public Service
+{
+public:
+	// called by Echo before answering, like a service function calling into another server on the same thread
+	Server::ServerFunction nestedFunction;
+
+	Status Echo(ServerContext* context, const tvsocketservicebase::Envelope* request, tvsocketservicebase::Envelope* response)
+	{
+		if (context->client_metadata().empty())
+		{
+			return {StatusCode::FAILED_PRECONDITION, "no com id"};
+		}
+		if (nestedFunction)
+		{
+			tvsocketservicebase::Envelope nestedRequest;
+			nestedRequest.set_data("nested");
+			const Status nestedStatus = nestedFunction(
+				ComId, std::make_shared<std::string>(nestedRequest.SerializeAsString()), std::make_shared<std::string>());
+			if (!nestedStatus.ok())
+			{
+				return nestedStatus;
+			}
+		}
+		response->set_call_id(request->call_id());
+		response->set_data(request->data());
+		return Status::OK;
+	}
+
+protected:
+	void Register(Server::ServerFunctionMap& functions) override
+	{
+		functions[Function_Echo] = MakeServerFunction(&EchoService::Echo);
+	}
+};
+
+int TestRoundTripAllocations()
+{
+	constexpr size_t WarmupCalls = 10;
+	constexpr size_t MeasuredCalls = 100;
+	constexpr size_t PayloadSize = 16 * 1024;
+
+	EchoService service;
+	Server server{service.RegisteredFunctions()};
+	if (!server.Start(Location))
+	{
+		std::cerr << LogPrefix << "ERROR: Starting server failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	ChannelInterface channel{Location};
+
+	tvsocketservicebase::Envelope message;
+	message.set_data(std::string(PayloadSize, 'x'));
+	const auto requestRaw = std::make_shared<std::string>();
+
+	for (size_t call = 0; call < WarmupCalls + MeasuredCalls; ++call)
+	{
+		message.set_call_id(call);
+		message.SerializeToString(requestRaw.get());
+		std::shared_ptr<std::string> request = requestRaw;
+
+		CountAllocations = call >= WarmupCalls;
+		std::shared_ptr<std::string> responseRaw;
+		const Status status = channel.Call(ComId, Function_Echo, std::move(request), responseRaw);
+		CountAllocations = false;
+
+		tvsocketservicebase::Envelope response;
+		if (!status.ok() || !responseRaw || !response.ParseFromString(*responseRaw)
+			|| response.call_id() != call || response.data() != message.data())
+		{
+			std::cerr << LogPrefix << "ERROR: Call " << call << " failed: " << status.error_message() << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	// Client and server keep their payload buffers, only small bookkeeping like com id and status is allocated per call.
+	const size_t allocatedBytesPerCall = AllocatedBytes / MeasuredCalls;
+	std::cout << LogPrefix << Allocations / MeasuredCalls << " allocations, " << allocatedBytesPerCall << " bytes per call" << std::endl;
+	if (allocatedBytesPerCall >= PayloadSize / 4)
+	{
+		std::cerr << LogPrefix << "ERROR: Payload allocated per call" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+int TestNestedServerFunction()
+{
+	EchoService innerService;
+	EchoService outerService;
+	outerService.nestedFunction = innerService.RegisteredFunctions()[Function_Echo];
+	const Server::ServerFunction outerFunction = outerService.RegisteredFunctions()[Function_Echo];
+
+	tvsocketservicebase::Envelope message;
+	message.set_call_id(42);
+	message.set_data("outer");
+
+	const auto responseRaw = std::make_shared<std::string>();
+	tvsocketservicebase::Envelope response;
+	const Status status = outerFunction(ComId, std::make_shared<std::string>(message.SerializeAsString()), responseRaw);
+	if (!status.ok() || !response.ParseFromString(*responseRaw)
+		|| response.call_id() != message.call_id() || response.data() != message.data())
+	{
+		std::cerr << LogPrefix << "ERROR: Nested call of a server function of the same type cleared the outer request" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Nested server function kept the outer request" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main()
+{
+	if (TestRoundTripAllocations() == EXIT_FAILURE)
+	{
+		return EXIT_FAILURE;
+	}
+
+	return TestNestedServerFunction();
+}
@@ -0,0 +1,1253 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIO/ChannelInterface.h>
+#include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIO/Server.h>
+#include <TVRemoteScreenSDKCommunication/ServiceBase/SocketIO/Socket.h>
+
+#if !defined(_WIN32) && !defined(_WINCE)
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace TVRemoteScreenSDKCommunication::Transport::SocketIO;
+using TVRemoteScreenSDKCommunication::FrameBuffer;
+
+namespace
+{
+
+constexpr const char* LogPrefix = "[SocketIOServer] ";
+constexpr const char* TcpLocation = "tcp+tv://127.0.0.1:9101";
+constexpr const char* UnixLocation = "unix+tv:///tmp/tvSocketIOServerTest";
+constexpr const char* ComId = "TestComId";
+
+constexpr int64_t Function_Echo = 1;
+constexpr int64_t Function_Slow = 2;
+constexpr int64_t Function_Stream = 3;
+
+constexpr std::chrono::milliseconds SlowFunctionDuration{500};
+
+Server::ServerFunctionMap TestFunctions()
+{
+	Server::ServerFunctionMap functions;
+	functions[Function_Echo] = [](
+		const std::string& /*comId*/,
+		std::shared_ptr<std::string> request,
+		std::shared_ptr<std::string> response)
+	{
+		response->swap(*request);
+		return Status::OK;
+	};
+	functions[Function_Slow] = [](
+		const std::string& /*comId*/,
+		std::shared_ptr<std::string> request,
+		std::shared_ptr<std::string> response)
+	{
+		std::this_thread::sleep_for(SlowFunctionDuration);
+		response->swap(*request);
+		return Status::OK;
+	};
+	return functions;
+}
+
+// lets calls on one connection overtake each other, by default they are handled in order
+Server::DispatchPolicyMap ConcurrentPolicies()
+{
+	Server::DispatchPolicyMap dispatchPolicies;
+	dispatchPolicies[Function_Echo] = Server::DispatchPolicy::Concurrent;
+	dispatchPolicies[Function_Slow] = Server::DispatchPolicy::Concurrent;
+	return dispatchPolicies;
+}
+
+bool CallEcho(ChannelInterface& channel, int64_t functionId, const std::string& payload)
+{
+	std::shared_ptr<std::string> response;
+	const Status status = channel.Call(ComId, functionId, std::make_shared<std::string>(payload), response);
+	return status.ok() && response && *response == payload;
+}
+
+int TestRequestOrder(const char* location)
+{
+	Server server{TestFunctions()};
+	if (!server.Start(location))
+	{
+		std::cerr << LogPrefix << "ERROR: Starting server failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	ChannelInterface channel{location};
+	for (int i = 0; i < 100; ++i)
+	{
+		if (!CallEcho(channel, Function_Echo, std::to_string(i)))
+		{
+			std::cerr << LogPrefix << "ERROR: Unexpected response for request " << i << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	std::cout << LogPrefix << "OK: Responses received in request order" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+int TestLargePayload(const char* location)
+{
+	Server server{TestFunctions()};
+	if (!server.Start(location))
+	{
+		std::cerr << LogPrefix << "ERROR: Starting server failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// larger than the socket buffers, so the envelope is written in several parts
+	std::string payload(8 * 1024 * 1024, '\0');
+	for (size_t i = 0; i < payload.size(); ++i)
+	{
+		payload[i] = static_cast<char>(i % 251);
+	}
+
+	ChannelInterface channel{location};
+	if (!CallEcho(channel, Function_Echo, payload))
+	{
+		std::cerr << LogPrefix << "ERROR: Unexpected response for large payload" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Large payload transferred" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+int TestLongStatusMessage(const char* location)
+{
+	constexpr int64_t Function_Fail = 4;
+	Server::ServerFunctionMap functions = TestFunctions();
+	functions[Function_Fail] = [](
+		const std::string& /*comId*/,
+		std::shared_ptr<std::string> /*request*/,
+		std::shared_ptr<std::string> /*response*/)
+	{
+		return Status{StatusCode::LOGIC_ERROR, std::string(BinaryHeaderMaxStringSize, 'x')};
+	};
+
+	Server server{std::move(functions)};
+	if (!server.Start(location))
+	{
+		std::cerr << LogPrefix << "ERROR: Starting server failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// the message is cut to fit into the header the client is able to read, the connection stays usable
+	ChannelInterface channel{location};
+	std::shared_ptr<std::string> response;
+	const Status status = channel.Call(ComId, Function_Fail, std::make_shared<std::string>("fail"), response);
+	const size_t longestMessage = BinaryHeaderMaxSize - BinaryHeaderFixedSize - sizeof(uint16_t) - std::string{ComId}.size();
+	if (status.code() != StatusCode::LOGIC_ERROR || status.error_message() != std::string(longestMessage, 'x'))
+	{
+		std::cerr << LogPrefix << "ERROR: Unexpected status for long status message" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (!CallEcho(channel, Function_Echo, "after long status message"))
+	{
+		std::cerr << LogPrefix << "ERROR: Connection unusable after long status message" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Long status message cut to fit the header" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+int TestSocketOptions(const char* location)
+{
+	// chunks far smaller than the payload, so it is read with many system calls
+	SocketOptions socketOptions;
+	socketOptions.chunkSize = 4096;
+	socketOptions.sendReceiveTimeout = std::chrono::milliseconds{2500};
+	socketOptions.maxBacklogSize = 4;
+	socketOptions.sendBufferSize = 256 * 1024;
+	socketOptions.receiveBufferSize = 256 * 1024;
+	socketOptions.noDelay = true;
+
+	Server server{TestFunctions(), Server::ConnectionMode::Multiplexed, DefaultWorkerThreads, {}, socketOptions};
+	if (!server.Start(location))
+	{
+		std::cerr << LogPrefix << "ERROR: Starting server with socket options failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::string payload(1024 * 1024 + 1, '\0');
+	for (size_t i = 0; i < payload.size(); ++i)
+	{
+		payload[i] = static_cast<char>(i % 251);
+	}
+
+	ChannelInterface channel{location, ConnectionPolicy{}, socketOptions};
+	if (!CallEcho(channel, Function_Echo, payload) || !CallEcho(channel, Function_Echo, "small"))
+	{
+		std::cerr << LogPrefix << "ERROR: Unexpected response with socket options" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Payload transferred with socket options" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+int TestConcurrentClients(const char* location)
+{
+	Server server{TestFunctions()};
+	if (!server.Start(location))
+	{
+		std::cerr << LogPrefix << "ERROR: Starting server failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	ChannelInterface slowChannel{location};
+	ChannelInterface fastChannel{location};
+
+	// connect the slow client first so a sequential server would be stuck serving it
+	if (!CallEcho(slowChannel, Function_Echo, "connect"))
+	{
+		std::cerr << LogPrefix << "ERROR: Connecting first client failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::atomic<bool> slowCallSucceeded{false};
+	std::atomic<bool> slowCallDone{false};
+	std::thread slowCaller{[&]()
+	{
+		slowCallSucceeded = CallEcho(slowChannel, Function_Slow, "slow");
+		slowCallDone = true;
+	}};
+
+	std::this_thread::sleep_for(SlowFunctionDuration / 5);
+
+	const bool fastCallSucceeded = CallEcho(fastChannel, Function_Echo, "fast");
+	const bool fastCallOvertook = !slowCallDone;
+
+	slowCaller.join();
+
+	if (!fastCallSucceeded || !slowCallSucceeded)
+	{
+		std::cerr << LogPrefix << "ERROR: Concurrent calls failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (!fastCallOvertook)
+	{
+		std::cerr << LogPrefix << "ERROR: Second client was blocked by the first one" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Second client served while first one is busy" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+int TestMultiplexedCalls(const char* location)
+{
+	Server server{TestFunctions(), Server::ConnectionMode::Multiplexed, DefaultWorkerThreads, ConcurrentPolicies()};
+	if (!server.Start(location))
+	{
+		std::cerr << LogPrefix << "ERROR: Starting server failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	ChannelInterface channel{location};
+
+	std::atomic<bool> slowCallSucceeded{false};
+	std::atomic<bool> slowCallDone{false};
+	std::thread slowCaller{[&]()
+	{
+		slowCallSucceeded = CallEcho(channel, Function_Slow, "slow");
+		slowCallDone = true;
+	}};
+
+	std::this_thread::sleep_for(SlowFunctionDuration / 5);
+
+	bool fastCallsSucceeded = true;
+	for (int i = 0; i < 10; ++i)
+	{
+		fastCallsSucceeded = CallEcho(channel, Function_Echo, std::to_string(i)) && fastCallsSucceeded;
+	}
+	const bool fastCallsOvertook = !slowCallDone;
+
+	slowCaller.join();
+
+	if (!fastCallsSucceeded || !slowCallSucceeded)
+	{
+		std::cerr << LogPrefix << "ERROR: Multiplexed calls failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (!fastCallsOvertook)
+	{
+		std::cerr << LogPrefix << "ERROR: Calls on one channel were blocked by a pending call" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Calls on one channel served while another one is pending" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+int TestPipelinedRequests(const char* location)
+{
+	Server server{TestFunctions()};
+	if (!server.Start(location))
+	{
+		std::cerr << LogPrefix << "ERROR: Starting server failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	ChannelInterface channel{location};
+
+	// requests of several callers queue up on the connection and are read in blocks by the server
+	std::atomic<int> failedCalls{0};
+	std::vector<std::thread> callers;
+	for (int callerIndex = 0; callerIndex < 8; ++callerIndex)
+	{
+		callers.emplace_back([&, callerIndex]()
+		{
+			for (int i = 0; i < 50; ++i)
+			{
+				if (!CallEcho(channel, Function_Echo, std::to_string(callerIndex) + ":" + std::to_string(i)))
+				{
+					++failedCalls;
+				}
+			}
+		});
+	}
+
+	for (std::thread& caller : callers)
+	{
+		caller.join();
+	}
+
+	if (failedCalls != 0)
+	{
+		std::cerr << LogPrefix << "ERROR: " << failedCalls << " pipelined calls failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Pipelined requests answered" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+struct SocketGuard final
+{
+	~SocketGuard()
+	{
+		CloseSocket(socket);
+	}
+
+	const socket_t socket;
+};
+
+socket_t Connect(const char* location)
+{
+	SocketAddress address{};
+	if (!ParseLocationUri(location, address))
+	{
+		return InvalidSocket;
+	}
+
+	const socket_t socket = ::socket(address.family, SocketType, 0);
+	if (socket != InvalidSocket && ::connect(socket, address.get(), address.length) != 0)
+	{
+		CloseSocket(socket);
+		return InvalidSocket;
+	}
+
+	return socket;
+}
+
+bool NegotiateRevision(socket_t socket, FrameReader& reader, uint32_t protocolRevision)
+{
+	if (protocolRevision == ProtocolRevision_Legacy)
+	{
+		return true;
+	}
+
+	uint32_t agreedRevision = ProtocolRevision_Legacy;
+	return SendHandshake(socket, protocolRevision).ok()
+		&& reader.ReceiveHandshake(agreedRevision).ok()
+		&& agreedRevision == protocolRevision;
+}
+
+// Talks to the server with the raw framing functions, the way peers of older releases do.
+bool CallWithRevision(const char* location, uint32_t protocolRevision, const std::string& payload)
+{
+	const socket_t socket = Connect(location);
+	if (socket == InvalidSocket)
+	{
+		return false;
+	}
+	const SocketGuard socketGuard{socket};
+
+	FrameReader reader{socket};
+	if (!NegotiateRevision(socket, reader, protocolRevision))
+	{
+		return false;
+	}
+
+	Envelope request{};
+	request.comId = ComId;
+	request.functionId = Function_Echo;
+	request.callId = 42;
+	request.data = std::make_shared<std::string>(payload);
+	if (!SendPreambleAndEnvelope(socket, request, protocolRevision).ok())
+	{
+		return false;
+	}
+
+	// responses are sent without preamble
+	Envelope response{};
+	if (!reader.ReceiveEnvelope(response).ok())
+	{
+		return false;
+	}
+
+	return response.statusCode == static_cast<uint32_t>(StatusCode::OK)
+		&& response.callId == request.callId
+		&& response.comId == request.comId
+		&& response.data && *response.data == payload;
+}
+
+// Listens without a Server, so tests can play a misbehaving peer. Accepting times out instead of hanging a failed test.
+socket_t Listen(const char* location)
+{
+	SocketAddress address{};
+	if (!ParseLocationUri(location, address))
+	{
+		return InvalidSocket;
+	}
+
+	if (!address.path.empty())
+	{
+		::unlink(address.path.c_str());
+	}
+
+	const socket_t socket = ::socket(address.family, SocketType, 0);
+	const int reuseAddress = 1;
+	if (socket == InvalidSocket
+		|| ::setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, &reuseAddress, sizeof(reuseAddress)) != 0
+		|| ::bind(socket, address.get(), address.length) != 0
+		|| ::listen(socket, MaxBacklogSize) != 0
+		|| !SetSocketTimeouts(socket, std::chrono::seconds{5}))
+	{
+		CloseSocket(socket);
+		return InvalidSocket;
+	}
+
+	return socket;
+}
+
+Envelope MakeResponse(const Envelope& request, uint64_t callId)
+{
+	Envelope response{};
+	response.comId = request.comId;
+	response.functionId = request.functionId;
+	response.callId = callId;
+	response.data = request.data;
+	return response;
+}
+
+int TestUnexpectedResponses(const char* location)
+{
+	const socket_t listener = Listen(location);
+	if (listener == InvalidSocket)
+	{
+		std::cerr << LogPrefix << "ERROR: Listening failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const SocketGuard listenerGuard{listener};
+
+	// answers every request with the response of an unknown call first
+	std::thread peer{[listener]()
+	{
+		const socket_t endpoint = ::accept(listener, nullptr, nullptr);
+		if (endpoint == InvalidSocket)
+		{
+			return;
+		}
+		const SocketGuard endpointGuard{endpoint};
+
+		FrameReader reader{endpoint};
+		uint32_t magic = 0;
+		uint32_t protocolRevision = ProtocolRevision_Legacy;
+		if (!reader.ReceivePreamble(magic).ok() || magic != MagicHandshake || !reader.AcceptHandshake(protocolRevision).ok())
+		{
+			return;
+		}
+
+		Envelope request{};
+		while (reader.ReceivePreamble().ok() && reader.ReceiveEnvelope(request).ok())
+		{
+			if (!SendEnvelope(endpoint, MakeResponse(request, request.callId + 1000), protocolRevision).ok()
+				|| !SendEnvelope(endpoint, MakeResponse(request, request.callId), protocolRevision).ok())
+			{
+				return;
+			}
+		}
+	}};
+
+	bool callsSucceeded = true;
+	{
+		ChannelInterface channel{location};
+		for (int i = 0; i < 3; ++i)
+		{
+			callsSucceeded = CallEcho(channel, Function_Echo, std::to_string(i)) && callsSucceeded;
+		}
+	}
+
+	peer.join();
+
+	if (!callsSucceeded)
+	{
+		std::cerr << LogPrefix << "ERROR: Response of an unknown call broke the connection" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Responses of unknown calls dropped" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+int TestHandshakeFallback(const char* location)
+{
+	const socket_t listener = Listen(location);
+	if (listener == InvalidSocket)
+	{
+		std::cerr << LogPrefix << "ERROR: Listening failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const SocketGuard listenerGuard{listener};
+
+	std::atomic<bool> handshakeRepeated{false};
+	std::atomic<bool> legacyServed{false};
+	std::thread peer{[&]()
+	{
+		// first connection: the handshake stays unanswered until the client gives up
+		{
+			const socket_t endpoint = ::accept(listener, nullptr, nullptr);
+			const SocketGuard endpointGuard{endpoint};
+			char byte = 0;
+			while (::recv(endpoint, &byte, sizeof(byte), 0) > 0)
+			{
+			}
+		}
+
+		// second connection: a timeout is no reason to give up the handshake,
+		// this time the peer drops the connection on it like peers predating it do
+		{
+			const socket_t endpoint = ::accept(listener, nullptr, nullptr);
+			const SocketGuard endpointGuard{endpoint};
+			FrameReader reader{endpoint};
+			uint32_t magic = 0;
+			handshakeRepeated = reader.ReceivePreamble(magic).ok() && magic == MagicHandshake;
+		}
+
+		// third connection: the legacy revision without handshake
+		const socket_t endpoint = ::accept(listener, nullptr, nullptr);
+		const SocketGuard endpointGuard{endpoint};
+		FrameReader reader{endpoint};
+		uint32_t magic = 0;
+		Envelope request{};
+		legacyServed = reader.ReceivePreamble(magic).ok() && magic == MagicPreamble
+			&& reader.ReceiveEnvelope(request).ok()
+			&& SendEnvelope(endpoint, MakeResponse(request, request.callId), ProtocolRevision_Legacy).ok();
+	}};
+
+	ConnectionPolicy policy{};
+	policy.maxAttempts = 1;
+	policy.failureThreshold = 0;
+
+	SocketOptions socketOptions{};
+	socketOptions.sendReceiveTimeout = SlowFunctionDuration / 5;
+
+	bool timedOutCallFailed = false;
+	bool legacyCallSucceeded = false;
+	{
+		ChannelInterface channel{location, policy, socketOptions};
+		timedOutCallFailed = !CallEcho(channel, Function_Echo, "unanswered handshake");
+		legacyCallSucceeded = CallEcho(channel, Function_Echo, "legacy");
+	}
+
+	peer.join();
+
+	if (!timedOutCallFailed || !handshakeRepeated)
+	{
+		std::cerr << LogPrefix << "ERROR: Handshake timeout downgraded the channel" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (!legacyCallSucceeded || !legacyServed)
+	{
+		std::cerr << LogPrefix << "ERROR: Rejected handshake not followed by legacy connection" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Only a rejected handshake falls back to the legacy revision" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+int TestCallDeadline(const char* location)
+{
+	const socket_t listener = Listen(location);
+	if (listener == InvalidSocket)
+	{
+		std::cerr << LogPrefix << "ERROR: Listening failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const SocketGuard listenerGuard{listener};
+
+	// first connection answers the handshake but never a request, the second one not even the handshake
+	std::thread peer{[listener]()
+	{
+		for (const bool answerHandshake : {true, false})
+		{
+			const socket_t endpoint = ::accept(listener, nullptr, nullptr);
+			const SocketGuard endpointGuard{endpoint};
+
+			FrameReader reader{endpoint};
+			uint32_t magic = 0;
+			uint32_t protocolRevision = ProtocolRevision_Legacy;
+			if (answerHandshake
+				&& (!reader.ReceivePreamble(magic).ok() || !reader.AcceptHandshake(protocolRevision).ok()))
+			{
+				return;
+			}
+
+			char byte = 0;
+			while (::recv(endpoint, &byte, sizeof(byte), 0) > 0)
+			{
+			}
+		}
+	}};
+
+	ConnectionPolicy policy{};
+	policy.maxAttempts = 1;
+	policy.failureThreshold = 0;
+	policy.deadline = SlowFunctionDuration / 2;
+
+	// the socket timeouts alone would let the calls wait far longer
+	SocketOptions socketOptions{};
+	socketOptions.sendReceiveTimeout = SlowFunctionDuration * 10;
+
+	std::chrono::steady_clock::duration unansweredCallDuration{};
+	std::chrono::steady_clock::duration unansweredHandshakeDuration{};
+	bool callsFailed = true;
+	for (std::chrono::steady_clock::duration* duration : {&unansweredCallDuration, &unansweredHandshakeDuration})
+	{
+		ChannelInterface channel{location, policy, socketOptions};
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		callsFailed = !CallEcho(channel, Function_Echo, "unanswered") && callsFailed;
+		*duration = std::chrono::steady_clock::now() - start;
+	}
+
+	peer.join();
+
+	const std::chrono::steady_clock::duration maxDuration = policy.deadline + SlowFunctionDuration;
+	if (!callsFailed || unansweredCallDuration > maxDuration || unansweredHandshakeDuration > maxDuration)
+	{
+		std::cerr << LogPrefix << "ERROR: Call not bounded by the deadline of the connection policy" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Deadline bounds connecting and waiting for the response" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+int TestProtocolRevisions(const char* location)
+{
+	Server server{TestFunctions()};
+	if (!server.Start(location))
+	{
+		std::cerr << LogPrefix << "ERROR: Starting server failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	for (const uint32_t protocolRevision : {ProtocolRevision_Legacy, ProtocolRevision_CallId, ProtocolRevision_BinaryHeader})
+	{
+		if (!CallWithRevision(location, protocolRevision, "revision " + std::to_string(protocolRevision)))
+		{
+			std::cerr << LogPrefix << "ERROR: Call with protocol revision " << protocolRevision << " failed" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	std::cout << LogPrefix << "OK: All protocol revisions served" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+void AppendUInt32(std::string& frame, uint32_t value)
+{
+	const uint32_t networkValue = htonl(value);
+	frame.append(reinterpret_cast<const char*>(&networkValue), sizeof(networkValue));
+}
+
+bool SendRaw(socket_t socket, const char* data, size_t size)
+{
+	while (size > 0)
+	{
+		const ssize_t sentSize = ::send(socket, data, size, MSG_NOSIGNAL);
+		if (sentSize <= 0)
+		{
+			return false;
+		}
+
+		data += sentSize;
+		size -= static_cast<size_t>(sentSize);
+	}
+	return true;
+}
+
+int TestStalledClient(const char* location)
+{
+	// a single worker, which a blocking read of the stalled request would occupy
+	Server server{TestFunctions(), Server::ConnectionMode::Multiplexed, 1};
+	if (!server.Start(location))
+	{
+		std::cerr << LogPrefix << "ERROR: Starting server failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const socket_t socket = Connect(location);
+	if (socket == InvalidSocket)
+	{
+		std::cerr << LogPrefix << "ERROR: Connecting stalling client failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const SocketGuard socketGuard{socket};
+
+	// legacy framing written by hand, so the request can be cut off mid-payload
+	Envelope request{};
+	request.comId = ComId;
+	request.functionId = Function_Echo;
+
+	std::string payload(4 * ReadBufferSize, '\0');
+	for (size_t i = 0; i < payload.size(); ++i)
+	{
+		payload[i] = static_cast<char>(i % 251);
+	}
+
+	const std::string metaData = request.SerializeMetaData();
+	std::string frame;
+	AppendUInt32(frame, MagicPreamble);
+	AppendUInt32(frame, MagicNumber);
+	AppendUInt32(frame, static_cast<uint32_t>(metaData.size()));
+	frame += metaData;
+	AppendUInt32(frame, static_cast<uint32_t>(payload.size()));
+	frame += payload;
+
+	const size_t stallPosition = frame.size() - payload.size() + ReadBufferSize + 1;
+	if (!SendRaw(socket, frame.data(), stallPosition))
+	{
+		std::cerr << LogPrefix << "ERROR: Sending first part of request failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// longer than the send timeout of the server sockets
+	const auto stallEnd = std::chrono::steady_clock::now() + std::chrono::seconds{SendReceiveTimeout} + SlowFunctionDuration;
+
+	ChannelInterface channel{location};
+	if (!CallEcho(channel, Function_Echo, "while stalled"))
+	{
+		std::cerr << LogPrefix << "ERROR: Client blocked by a stalled request" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::this_thread::sleep_until(stallEnd);
+
+	if (!SendRaw(socket, frame.data() + stallPosition, frame.size() - stallPosition))
+	{
+		std::cerr << LogPrefix << "ERROR: Sending rest of request failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	FrameReader reader{socket};
+	Envelope response{};
+	if (!reader.ReceiveEnvelope(response).ok() || !response.data || *response.data != payload)
+	{
+		std::cerr << LogPrefix << "ERROR: Unexpected response for stalled request" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Stalled request resumed without blocking other clients" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+int TestDispatchPolicies(const char* location)
+{
+	constexpr int64_t Function_Ordered = 3;
+	constexpr int64_t Function_LatestOnly = 4;
+	constexpr uint64_t OrderedRequestCount = 20;
+
+	std::mutex handledMutex;
+	std::vector<std::string> handledOrdered;
+	std::vector<std::string> handledLatestOnly;
+
+	Server::ServerFunctionMap functions;
+	functions[Function_Ordered] = [&](
+		const std::string& /*comId*/,
+		std::shared_ptr<std::string> request,
+		std::shared_ptr<std::string> response)
+	{
+		// gives concurrently dispatched requests a chance to overtake each other
+		std::this_thread::sleep_for(std::chrono::milliseconds{2});
+		const std::lock_guard<std::mutex> lock{handledMutex};
+		handledOrdered.push_back(*request);
+		response->swap(*request);
+		return Status::OK;
+	};
+	functions[Function_LatestOnly] = [&](
+		const std::string& /*comId*/,
+		std::shared_ptr<std::string> request,
+		std::shared_ptr<std::string> response)
+	{
+		// the following updates queue up while the first one is handled
+		std::this_thread::sleep_for(SlowFunctionDuration);
+		const std::lock_guard<std::mutex> lock{handledMutex};
+		handledLatestOnly.push_back(*request);
+		response->swap(*request);
+		return Status::OK;
+	};
+
+	// Function_Ordered gets the default policy
+	Server::DispatchPolicyMap dispatchPolicies;
+	dispatchPolicies[Function_LatestOnly] = Server::DispatchPolicy::LatestOnly;
+
+	Server server{std::move(functions), Server::ConnectionMode::Multiplexed, DefaultWorkerThreads, std::move(dispatchPolicies)};
+	if (!server.Start(location))
+	{
+		std::cerr << LogPrefix << "ERROR: Starting server failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const socket_t socket = Connect(location);
+	if (socket == InvalidSocket)
+	{
+		std::cerr << LogPrefix << "ERROR: Connecting failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const SocketGuard socketGuard{socket};
+
+	FrameReader reader{socket};
+	if (!NegotiateRevision(socket, reader, CurrentProtocolRevision))
+	{
+		std::cerr << LogPrefix << "ERROR: Handshake failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// all requests are pipelined without waiting for responses
+	const std::vector<std::string> updates = {"first", "second", "third", "last"};
+	uint64_t callId = 0;
+	bool sendSucceeded = true;
+	for (const std::string& update : updates)
+	{
+		Envelope request{};
+		request.comId = ComId;
+		request.functionId = Function_LatestOnly;
+		request.callId = ++callId;
+		request.data = std::make_shared<std::string>(update);
+		sendSucceeded = SendPreambleAndEnvelope(socket, request, CurrentProtocolRevision).ok() && sendSucceeded;
+	}
+
+	for (uint64_t i = 0; i < OrderedRequestCount; ++i)
+	{
+		Envelope request{};
+		request.comId = ComId;
+		request.functionId = Function_Ordered;
+		request.callId = ++callId;
+		request.data = std::make_shared<std::string>(std::to_string(i));
+		sendSucceeded = SendPreambleAndEnvelope(socket, request, CurrentProtocolRevision).ok() && sendSucceeded;
+	}
+
+	if (!sendSucceeded)
+	{
+		std::cerr << LogPrefix << "ERROR: Sending requests failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// every request is answered, superseded updates as cancelled
+	const std::vector<uint64_t> supersededCallIds = {2, 3};
+	for (uint64_t i = 0; i < callId; ++i)
+	{
+		Envelope response{};
+		if (!reader.ReceiveEnvelope(response).ok())
+		{
+			std::cerr << LogPrefix << "ERROR: Request not answered" << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		const bool superseded =
+			std::find(supersededCallIds.begin(), supersededCallIds.end(), response.callId) != supersededCallIds.end();
+		const StatusCode expectedStatus = superseded ? StatusCode::CANCELLED : StatusCode::OK;
+		if (response.statusCode != static_cast<uint32_t>(expectedStatus))
+		{
+			std::cerr << LogPrefix << "ERROR: Unexpected status for request " << response.callId << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	const std::lock_guard<std::mutex> lock{handledMutex};
+	for (uint64_t i = 0; i < OrderedRequestCount; ++i)
+	{
+		if (handledOrdered.size() != OrderedRequestCount || handledOrdered[i] != std::to_string(i))
+		{
+			std::cerr << LogPrefix << "ERROR: Ordered requests not handled in order" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (handledLatestOnly != std::vector<std::string>{updates.front(), updates.back()})
+	{
+		std::cerr << LogPrefix << "ERROR: Superseded updates were handled" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Requests dispatched according to their policy" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+int TestCircuitBreaker(const char* location)
+{
+	using Clock = std::chrono::steady_clock;
+
+	ConnectionPolicy policy{};
+	policy.maxAttempts = 100;
+	policy.initialBackoff = std::chrono::milliseconds{10};
+	policy.maxBackoff = std::chrono::milliseconds{50};
+	policy.deadline = std::chrono::milliseconds{300};
+	policy.failureThreshold = 1;
+	policy.openDuration = std::chrono::seconds{60};
+
+	// nobody listens yet
+	ChannelInterface channel{location, policy};
+
+	Clock::time_point start = Clock::now();
+	if (CallEcho(channel, Function_Echo, "unreachable"))
+	{
+		std::cerr << LogPrefix << "ERROR: Call without server succeeded" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (Clock::now() - start > 2 * policy.deadline)
+	{
+		std::cerr << LogPrefix << "ERROR: Call without server exceeded its deadline" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	start = Clock::now();
+	std::shared_ptr<std::string> response;
+	const Status openStatus = channel.Call(ComId, Function_Echo, std::make_shared<std::string>("open"), response);
+	if (openStatus.code() != StatusCode::UNAVAILABLE || Clock::now() - start > policy.initialBackoff)
+	{
+		std::cerr << LogPrefix << "ERROR: Call with open circuit did not fail fast" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	Server server{TestFunctions()};
+	if (!server.Start(location))
+	{
+		std::cerr << LogPrefix << "ERROR: Starting server failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// the background reconnect closes the circuit long before the open duration has passed
+	const Clock::time_point reconnectDeadline = Clock::now() + std::chrono::seconds{5};
+	while (!CallEcho(channel, Function_Echo, "reconnected"))
+	{
+		if (Clock::now() > reconnectDeadline)
+		{
+			std::cerr << LogPrefix << "ERROR: Channel did not reconnect in the background" << std::endl;
+			return EXIT_FAILURE;
+		}
+		std::this_thread::sleep_for(policy.maxBackoff);
+	}
+
+	std::cout << LogPrefix << "OK: Unreachable peer fails fast and is reconnected in the background" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+// Echoes the joined frames of a streamed call, counting what it has been handed.
+class CountingStream final : public Server::Stream
+{
+public:
+	struct Counters
+	{
+		std::atomic<size_t> frames{0};
+		std::atomic<size_t> finished{0};
+		std::atomic<size_t> cancelled{0};
+	};
+
+	explicit CountingStream(Counters& counters)
+		: m_counters(counters)
+	{
+	}
+
+	Status Read(std::string& frame) override
+	{
+		++m_counters.frames;
+		m_joinedFrames.append(frame);
+		return Status::OK;
+	}
+
+	Status Finish(std::string& response) override
+	{
+		++m_counters.finished;
+		response.swap(m_joinedFrames);
+		return Status::OK;
+	}
+
+	void Cancel() override
+	{
+		++m_counters.cancelled;
+	}
+
+private:
+	Counters& m_counters;
+	std::string m_joinedFrames;
+};
+
+Status StreamFrames(ChannelInterface& channel, int64_t functionId, const std::vector<std::string>& frames, std::shared_ptr<std::string>& response)
+{
+	const std::unique_ptr<ChannelInterface::ClientStream> stream = channel.OpenStream(ComId, functionId);
+	for (size_t frame = 0; frame + 1 < frames.size(); ++frame)
+	{
+		const Status status = stream->Write(std::make_shared<std::string>(frames[frame]));
+		if (!status.ok())
+		{
+			return status;
+		}
+	}
+	return stream->Finish(std::make_shared<std::string>(frames.back()), response);
+}
+
+int TestStreamedCalls(const char* location, Server::ConnectionMode connectionMode)
+{
+	CountingStream::Counters counters;
+
+	Server::StreamFunctionMap streamFunctions;
+	streamFunctions[Function_Stream] = [&counters](const std::string& /*comId*/)
+	{
+		return std::unique_ptr<Server::Stream>{new CountingStream{counters}};
+	};
+
+	Server server{TestFunctions(), connectionMode, DefaultWorkerThreads, {}, {}, std::move(streamFunctions)};
+	if (!server.Start(location))
+	{
+		std::cerr << LogPrefix << "ERROR: Starting server failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const std::vector<std::string> frames{"first", std::string(1024 * 1024, 's'), "last"};
+	const std::string joinedFrames = frames[0] + frames[1] + frames[2];
+
+	ChannelInterface channel{location};
+
+	std::shared_ptr<std::string> response;
+	if (!StreamFrames(channel, Function_Stream, frames, response).ok() || !response || *response != joinedFrames
+		|| counters.frames != frames.size() || counters.finished != 1)
+	{
+		std::cerr << LogPrefix << "ERROR: Streamed call not handed over frame by frame" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// functions without a stream function get the joined frames
+	response.reset();
+	if (!StreamFrames(channel, Function_Echo, frames, response).ok() || !response || *response != joinedFrames)
+	{
+		std::cerr << LogPrefix << "ERROR: Streamed call to a plain function failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	{
+		const std::unique_ptr<ChannelInterface::ClientStream> stream = channel.OpenStream(ComId, Function_Stream);
+		if (!stream->Write(std::make_shared<std::string>(frames[0])).ok())
+		{
+			std::cerr << LogPrefix << "ERROR: Writing frame failed" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	// the echo is answered after the cancellation has been handled
+	if (!CallEcho(channel, Function_Echo, "after cancel") || counters.cancelled != 1 || counters.finished != 1)
+	{
+		std::cerr << LogPrefix << "ERROR: Abandoned stream not cancelled" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Streamed calls handed over frame by frame" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+int TestFrameTails(const char* location)
+{
+	CountingStream::Counters counters;
+
+	Server::StreamFunctionMap streamFunctions;
+	streamFunctions[Function_Stream] = [&counters](const std::string& /*comId*/)
+	{
+		return std::unique_ptr<Server::Stream>{new CountingStream{counters}};
+	};
+
+	Server server{TestFunctions(), Server::ConnectionMode::Multiplexed, DefaultWorkerThreads, {}, {}, std::move(streamFunctions)};
+	if (!server.Start(location))
+	{
+		std::cerr << LogPrefix << "ERROR: Starting server failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const std::shared_ptr<std::string> pixels = std::make_shared<std::string>(1024 * 1024, 'p');
+	const FrameBuffer frameBuffer{pixels, pixels->data(), pixels->size()};
+
+	ChannelInterface channel{location};
+
+	// the tail is sent right after the request, the server gets them joined
+	std::shared_ptr<std::string> response;
+	if (!channel.Call(ComId, Function_Echo, std::make_shared<std::string>("head"), frameBuffer, response).ok()
+		|| !response || *response != "head" + *pixels)
+	{
+		std::cerr << LogPrefix << "ERROR: Unexpected response for request with tail" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const size_t half = pixels->size() / 2;
+	const std::unique_ptr<ChannelInterface::ClientStream> stream = channel.OpenStream(ComId, Function_Stream);
+	response.reset();
+	if (!stream->Write(std::make_shared<std::string>("first"), frameBuffer.Slice(0, half)).ok()
+		|| !stream->Finish(std::make_shared<std::string>("last"), frameBuffer.Slice(half), response).ok()
+		|| !response || *response != "first" + pixels->substr(0, half) + "last" + pixels->substr(half))
+	{
+		std::cerr << LogPrefix << "ERROR: Unexpected response for stream with tails" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (frameBuffer.GetCopyCount() != 0)
+	{
+		std::cerr << LogPrefix << "ERROR: Tails copied before sending" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Tails sent without copying" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main()
+{
+	for (const char* location : {TcpLocation, UnixLocation})
+	{
+		std::cout << LogPrefix << "Testing on " << location << std::endl;
+
+		if (TestRequestOrder(location) == EXIT_FAILURE)
+		{
+			return EXIT_FAILURE;
+		}
+
+		if (TestLargePayload(location) == EXIT_FAILURE)
+		{
+			return EXIT_FAILURE;
+		}
+
+		if (TestLongStatusMessage(location) == EXIT_FAILURE)
+		{
+			return EXIT_FAILURE;
+		}
+
+		if (TestSocketOptions(location) == EXIT_FAILURE)
+		{
+			return EXIT_FAILURE;
+		}
+
+		if (TestConcurrentClients(location) == EXIT_FAILURE)
+		{
+			return EXIT_FAILURE;
+		}
+
+		if (TestMultiplexedCalls(location) == EXIT_FAILURE)
+		{
+			return EXIT_FAILURE;
+		}
+
+		if (TestPipelinedRequests(location) == EXIT_FAILURE)
+		{
+			return EXIT_FAILURE;
+		}
+
+		if (TestProtocolRevisions(location) == EXIT_FAILURE)
+		{
+			return EXIT_FAILURE;
+		}
+
+		if (TestStalledClient(location) == EXIT_FAILURE)
+		{
+			return EXIT_FAILURE;
+		}
+
+		if (TestUnexpectedResponses(location) == EXIT_FAILURE)
+		{
+			return EXIT_FAILURE;
+		}
+
+		if (TestHandshakeFallback(location) == EXIT_FAILURE)
+		{
+			return EXIT_FAILURE;
+		}
+
+		if (TestCallDeadline(location) == EXIT_FAILURE)
+		{
+			return EXIT_FAILURE;
+		}
+
+		if (TestDispatchPolicies(location) == EXIT_FAILURE)
+		{
+			return EXIT_FAILURE;
+		}
+
+		if (TestStreamedCalls(location, Server::ConnectionMode::Multiplexed) == EXIT_FAILURE
+			|| TestStreamedCalls(location, Server::ConnectionMode::Sequential) == EXIT_FAILURE)
+		{
+			return EXIT_FAILURE;
+		}
+
+		if (TestFrameTails(location) == EXIT_FAILURE)
+		{
+			return EXIT_FAILURE;
+		}
+
+		if (TestCircuitBreaker(location) == EXIT_FAILURE)
+		{
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,382 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include <TVRemoteScreenSDKCommunication/ServiceBase/gRPCAsyncServerHost.h>
+
+#include <grpc++/grpc++.h>
+#include <grpcpp/generic/generic_stub.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using TVRemoteScreenSDKCommunication::Transport::gRPCAsyncServerHost;
+
+namespace
+{
+
+constexpr const char* LogPrefix = "[gRPCAsyncServerHost] ";
+constexpr const char* Location = "unix:///tmp/tvgRPCAsyncServerHostTest";
+
+constexpr const char* EchoService = "tvtest.EchoService";
+constexpr const char* EchoMethod = "/tvtest.EchoService/Echo";
+constexpr const char* OtherMethod = "/tvtest.OtherService/Echo";
+
+// long enough for a call to be finished by mistake, short enough to keep the test fast
+constexpr std::chrono::milliseconds BlockedDuration{200};
+
+// Blocks the handlers of a service until it is opened, reporting when a handler has been entered.
+class Gate final
+{
+public:
+	void Enter()
+	{
+		std::unique_lock<std::mutex> lock{m_mutex};
+		m_entered = true;
+		m_condition.notify_all();
+		m_condition.wait(lock, [this]()
+		{
+			return m_open;
+		});
+	}
+
+	bool WaitEntered()
+	{
+		std::unique_lock<std::mutex> lock{m_mutex};
+		return m_condition.wait_for(lock, std::chrono::seconds(5), [this]()
+		{
+			return m_entered;
+		});
+	}
+
+	void Open()
+	{
+		const std::lock_guard<std::mutex> lock{m_mutex};
+		m_open = true;
+		m_condition.notify_all();
+	}
+
+private:
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_entered = false;
+	bool m_open = false;
+};
+
+gRPCAsyncServerHost::MethodHandlers EchoHandlers(Gate* gate = nullptr)
+{
+	gRPCAsyncServerHost::MethodHandlers handlers;
+	handlers["Echo"] = [gate](
+		::grpc::ServerContext* /*context*/,
+		::grpc::ByteBuffer* request,
+		::grpc::ByteBuffer* response)
+	{
+		if (gate)
+		{
+			gate->Enter();
+		}
+		*response = *request;
+		return ::grpc::Status::OK;
+	};
+	return handlers;
+}
+
+std::string ToString(const ::grpc::ByteBuffer& buffer)
+{
+	std::vector<::grpc::Slice> slices;
+	if (!buffer.Dump(&slices).ok())
+	{
+		return std::string{};
+	}
+
+	std::string result;
+	for (const ::grpc::Slice& slice : slices)
+	{
+		result.append(reinterpret_cast<const char*>(slice.begin()), slice.size());
+	}
+	return result;
+}
+
+// Unary call of the given method, sending the payload and receiving the response as raw bytes.
+::grpc::Status Call(const std::string& method, const std::string& payload, std::string& response)
+{
+	::grpc::GenericStub stub{::grpc::CreateChannel(Location, ::grpc::InsecureChannelCredentials())};
+	::grpc::CompletionQueue completionQueue;
+	::grpc::ClientContext context;
+	context.set_deadline(std::chrono::system_clock::now() + std::chrono::seconds(10));
+
+	const ::grpc::Slice slice{payload};
+	const ::grpc::ByteBuffer request{&slice, 1};
+	::grpc::ByteBuffer responseBuffer;
+	::grpc::Status status;
+
+	const std::unique_ptr<::grpc::GenericClientAsyncResponseReader> reader =
+		stub.PrepareUnaryCall(&context, method, request, &completionQueue);
+	reader->StartCall();
+	reader->Finish(&responseBuffer, &status, nullptr);
+
+	void* tag = nullptr;
+	bool ok = false;
+	if (!completionQueue.Next(&tag, &ok) || !ok)
+	{
+		status = ::grpc::Status(::grpc::StatusCode::INTERNAL, "call not completed");
+	}
+	completionQueue.Shutdown();
+	while (completionQueue.Next(&tag, &ok))
+	{
+	}
+
+	response = status.ok() ? ToString(responseBuffer) : std::string{};
+	return status;
+}
+
+std::future<::grpc::Status> CallAsync(const std::string& method, const std::string& payload)
+{
+	return std::async(std::launch::async, [method, payload]()
+	{
+		std::string response;
+		const ::grpc::Status status = Call(method, payload, response);
+		if (status.ok() && response != payload)
+		{
+			return ::grpc::Status(::grpc::StatusCode::DATA_LOSS, "unexpected response");
+		}
+		return status;
+	});
+}
+
+int TestUnaryCall()
+{
+	const std::shared_ptr<gRPCAsyncServerHost> host = gRPCAsyncServerHost::Create({Location});
+	if (!host || gRPCAsyncServerHost::Find(Location) != host)
+	{
+		std::cerr << LogPrefix << "ERROR: Starting host failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (!host->AddService(EchoService, EchoHandlers()) || host->AddService(EchoService, EchoHandlers()))
+	{
+		std::cerr << LogPrefix << "ERROR: Adding service must succeed exactly once" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	const std::string payload = "TestPayload";
+	std::string response;
+	const ::grpc::Status status = Call(EchoMethod, payload, response);
+	if (!status.ok() || response != payload)
+	{
+		std::cerr << LogPrefix << "ERROR: Unexpected result of unary call: " << status.error_message() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Unary call served by attached service" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+int TestDetachedService()
+{
+	const std::shared_ptr<gRPCAsyncServerHost> host = gRPCAsyncServerHost::Create({Location});
+	if (!host)
+	{
+		std::cerr << LogPrefix << "ERROR: Starting host failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	host->AddService(EchoService, EchoHandlers());
+
+	std::string response;
+	if (Call(OtherMethod, "TestPayload", response).error_code() != ::grpc::StatusCode::UNAVAILABLE)
+	{
+		std::cerr << LogPrefix << "ERROR: Call of service never attached must be unavailable" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	host->RemoveService(EchoService);
+	if (Call(EchoMethod, "TestPayload", response).error_code() != ::grpc::StatusCode::UNAVAILABLE)
+	{
+		std::cerr << LogPrefix << "ERROR: Call of removed service must be unavailable" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// the service may attach again
+	host->AddService(EchoService, EchoHandlers());
+	if (!Call(EchoMethod, "TestPayload", response).ok())
+	{
+		std::cerr << LogPrefix << "ERROR: Call of service attached again failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Calls of detached services are unavailable" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+int TestRemoveServiceWhileCallRunning()
+{
+	// a second thread serves the calls arriving while the first one is blocked
+	const std::shared_ptr<gRPCAsyncServerHost> host = gRPCAsyncServerHost::Create({Location}, 1, 2);
+	if (!host)
+	{
+		std::cerr << LogPrefix << "ERROR: Starting host failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	Gate gate;
+	host->AddService(EchoService, EchoHandlers(&gate));
+
+	std::future<::grpc::Status> call = CallAsync(EchoMethod, "TestPayload");
+	if (!gate.WaitEntered())
+	{
+		std::cerr << LogPrefix << "ERROR: Call has not reached the service" << std::endl;
+		gate.Open();
+		return EXIT_FAILURE;
+	}
+
+	std::future<void> removal = std::async(std::launch::async, [&host]()
+	{
+		host->RemoveService(EchoService);
+	});
+
+	if (removal.wait_for(BlockedDuration) != std::future_status::timeout)
+	{
+		std::cerr << LogPrefix << "ERROR: Removing service did not wait for its running call" << std::endl;
+		gate.Open();
+		return EXIT_FAILURE;
+	}
+
+	// new calls are not routed to the service being removed anymore
+	std::string response;
+	if (Call(EchoMethod, "TestPayload", response).error_code() != ::grpc::StatusCode::UNAVAILABLE)
+	{
+		std::cerr << LogPrefix << "ERROR: Call of service being removed must be unavailable" << std::endl;
+		gate.Open();
+		return EXIT_FAILURE;
+	}
+
+	gate.Open();
+	removal.wait();
+
+	if (!call.get().ok())
+	{
+		std::cerr << LogPrefix << "ERROR: Running call has not been finished" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Removing service waits for its running calls" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+int TestShutdownWithOutstandingCalls()
+{
+	// several queues and threads, each with a requested call waiting for a client
+	std::shared_ptr<gRPCAsyncServerHost> host = gRPCAsyncServerHost::Create({Location}, 2, 2);
+	if (!host)
+	{
+		std::cerr << LogPrefix << "ERROR: Starting host failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	Gate gate;
+	host->AddService(EchoService, EchoHandlers(&gate));
+
+	std::future<::grpc::Status> call = CallAsync(EchoMethod, "TestPayload");
+	if (!gate.WaitEntered())
+	{
+		std::cerr << LogPrefix << "ERROR: Call has not reached the service" << std::endl;
+		gate.Open();
+		return EXIT_FAILURE;
+	}
+
+	std::future<void> shutdown = std::async(std::launch::async, [&host]()
+	{
+		host->Shutdown();
+	});
+
+	if (shutdown.wait_for(BlockedDuration) != std::future_status::timeout)
+	{
+		std::cerr << LogPrefix << "ERROR: Shutdown did not wait for the running call" << std::endl;
+		gate.Open();
+		return EXIT_FAILURE;
+	}
+
+	gate.Open();
+	shutdown.wait();
+
+	if (!call.get().ok())
+	{
+		std::cerr << LogPrefix << "ERROR: Running call has not been finished on shutdown" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (gRPCAsyncServerHost::Find(Location))
+	{
+		std::cerr << LogPrefix << "ERROR: Host still registered after shutdown" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// shutting down again and destroying must not touch the calls drained before
+	host->Shutdown();
+	host.reset();
+
+	// the location is free again
+	host = gRPCAsyncServerHost::Create({Location});
+	if (!host)
+	{
+		std::cerr << LogPrefix << "ERROR: Starting host again failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << LogPrefix << "OK: Shutdown drains outstanding calls" << std::endl;
+	return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main()
+{
+	if (TestUnaryCall() == EXIT_FAILURE)
+	{
+		return EXIT_FAILURE;
+	}
+
+	if (TestDetachedService() == EXIT_FAILURE)
+	{
+		return EXIT_FAILURE;
+	}
+
+	if (TestRemoveServiceWhileCallRunning() == EXIT_FAILURE)
+	{
+		return EXIT_FAILURE;
+	}
+
+	if (TestShutdownWithOutstandingCalls() == EXIT_FAILURE)
+	{
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -26,11 +26,16 @@
 
 #include "ILoggingPrivate.h"
 
+#include "internal/ImageUpdateTracker.h"
 #include "internal/ServicesMediator.h"
 
 #include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/VersionNumber.h>
 
+#include <algorithm>
+#include <cstring>
+
 #include <sys/stat.h>
+#include <unistd.h>
 
 namespace tvagentapi
 {
@@ -46,6 +51,9 @@ namespace
 {
 constexpr VersionNumber ClientVersion = {1, 0}; // our SDK version
 
+// pending frames with more changed regions than this are sent as their bounding rect
+constexpr size_t MaxImageRegions = 64;
+
 constexpr uint32_t MaxSizeOfSocketPath = 107; // Socket paths under linux have a limit of around 100 characters. GRPC itself has a hard limit on 107 character.
 constexpr uint32_t UuidSize = 32;
 
@@ -78,20 +86,9 @@ bool CreateDirsForPath(const std::string& path)
 
 bool SetupDir(const std::string& serviceFolderPath)
 {
-	auto ServerLocation = &ServicesMediator::ServerLocation<TransportFramework::gRPCTransport>;
-	const char* locations[] = {
-		ServerLocation(ServiceType::AccessControlOut),
-		ServerLocation(ServiceType::ChatOut),
-		ServerLocation(ServiceType::Connectivity),
-		ServerLocation(ServiceType::Input),
-		ServerLocation(ServiceType::SessionStatus),
-		ServerLocation(ServiceType::InstantSupportNotification),
-		ServerLocation(ServiceType::ConnectionConfirmationRequest),
-		ServerLocation(ServiceType::AugmentRCSessionConsumer)
-	};
-
-	for (const char* location : locations)
+	for (const ServiceType serviceType : ServicesMediator::ServerServiceTypes())
 	{
+		const char* location = ServicesMediator::ServerLocation<TransportFramework::gRPCTransport>(serviceType);
 		if (!CreateDirsForPath(serviceFolderPath + '/' + location))
 		{
 			return false;
@@ -130,6 +127,7 @@ CommunicationChannel::CommunicationChannel(
 	, m_disconnectCondition(new Condition())
 	, m_shutdownCondition(new Condition())
 	, m_grabResultCondition(new Condition())
+	, m_imageUpdateTracker(new ImageUpdateTracker())
 {
 	setUrls(DefaultBaseServerUrl, DefaultAgentRegistrationServiceUrl);
 }
@@ -306,10 +304,41 @@ BaseUrlParseResultCode CommunicationChannel::setUrls(const std::string& baseServ
 	m_transportFramework = framework;
 
 	m_servicesMediator.reset(new ServicesMediator(m_serverUrlComponents, m_transportFramework, agentApiUrl));
+	m_servicesMediator->SetTransportOptions(m_transportOptions);
 
 	return BaseUrlParseResultCode::Success;
 }
 
+bool CommunicationChannel::setTransportOptions(TVRemoteScreenSDKCommunication::ServiceTransportOptions transportOptions)
+{
+	if (m_isRunning)
+	{
+		m_logging->logError(
+			"[Communication Channel] setTransportOptions(): "
+			"the connection is currently in use");
+		return false;
+	}
+
+	m_transportOptions = std::move(transportOptions);
+	if (m_servicesMediator)
+	{
+		m_servicesMediator->SetTransportOptions(m_transportOptions);
+	}
+	return true;
+}
+
+void CommunicationChannel::setImageTransferFeatures(const ImageTransferFeatures& features)
+{
+	const std::lock_guard<std::mutex> lock(m_imageTransferFeaturesMutex);
+	m_imageTransferFeatures = features;
+}
+
+CommunicationChannel::ImageTransferFeatures CommunicationChannel::getImageTransferFeatures() const
+{
+	const std::lock_guard<std::mutex> lock(m_imageTransferFeaturesMutex);
+	return m_imageTransferFeatures;
+}
+
 void CommunicationChannel::startup()
 {
 	std::lock_guard<std::mutex> shutdownLock(m_shutdownCondition->mutex);
@@ -626,21 +655,57 @@ void CommunicationChannel::sendScreenGrabResult(
 	int32_t y,
 	int32_t width,
 	int32_t height,
-	std::string pictureData)
+	TVRemoteScreenSDKCommunication::FrameBuffer pictureData,
+	const FrameLayout& frameLayout,
+	std::vector<TVRemoteScreenSDKCommunication::ImageService::ImageRegion> regions)
 {
+	using TVRemoteScreenSDKCommunication::ImageService::ImageRegion;
+
 	if (pictureData.empty())
 	{
 		return;
 	}
 
+	if (regions.empty())
+	{
+		regions.push_back(ImageRegion{x, y, width, height});
+	}
+
 	{
 		std::lock_guard<std::mutex> lock(m_grabResultCondition->mutex);
 
+		// the previous frame has not been taken by the worker yet, its changes must not get lost
+		const FrameLayout& pendingLayout = m_grabResultBuffer.frameLayout;
+		if (!m_grabResultBuffer.pictureData.empty()
+			&& pendingLayout.width == frameLayout.width
+			&& pendingLayout.height == frameLayout.height)
+		{
+			const int32_t right = std::max(x + width, m_grabResultBuffer.x + m_grabResultBuffer.width);
+			const int32_t bottom = std::max(y + height, m_grabResultBuffer.y + m_grabResultBuffer.height);
+			x = std::min(x, m_grabResultBuffer.x);
+			y = std::min(y, m_grabResultBuffer.y);
+			width = right - x;
+			height = bottom - y;
+
+			// overlapping regions would be sent twice, which is fine as long as there are few
+			const std::vector<ImageRegion>& pendingRegions = m_grabResultBuffer.regions;
+			if (!pendingRegions.empty() && regions.size() + pendingRegions.size() <= MaxImageRegions)
+			{
+				regions.insert(regions.end(), pendingRegions.begin(), pendingRegions.end());
+			}
+			else
+			{
+				regions.clear();
+			}
+		}
+
 		m_grabResultBuffer.x = x;
 		m_grabResultBuffer.y = y;
 		m_grabResultBuffer.width = width;
 		m_grabResultBuffer.height = height;
-		m_grabResultBuffer.pictureData.swap(pictureData);
+		m_grabResultBuffer.pictureData = std::move(pictureData);
+		m_grabResultBuffer.frameLayout = frameLayout;
+		m_grabResultBuffer.regions.swap(regions);
 
 		m_grabResultCondition->condition.notify_all();
 	}
@@ -660,6 +725,9 @@ void CommunicationChannel::startScreenGrabResultWorker()
 	{
 		constexpr std::chrono::seconds ShutdownRetryTime{2};
 
+		// the whole frame last handed to the worker, refers to its picture data without copying it
+		GrabResult lastBuffer;
+
 		while(m_processGrabResult)
 		{
 			GrabResult sendBuffer;
@@ -672,18 +740,64 @@ void CommunicationChannel::startScreenGrabResultWorker()
 				std::swap(sendBuffer, m_grabResultBuffer);
 			}
 
+			if (!sendBuffer.pictureData.empty())
+			{
+				lastBuffer = sendBuffer;
+			}
+			else if (!lastBuffer.pictureData.empty()
+				&& !m_communicationId.empty()
+				&& m_imageUpdateTracker->lastFrameMissing(m_communicationId))
+			{
+				// an unchanged screen grabs no new frame, a failed one would stay missing until the next change
+				sendBuffer = lastBuffer;
+			}
+
 			if (!sendBuffer.pictureData.empty())
 			{
 				sendScreenGrabResultBuffer(sendBuffer);
+				m_grabResultCopyCount = sendBuffer.pictureData.GetCopyCount();
 			}
 		}
 	});
 }
 void CommunicationChannel::sendScreenGrabResultBuffer(CommunicationChannel::GrabResult& sendBuffer)
 {
+	// a new agent connection, one which missed a frame or a resized frame leaves the agent without the unchanged parts
+	const FrameLayout& frameLayout = sendBuffer.frameLayout;
+	const bool croppedUpdates = getImageTransferFeatures().croppedImageUpdates;
+	if (m_imageUpdateTracker->requiresWholeFrame(m_communicationId, frameLayout.width, frameLayout.height, croppedUpdates))
+	{
+		sendBuffer.x = 0;
+		sendBuffer.y = 0;
+		sendBuffer.width = frameLayout.width;
+		sendBuffer.height = frameLayout.height;
+		sendBuffer.regions.clear();
+	}
+	m_imageUpdateTracker->frameSending(m_communicationId, frameLayout.width, frameLayout.height);
+
+	if (sendScreenGrabResultRegions(sendBuffer))
+	{
+		m_imageUpdateTracker->frameSent();
+		return;
+	}
+
+	if (sendScreenGrabResultSharedFrameBuffer(sendBuffer))
+	{
+		m_imageUpdateTracker->frameSent();
+		return;
+	}
+
+	cropToDirtyRect(sendBuffer);
+
+	if (sendScreenGrabResultImageStream(sendBuffer))
+	{
+		m_imageUpdateTracker->frameSent();
+		return;
+	}
+
 	if (auto safeClient = m_servicesMediator->AcquireClient<ServiceType::Image>())
 	{
-		TVRemoteScreenSDKCommunication::CallStatus callStatus = safeClient->UpdateImage(
+		TVRemoteScreenSDKCommunication::CallStatus callStatus = safeClient->UpdateImageFrame(
 			m_communicationId,
 			sendBuffer.x,
 			sendBuffer.y,
@@ -695,11 +809,294 @@ void CommunicationChannel::sendScreenGrabResultBuffer(CommunicationChannel::Grab
 		{
 			const std::string errorMessage = "[Communication Channel] Image update failed: " + callStatus.errorMessage;
 			m_logging->logError(errorMessage);
+			return;
 		}
 	}
 	else
 	{
 		m_logging->logError("[Communication Channel] Client not available for image service");
+		return;
+	}
+
+	m_imageUpdateTracker->frameSent();
+}
+
+bool CommunicationChannel::isCroppable(const CommunicationChannel::GrabResult& grabResult)
+{
+	const FrameLayout& frameLayout = grabResult.frameLayout;
+	const bool validRect = grabResult.x >= 0 && grabResult.y >= 0 && grabResult.width > 0 && grabResult.height > 0
+		&& grabResult.x + grabResult.width <= frameLayout.width
+		&& grabResult.y + grabResult.height <= frameLayout.height;
+	const size_t frameSize = static_cast<size_t>(frameLayout.bytesPerLine) * static_cast<size_t>(frameLayout.height);
+	return validRect && frameLayout.bytesPerPixel > 0 && grabResult.pictureData.size() >= frameSize;
+}
+
+size_t CommunicationChannel::getDirtyRectSize(const CommunicationChannel::GrabResult& grabResult)
+{
+	return static_cast<size_t>(grabResult.width) * static_cast<size_t>(grabResult.frameLayout.bytesPerPixel)
+		* static_cast<size_t>(grabResult.height);
+}
+
+void CommunicationChannel::copyDirtyRect(const CommunicationChannel::GrabResult& grabResult, char* destination)
+{
+	const FrameLayout& frameLayout = grabResult.frameLayout;
+	const size_t bytesPerLine = static_cast<size_t>(frameLayout.bytesPerLine);
+	const size_t croppedBytesPerLine = static_cast<size_t>(grabResult.width) * static_cast<size_t>(frameLayout.bytesPerPixel);
+	const char* line = grabResult.pictureData.data()
+		+ static_cast<size_t>(grabResult.y) * bytesPerLine
+		+ static_cast<size_t>(grabResult.x) * static_cast<size_t>(frameLayout.bytesPerPixel);
+	for (int32_t lineCounter = 0; lineCounter < grabResult.height; ++lineCounter, line += bytesPerLine)
+	{
+		std::memcpy(destination, line, croppedBytesPerLine);
+		destination += croppedBytesPerLine;
+	}
+	grabResult.pictureData.CountCopy();
+}
+
+void CommunicationChannel::cropToDirtyRect(CommunicationChannel::GrabResult& grabResult)
+{
+	if (!isCroppable(grabResult))
+	{
+		// sent as it is
+		return;
+	}
+
+	const FrameLayout& frameLayout = grabResult.frameLayout;
+	const size_t bytesPerLine = static_cast<size_t>(frameLayout.bytesPerLine);
+	const size_t croppedBytesPerLine = static_cast<size_t>(grabResult.width) * static_cast<size_t>(frameLayout.bytesPerPixel);
+	if (croppedBytesPerLine == bytesPerLine)
+	{
+		// whole lines are contiguous within the frame, no copy needed
+		grabResult.pictureData = grabResult.pictureData.Slice(
+			static_cast<size_t>(grabResult.y) * bytesPerLine,
+			croppedBytesPerLine * static_cast<size_t>(grabResult.height));
+		return;
+	}
+
+	std::string croppedData(getDirtyRectSize(grabResult), '\0');
+	copyDirtyRect(grabResult, &croppedData[0]);
+	grabResult.pictureData = grabResult.pictureData.Derive(std::move(croppedData));
+}
+
+bool CommunicationChannel::sendScreenGrabResultRegions(const CommunicationChannel::GrabResult& sendBuffer)
+{
+	using TVRemoteScreenSDKCommunication::ImageService::ImageRegion;
+
+	if (m_imageRegionsComId != m_communicationId)
+	{
+		// a new agent connection gets a new chance
+		m_imageRegionsComId = m_communicationId;
+		m_imageRegionsFailed = false;
+	}
+
+	const std::vector<ImageRegion>& regions = sendBuffer.regions;
+	if (!getImageTransferFeatures().imageRegions || m_imageRegionsFailed || regions.size() < 2)
+	{
+		return false;
+	}
+
+	const FrameLayout& frameLayout = sendBuffer.frameLayout;
+	const size_t frameSize = static_cast<size_t>(frameLayout.bytesPerLine) * static_cast<size_t>(frameLayout.height);
+	if (frameLayout.bytesPerPixel <= 0 || sendBuffer.pictureData.size() < frameSize)
+	{
+		return false;
+	}
+
+	size_t regionsArea = 0;
+	for (const ImageRegion& region : regions)
+	{
+		const bool validRegion = region.x >= 0 && region.y >= 0 && region.width > 0 && region.height > 0
+			&& region.x + region.width <= frameLayout.width
+			&& region.y + region.height <= frameLayout.height;
+		if (!validRegion)
+		{
+			return false;
+		}
+		regionsArea += static_cast<size_t>(region.width) * static_cast<size_t>(region.height);
+	}
+
+	// the bounding rect is cheaper if the regions cover most of it
+	if (regionsArea >= static_cast<size_t>(sendBuffer.width) * static_cast<size_t>(sendBuffer.height))
+	{
+		return false;
+	}
+
+	auto safeClient = m_servicesMediator->AcquireClient<ServiceType::Image>();
+	if (!safeClient)
+	{
+		return false;
+	}
+
+	const size_t bytesPerPixel = static_cast<size_t>(frameLayout.bytesPerPixel);
+	const size_t bytesPerLine = static_cast<size_t>(frameLayout.bytesPerLine);
+	std::string pictureData;
+	pictureData.reserve(regionsArea * bytesPerPixel);
+	for (const ImageRegion& region : regions)
+	{
+		const size_t regionBytesPerLine = static_cast<size_t>(region.width) * bytesPerPixel;
+		const char* line = sendBuffer.pictureData.data()
+			+ static_cast<size_t>(region.y) * bytesPerLine
+			+ static_cast<size_t>(region.x) * bytesPerPixel;
+		for (int32_t lineCounter = 0; lineCounter < region.height; ++lineCounter, line += bytesPerLine)
+		{
+			pictureData.append(line, regionBytesPerLine);
+		}
+	}
+	sendBuffer.pictureData.CountCopy();
+
+	const TVRemoteScreenSDKCommunication::CallStatus callStatus =
+		safeClient->UpdateImageRegions(m_communicationId, regions, pictureData);
+	if (!callStatus.IsOk())
+	{
+		m_imageRegionsFailed = true;
+		m_logging->logError("[Communication Channel] Multi-region image update failed, falling back to image updates: " + callStatus.errorMessage);
+		return false;
+	}
+
+	return true;
+}
+
+bool CommunicationChannel::sendScreenGrabResultSharedFrameBuffer(const CommunicationChannel::GrabResult& sendBuffer)
+{
+	using TVRemoteScreenSDKCommunication::ImageService::SharedFrameBuffer;
+
+	if (m_sharedFrameBufferComId != m_communicationId)
+	{
+		// a new agent connection gets a new chance, the old buffer is not known there
+		m_sharedFrameBuffer.reset();
+		m_sharedFrameBufferComId = m_communicationId;
+		m_sharedFrameBufferFailed = false;
+	}
+
+	const ImageTransferFeatures features = getImageTransferFeatures();
+	if (!features.sharedFrameBuffer || m_sharedFrameBufferFailed)
+	{
+		return false;
+	}
+
+	auto safeClient = m_servicesMediator->AcquireClient<ServiceType::Image>();
+	if (!safeClient)
+	{
+		return false;
+	}
+
+	// the dirty rect is copied straight from the frame into the slot
+	const bool croppable = isCroppable(sendBuffer);
+	const uint64_t pictureSize = croppable ? getDirtyRectSize(sendBuffer) : sendBuffer.pictureData.size();
+	if (!m_sharedFrameBuffer || m_sharedFrameBuffer->GetSlotSize() < pictureSize)
+	{
+		// grow generously, dirty rects vary in size from frame to frame
+		const uint64_t slotSize = m_sharedFrameBuffer
+			? std::max(pictureSize, 2 * m_sharedFrameBuffer->GetSlotSize())
+			: pictureSize;
+		m_sharedFrameBuffer.reset();
+
+		const std::string name = "/tvagentapi-frames-"
+			+ std::to_string(::getpid()) + '-' + std::to_string(++m_sharedFrameBufferGeneration);
+		std::unique_ptr<SharedFrameBuffer> sharedFrameBuffer =
+			SharedFrameBuffer::Create(name, SharedFrameBuffer::DefaultSlotCount, slotSize, features.sharedFrameBufferPermissions);
+		if (!sharedFrameBuffer)
+		{
+			m_sharedFrameBufferFailed = true;
+			m_logging->logError("[Communication Channel] Creating shared frame buffer failed, falling back to image updates");
+			return false;
+		}
+
+		const TVRemoteScreenSDKCommunication::CallStatus callStatus = safeClient->AnnounceSharedFrameBuffer(
+			m_communicationId,
+			sharedFrameBuffer->GetName(),
+			sharedFrameBuffer->GetSlotCount(),
+			sharedFrameBuffer->GetSlotSize());
+		if (!callStatus.IsOk())
+		{
+			// e.g. the agent cannot open the buffer, which is removed again right away
+			m_sharedFrameBufferFailed = true;
+			m_logging->logInfo("[Communication Channel] Shared frame buffer rejected, falling back to image updates: " + callStatus.errorMessage);
+			return false;
+		}
+
+		m_sharedFrameBuffer = std::move(sharedFrameBuffer);
+	}
+
+	// the agent still holds all slots, this frame takes the regular way
+	uint32_t slot = 0;
+	if (!m_sharedFrameBuffer->Acquire(slot))
+	{
+		return false;
+	}
+
+	if (croppable)
+	{
+		copyDirtyRect(sendBuffer, m_sharedFrameBuffer->Slot(slot));
+	}
+	else
+	{
+		std::memcpy(m_sharedFrameBuffer->Slot(slot), sendBuffer.pictureData.data(), pictureSize);
+		sendBuffer.pictureData.CountCopy();
+	}
+
+	const TVRemoteScreenSDKCommunication::CallStatus callStatus = safeClient->UpdateImageFromSharedFrameBuffer(
+		m_communicationId,
+		sendBuffer.x,
+		sendBuffer.y,
+		sendBuffer.width,
+		sendBuffer.height,
+		slot,
+		pictureSize);
+	if (!callStatus.IsOk())
+	{
+		m_sharedFrameBufferFailed = true;
+		m_sharedFrameBuffer.reset();
+		m_logging->logError("[Communication Channel] Shared frame buffer update failed, falling back to image updates: " + callStatus.errorMessage);
+		return false;
+	}
+
+	return true;
+}
+
+bool CommunicationChannel::sendScreenGrabResultImageStream(const CommunicationChannel::GrabResult& sendBuffer)
+{
+	if (m_imageStreamComId != m_communicationId)
+	{
+		// a new agent connection gets a new chance
+		m_imageStreamComId = m_communicationId;
+		m_imageStreamFailed = false;
+	}
+
+	if (!getImageTransferFeatures().imageStream || m_imageStreamFailed)
+	{
+		return false;
+	}
+
+	auto safeClient = m_servicesMediator->AcquireClient<ServiceType::Image>();
+	if (!safeClient)
+	{
+		return false;
+	}
+
+	// blocks while the agent has not acknowledged enough frames, newer grab results replace the waiting one meanwhile
+	const TVRemoteScreenSDKCommunication::CallStatus callStatus = safeClient->UpdateImageStreamFrame(
+		m_communicationId,
+		sendBuffer.x,
+		sendBuffer.y,
+		sendBuffer.width,
+		sendBuffer.height,
+		sendBuffer.pictureData);
+	if (!callStatus.IsOk())
+	{
+		m_imageStreamFailed = true;
+		m_logging->logError("[Communication Channel] Image stream failed, falling back to image updates: " + callStatus.errorMessage);
+		return false;
+	}
+
+	return true;
+}
+
+void CommunicationChannel::stopImageStream()
+{
+	if (auto safeClient = m_servicesMediator->AcquireClient<ServiceType::Image>())
+	{
+		safeClient->StopImageStream();
 	}
 }
 
@@ -1015,6 +1412,11 @@ uint64_t CommunicationChannel::getRunningServicesBitmask() const
 	return m_servicesMediator->GetRunningServicesBitmask();
 }
 
+uint32_t CommunicationChannel::getScreenGrabResultCopyCount() const
+{
+	return m_grabResultCopyCount;
+}
+
 bool CommunicationChannel::establishConnection()
 {
 	using namespace TVRemoteScreenSDKCommunication::RegistrationService;
@@ -1120,6 +1522,12 @@ bool CommunicationChannel::setupClientAndServer()
 		{"AugmentRCSession control client"             , &ThisType::setupClient<ST::AugmentRCSessionControl>       },
 	};
 
+	if (!m_servicesMediator->StartAsyncServerHost())
+	{
+		m_logging->logError("[Communication Channel] Starting the server shared by all services failed.");
+		return false;
+	}
+
 	for (const auto setup: mandatorySetups)
 	{
 		const bool setupResult = (this->*setup.setup)();
@@ -1327,6 +1735,7 @@ bool CommunicationChannel::setupSessionStatusService()
 		if (communicationChannel && (communicationChannel->m_communicationId == comId))
 		{
 			response(TVRemoteScreenSDKCommunication::CallStatus::Ok);
+			communicationChannel->stopImageStream();
 			communicationChannel->rcSessionStopped().notifyAll();
 		}
 		else
@@ -1795,6 +2204,8 @@ void CommunicationChannel::tearDown()
 	m_servicesMediator->TeardownServer<ServiceType::InstantSupportNotification>();
 	m_servicesMediator->TeardownServer<ServiceType::ChatOut>();
 	m_servicesMediator->TeardownServer<ServiceType::ConnectionConfirmationRequest>();
+	m_servicesMediator->TeardownServer<ServiceType::AugmentRCSessionConsumer>();
+	m_servicesMediator->ReleaseAsyncServerHost();
 
 	m_servicesMediator->TeardownClient<ServiceType::Connectivity>();
 	m_servicesMediator->TeardownClient<ServiceType::ImageNotification>();
@@ -27,10 +27,14 @@
 
 #include <TVRemoteScreenSDKCommunication/AccessControlService/AccessControl.h>
 #include <TVRemoteScreenSDKCommunication/ChatService/Chat.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/FrameBuffer.h>
 #include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/ParseUrl.h>
 #include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/ServiceType.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 #include <TVRemoteScreenSDKCommunication/ConnectionConfirmationService/ConnectionData.h>
 #include <TVRemoteScreenSDKCommunication/ImageService/ColorFormat.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/ImageRegion.h>
+#include <TVRemoteScreenSDKCommunication/ImageService/SharedFrameBuffer.h>
 #include <TVRemoteScreenSDKCommunication/InputService/KeyState.h>
 #include <TVRemoteScreenSDKCommunication/InputService/MouseButton.h>
 #include <TVRemoteScreenSDKCommunication/InstantSupportService/InstantSupportData.h>
@@ -60,6 +64,7 @@ namespace tvagentapi
 {
 
 class ILoggingPrivate;
+class ImageUpdateTracker;
 class ServicesMediator;
 
 enum class ViewGeometrySendResult
@@ -81,6 +86,15 @@ enum BaseUrlParseResultCode
 class CommunicationChannel final
 {
 public:
+	// Layout of the picture data of a whole frame.
+	struct FrameLayout
+	{
+		int32_t width = 0;
+		int32_t height = 0;
+		int32_t bytesPerLine = 0;
+		int32_t bytesPerPixel = 0;
+	};
+
 	static std::shared_ptr<CommunicationChannel> Create(
 		std::shared_ptr<ILoggingPrivate> logging);
 	~CommunicationChannel();
@@ -90,6 +104,31 @@ public:
 
 	BaseUrlParseResultCode setUrls(const std::string& baseServerUrl, const std::string& agentApiUrl);
 
+	// Tunes the channels and servers of the services, per service type if needed.
+	// Takes effect with the next startup, fails while the connection is in use.
+	bool setTransportOptions(TVRemoteScreenSDKCommunication::ServiceTransportOptions transportOptions);
+
+	// Optional ways of handing grabbed frames to the agent, all off by default.
+	// Only enable the ones the agent supports, there is no negotiation. A feature the agent rejects
+	// is given up for the rest of the agent connection in favour of plain image updates.
+	struct ImageTransferFeatures
+	{
+		// frames are written to shared memory, only the slot index is sent, see SharedFrameBuffer
+		bool sharedFrameBuffer = false;
+		// access permissions of the shared memory, the agent needs read and write access
+		uint32_t sharedFrameBufferPermissions = TVRemoteScreenSDKCommunication::ImageService::SharedFrameBuffer::DefaultPermissions;
+		// frames are sent over one stream kept open per session instead of one call each
+		bool imageStream = false;
+		// only the changed part of a frame is sent once the agent has a whole frame of the same size
+		bool croppedImageUpdates = false;
+		// several changed rectangles of a frame are sent in one update instead of their bounding rect,
+		// takes effect together with croppedImageUpdates
+		bool imageRegions = false;
+	};
+
+	// Takes effect with the next frame.
+	void setImageTransferFeatures(const ImageTransferFeatures& features);
+
 	void startup();
 	void shutdown();
 
@@ -125,12 +164,18 @@ public:
 		TVRemoteScreenSDKCommunication::AccessControlService::AccessControl feature,
 		bool confirmed);
 
+	// pictureData holds the whole frame, with croppedImageUpdates only the dirty rect x/y/width/height of it is sent.
+	// The frame is referenced until it has been sent, it must not be modified meanwhile.
+	// regions optionally lists the changed rectangles within the dirty rect, with imageRegions
+	// only those are sent. A frame replaced before being sent passes its changes on to the replacing one.
 	void sendScreenGrabResult(
 		int32_t x,
 		int32_t y,
 		int32_t width,
 		int32_t height,
-		std::string pictureData);
+		TVRemoteScreenSDKCommunication::FrameBuffer pictureData,
+		const FrameLayout& frameLayout,
+		std::vector<TVRemoteScreenSDKCommunication::ImageService::ImageRegion> regions = {});
 	void sendImageDefinitionForGrabResult(
 		const std::string& imageSourceTitle,
 		int32_t width,
@@ -164,6 +209,9 @@ public:
 	bool sendAugmentRCSessionStopListening();
 	uint64_t getRunningServicesBitmask() const;
 
+	// Copies of the pixel data made on the way to the transport for the last frame sent.
+	uint32_t getScreenGrabResultCopyCount() const;
+
 private:
 	struct GrabResult
 	{
@@ -171,7 +219,9 @@ private:
 		int32_t y;
 		int32_t width;
 		int32_t height;
-		std::string pictureData;
+		TVRemoteScreenSDKCommunication::FrameBuffer pictureData;
+		FrameLayout frameLayout;
+		std::vector<TVRemoteScreenSDKCommunication::ImageService::ImageRegion> regions;
 	};
 
 	explicit CommunicationChannel(std::shared_ptr<ILoggingPrivate> logging);
@@ -199,6 +249,15 @@ private:
 
 	void startScreenGrabResultWorker();
 	void sendScreenGrabResultBuffer(GrabResult& sendBuffer);
+	static bool isCroppable(const GrabResult& grabResult);
+	static size_t getDirtyRectSize(const GrabResult& grabResult);
+	static void copyDirtyRect(const GrabResult& grabResult, char* destination);
+	static void cropToDirtyRect(GrabResult& grabResult);
+	bool sendScreenGrabResultRegions(const GrabResult& sendBuffer);
+	ImageTransferFeatures getImageTransferFeatures() const;
+	bool sendScreenGrabResultSharedFrameBuffer(const GrabResult& sendBuffer);
+	bool sendScreenGrabResultImageStream(const GrabResult& sendBuffer);
+	void stopImageStream();
 
 	struct Condition
 	{
@@ -219,6 +278,8 @@ private:
 	TVRemoteScreenSDKCommunication::TransportFramework m_transportFramework =
 		TVRemoteScreenSDKCommunication::UnknownTransport;
 
+	TVRemoteScreenSDKCommunication::ServiceTransportOptions m_transportOptions;
+
 	std::string m_communicationId;
 	std::unique_ptr<ServicesMediator> m_servicesMediator;
 
@@ -231,6 +292,27 @@ private:
 	GrabResult m_grabResultBuffer;
 	std::thread m_grabResultThread;
 
+	// owned by the grab result worker
+	const std::unique_ptr<ImageUpdateTracker> m_imageUpdateTracker;
+	std::atomic<uint32_t> m_grabResultCopyCount{0};
+
+	// owned by the grab result worker
+	std::string m_imageRegionsComId;
+	bool m_imageRegionsFailed = false;
+
+	mutable std::mutex m_imageTransferFeaturesMutex;
+	ImageTransferFeatures m_imageTransferFeatures;
+
+	// owned by the grab result worker
+	std::unique_ptr<TVRemoteScreenSDKCommunication::ImageService::SharedFrameBuffer> m_sharedFrameBuffer;
+	std::string m_sharedFrameBufferComId;
+	bool m_sharedFrameBufferFailed = false;
+	uint32_t m_sharedFrameBufferGeneration = 0;
+
+	// owned by the grab result worker
+	std::string m_imageStreamComId;
+	bool m_imageStreamFailed = false;
+
 	std::weak_ptr<CommunicationChannel> m_weakThis;
 
 private:
@@ -0,0 +1,57 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace tvagentapi
+{
+
+// Keeps track of what the agent knows of the grabbed frames. An agent only knows the unchanged
+// parts of a frame after it has received a whole frame of the same size over its current connection,
+// until then updates must not be cut down to the changed area.
+class ImageUpdateTracker final
+{
+public:
+	// Whether the next frame for the agent connection comId has to be sent whole.
+	// croppedUpdates false always sends whole frames.
+	bool requiresWholeFrame(const std::string& comId, int32_t width, int32_t height, bool croppedUpdates) const;
+
+	// Whether the agent connection comId lacks the last frame sent, because sending it failed or it went
+	// to another connection. Unchanged screens produce no further frames, so the last one has to be sent again.
+	bool lastFrameMissing(const std::string& comId) const;
+
+	// Called before sending a frame, which counts as unknown to the agent until frameSent is called.
+	void frameSending(const std::string& comId, int32_t width, int32_t height);
+	void frameSent();
+
+private:
+	std::string m_comId;
+	int32_t m_width = 0;
+	int32_t m_height = 0;
+	bool m_failed = false;
+};
+
+} // namespace tvagentapi
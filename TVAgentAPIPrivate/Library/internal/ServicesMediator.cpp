@@ -44,6 +44,15 @@ template<>
 const char* ServicesMediator::ServerLocation<TransportFramework::gRPCTransport>(
 	TVRemoteScreenSDKCommunication::ServiceType serviceType)
 {
+#ifdef TV_AGENT_API_GRPC_SINGLE_SOCKET
+	// one server hosts all services on one socket
+	const std::vector<ServiceType>& serverServiceTypes = ServerServiceTypes();
+	if (std::find(serverServiceTypes.cbegin(), serverServiceTypes.cend(), serviceType) != serverServiceTypes.cend())
+	{
+		return "TVQtRC/services/";
+	}
+#endif
+
 	switch (serviceType)
 	{
 		case ServiceType::AccessControlOut:
@@ -94,6 +103,22 @@ const char* ServicesMediator::ServerLocation<TransportFramework::TCPSocketTransp
 	}
 }
 
+const std::vector<ServiceType>& ServicesMediator::ServerServiceTypes()
+{
+	static const std::vector<ServiceType> serviceTypes =
+	{
+		ServiceType::AccessControlOut,
+		ServiceType::ChatOut,
+		ServiceType::Connectivity,
+		ServiceType::Input,
+		ServiceType::SessionStatus,
+		ServiceType::InstantSupportNotification,
+		ServiceType::ConnectionConfirmationRequest,
+		ServiceType::AugmentRCSessionConsumer
+	};
+	return serviceTypes;
+}
+
 std::string ServicesMediator::FullServerLocation(ServiceType serviceType) const
 {
 	std::string fullServerLocation = m_serverUrlComponents.scheme;
@@ -121,4 +146,41 @@ uint64_t ServicesMediator::GetRunningServicesBitmask()
 	return GetRunningServiceFlagsRec<Details::ST::LastServiceType>();
 }
 
+bool ServicesMediator::StartAsyncServerHost()
+{
+#ifdef TV_AGENT_API_GRPC_ASYNC_SERVER
+	const TVRemoteScreenSDKCommunication::TransportBackend* backend =
+		TVRemoteScreenSDKCommunication::TransportRegistry::Get(m_framework);
+	if (!m_asyncServerHost && backend && backend->createSharedServer)
+	{
+		// All locations have to be known up front, the servers attach to the host one by one.
+		std::vector<std::string> locations;
+		for (const ServiceType serviceType : ServerServiceTypes())
+		{
+			// services share their location with TV_AGENT_API_GRPC_SINGLE_SOCKET
+			const std::string location = FullServerLocation(serviceType);
+			if (std::find(locations.cbegin(), locations.cend(), location) == locations.cend())
+			{
+				locations.push_back(location);
+			}
+		}
+
+		// Without a host each server falls back to a synchronous server on its own location,
+		// which cannot work for the one location shared with TV_AGENT_API_GRPC_SINGLE_SOCKET.
+		m_asyncServerHost = backend->createSharedServer(locations, m_transportOptions.defaults);
+	}
+#endif
+
+#ifdef TV_AGENT_API_GRPC_SINGLE_SOCKET
+	return m_framework != TransportFramework::gRPCTransport || !!m_asyncServerHost;
+#else
+	return true;
+#endif
+}
+
+void ServicesMediator::ReleaseAsyncServerHost()
+{
+	m_asyncServerHost.reset();
+}
+
 } // namespace tvagentapi
@@ -40,6 +40,7 @@
 #include <TVRemoteScreenSDKCommunication/ChatService/OutServiceFactory.h>
 
 #include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/ParseUrl.h>
+#include <TVRemoteScreenSDKCommunication/CommunicationLayerBase/TransportOptions.h>
 
 #include <TVRemoteScreenSDKCommunication/ConnectionConfirmationService/IConnectionConfirmationRequestServiceClient.h>
 #include <TVRemoteScreenSDKCommunication/ConnectionConfirmationService/IConnectionConfirmationRequestServiceServer.h>
@@ -87,6 +88,8 @@
 #include <TVRemoteScreenSDKCommunication/ViewGeometryService/IViewGeometryServiceServer.h>
 #include <TVRemoteScreenSDKCommunication/ViewGeometryService/ServiceFactory.h>
 
+#include <TVRemoteScreenSDKCommunication/TransportRegistry/TransportRegistry.h>
+
 #include <TVRemoteScreenSDKCommunication/AugmentRCSessionService/IAugmentRCSessionControlServiceClient.h>
 #include <TVRemoteScreenSDKCommunication/AugmentRCSessionService/IAugmentRCSessionControlServiceServer.h>
 #include <TVRemoteScreenSDKCommunication/AugmentRCSessionService/ControlServiceFactory.h>
@@ -192,11 +195,11 @@ static_assert(ST::Unknown < ST::LastServiceType, "Update LastServiceType");
 
 template <ST Type, TF Framework = TF::gRPCTransport>
 using ServerInterface =
-	typename std::result_of<decltype(Details::ServiceFactory<Type>::template CreateServer<Framework>)&()>::type;
+	decltype(Details::ServiceFactory<Type>::template CreateServer<Framework>());
 
 template <ST Type, TF Framework = TF::gRPCTransport>
 using ClientInterface =
-	typename std::result_of<decltype(Details::ServiceFactory<Type>::template CreateClient<Framework>)&()>::type;
+	decltype(Details::ServiceFactory<Type>::template CreateClient<Framework>());
 
 template <ST Type, bool IsServer>
 struct GenericStorage :
@@ -258,6 +261,9 @@ public:
 
 	std::string FullServerLocation(Details::ST serviceType) const;
 
+	// services hosted by the SDK and registered at the agent
+	static const std::vector<Details::ST>& ServerServiceTypes();
+
 	template <Details::ST Type>
 	SafeServer<Type> CreateAndStartServer()
 	{
@@ -268,22 +274,21 @@ public:
 			"Server interfaces are not the same");
 		Details::ServerInterface<Type> server{};
 
-		switch (m_framework)
+		if (const TVRemoteScreenSDKCommunication::TransportBackend* backend =
+				TVRemoteScreenSDKCommunication::TransportRegistry::Get(m_framework))
 		{
-			case Details::TF::gRPCTransport:
-#if TV_COMM_ENABLE_GRPC
-				server = Details::ServiceFactory<Type>::template CreateServer<Details::TF::gRPCTransport>();
-#endif
-				break;
-			case Details::TF::TCPSocketTransport:
-#ifdef TV_COMM_ENABLE_PLAIN_SOCKET
-				server = Details::ServiceFactory<Type>::template CreateServer<Details::TF::TCPSocketTransport>();
-#endif
-				break;
-			case Details::TF::UnknownTransport:
-				break;
+			server.reset(static_cast<typename Details::ServerInterface<Type>::element_type*>(
+				backend->createServer(Type, m_transportOptions.Get(Type)).release()));
 		}
 
+#ifdef TV_AGENT_API_GRPC_SINGLE_SOCKET
+		// all services share one socket, only the first server of its own could listen on it
+		if (m_framework == Details::TF::gRPCTransport && !m_asyncServerHost)
+		{
+			server.reset();
+		}
+#endif
+
 		const std::string fullServerLocation = FullServerLocation(Type);
 
 		auto safeServer = AcquireServer<Type>();
@@ -329,20 +334,11 @@ public:
 
 		Details::ClientInterface<Type> client{};
 
-		switch (m_framework)
+		if (const TVRemoteScreenSDKCommunication::TransportBackend* backend =
+				TVRemoteScreenSDKCommunication::TransportRegistry::Get(m_framework))
 		{
-			case Details::TF::gRPCTransport:
-#if TV_COMM_ENABLE_GRPC
-				client = Details::ServiceFactory<Type>::template CreateClient<Details::TF::gRPCTransport>();
-#endif
-				break;
-			case Details::TF::TCPSocketTransport:
-#if TV_COMM_ENABLE_PLAIN_SOCKET
-				client = Details::ServiceFactory<Type>::template CreateClient<Details::TF::TCPSocketTransport>();
-#endif
-				break;
-			case Details::TF::UnknownTransport:
-				break;
+			client.reset(static_cast<typename Details::ClientInterface<Type>::element_type*>(
+				backend->createClient(Type, m_transportOptions.Get(Type)).release()));
 		}
 
 		const std::string location = AgentServiceLocation(Type);
@@ -386,6 +382,12 @@ public:
 		m_comId = comId;
 	}
 
+	// applies to the services created afterwards
+	void SetTransportOptions(TVRemoteScreenSDKCommunication::ServiceTransportOptions transportOptions)
+	{
+		m_transportOptions = std::move(transportOptions);
+	}
+
 	template<Details::ST Type>
 	void TeardownClient()
 	{
@@ -408,6 +410,13 @@ public:
 
 	uint64_t GetRunningServicesBitmask();
 
+	// to be called before the servers are created, see TV_AGENT_API_GRPC_ASYNC_SERVER
+	// returns false if the servers cannot be started without the shared server
+	bool StartAsyncServerHost();
+
+	// to be called after all servers have been torn down
+	void ReleaseAsyncServerHost();
+
 private:
 	template <Details::ST Type>
 	typename std::enable_if<Type != Details::ST::Unknown, uint64_t>::type GetRunningServiceFlagsRec()
@@ -438,9 +447,13 @@ private:
 
 	ServicesInformation m_servicesInfo;
 	std::string m_comId;
+	TVRemoteScreenSDKCommunication::ServiceTransportOptions m_transportOptions;
 
 	Details::GenericStorage<Details::ST::LastServiceType, /*IsServer=*/false> m_clients;
 	Details::GenericStorage<Details::ST::LastServiceType, /*IsServer=*/true> m_servers;
+
+	// shared by all servers of the transport, see TV_AGENT_API_GRPC_ASYNC_SERVER
+	std::shared_ptr<void> m_asyncServerHost;
 };
 
 } // namespace tvagentapi
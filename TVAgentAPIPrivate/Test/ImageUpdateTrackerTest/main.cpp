@@ -0,0 +1,133 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include "internal/ImageUpdateTracker.h"
+
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+
+constexpr int32_t Width = 1920;
+constexpr int32_t Height = 1080;
+
+bool report(bool successful)
+{
+	successful ? std::cout << "SUCCESSFUL\n" : std::cout << "FAILED\n";
+	return successful;
+}
+
+bool testWholeFrameOnSessionStart()
+{
+	std::cout << "Test whole frame on session start: ";
+	tvagentapi::ImageUpdateTracker tracker;
+	bool successful = tracker.requiresWholeFrame("session1", Width, Height, true);
+
+	tracker.frameSending("session1", Width, Height);
+	tracker.frameSent();
+	successful &= !tracker.requiresWholeFrame("session1", Width, Height, true);
+
+	// a new session has not seen the frames sent to the previous one
+	successful &= tracker.requiresWholeFrame("session2", Width, Height, true);
+	return report(successful);
+}
+
+bool testWholeFrameOnGeometryChange()
+{
+	std::cout << "Test whole frame on geometry change: ";
+	tvagentapi::ImageUpdateTracker tracker;
+	tracker.frameSending("session", Width, Height);
+	tracker.frameSent();
+
+	bool successful = tracker.requiresWholeFrame("session", Width / 2, Height, true);
+	successful &= tracker.requiresWholeFrame("session", Width, Height / 2, true);
+
+	tracker.frameSending("session", Width / 2, Height);
+	tracker.frameSent();
+	successful &= !tracker.requiresWholeFrame("session", Width / 2, Height, true);
+	successful &= tracker.requiresWholeFrame("session", Width, Height, true);
+	return report(successful);
+}
+
+bool testWholeFrameAfterFailure()
+{
+	std::cout << "Test whole frame after a failed send: ";
+	tvagentapi::ImageUpdateTracker tracker;
+	tracker.frameSending("session", Width, Height);
+	tracker.frameSent();
+
+	// sending is not confirmed
+	tracker.frameSending("session", Width, Height);
+	bool successful = tracker.requiresWholeFrame("session", Width, Height, true);
+
+	tracker.frameSending("session", Width, Height);
+	tracker.frameSent();
+	successful &= !tracker.requiresWholeFrame("session", Width, Height, true);
+	return report(successful);
+}
+
+bool testResendAfterFailureWithoutChange()
+{
+	std::cout << "Test resending the last frame after a failed send without change: ";
+	tvagentapi::ImageUpdateTracker tracker;
+	tracker.frameSending("session", Width, Height);
+	tracker.frameSent();
+	bool successful = !tracker.lastFrameMissing("session");
+
+	// no new frame follows the failed one on an unchanged screen
+	tracker.frameSending("session", Width, Height);
+	successful &= tracker.lastFrameMissing("session");
+	successful &= tracker.requiresWholeFrame("session", Width, Height, true);
+
+	// the last frame is sent again
+	tracker.frameSending("session", Width, Height);
+	tracker.frameSent();
+	successful &= !tracker.lastFrameMissing("session");
+
+	// a new session has not received it either
+	successful &= tracker.lastFrameMissing("session2");
+	return report(successful);
+}
+
+bool testWholeFrameWithoutCroppedUpdates()
+{
+	std::cout << "Test whole frame without cropped updates: ";
+	tvagentapi::ImageUpdateTracker tracker;
+	tracker.frameSending("session", Width, Height);
+	tracker.frameSent();
+	return report(tracker.requiresWholeFrame("session", Width, Height, false));
+}
+
+} // namespace
+
+int main()
+{
+	bool success = true;
+	success &= testWholeFrameOnSessionStart();
+	success &= testWholeFrameOnGeometryChange();
+	success &= testWholeFrameAfterFailure();
+	success &= testResendAfterFailureWithoutChange();
+	success &= testWholeFrameWithoutCroppedUpdates();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -949,17 +949,41 @@ void CommunicationAdapter::sendScreenGrabResult(const tvqtsdk::ScreenGrabResult&
 	const int width = result.getDirtyRect().width();
 	const int height = result.getDirtyRect().height();
 
-	const QImage image = result.getImage();
-	std::string pictureData(
+	// the image is shared with the transport instead of copied, QImage detaches should it be painted on meanwhile
+	const std::shared_ptr<const QImage> sharedImage = std::make_shared<const QImage>(result.getImage());
+	const QImage& image = *sharedImage;
+	TVRemoteScreenSDKCommunication::FrameBuffer pictureData{
+		sharedImage,
 		reinterpret_cast<const char*>(image.constBits()),
-		static_cast<std::size_t>(image.bytesPerLine()) * static_cast<std::size_t>(image.height()));
+		static_cast<std::size_t>(image.bytesPerLine()) * static_cast<std::size_t>(image.height())};
+
+	// the channel cuts the dirty rect out of the whole image
+	tvagentapi::CommunicationChannel::FrameLayout frameLayout;
+	frameLayout.width = image.width();
+	frameLayout.height = image.height();
+	frameLayout.bytesPerLine = image.bytesPerLine();
+	frameLayout.bytesPerPixel = image.depth() / 8;
+
+	// the changed rectangles, sent on their own if the channel has imageRegions enabled
+	std::vector<TVRemoteScreenSDKCommunication::ImageService::ImageRegion> regions;
+	const QRegion& dirtyRegion = result.getDirtyRegion();
+#if QT_VERSION >= QT_VERSION_CHECK(5, 8, 0)
+	for (const QRect& rect : dirtyRegion)
+#else
+	for (const QRect& rect : dirtyRegion.rects())
+#endif
+	{
+		regions.push_back({rect.x(), rect.y(), rect.width(), rect.height()});
+	}
 
 	m_communicationChannel->sendScreenGrabResult(
 		x,
 		y,
 		width,
 		height,
-		std::move(pictureData));
+		std::move(pictureData),
+		frameLayout,
+		std::move(regions));
 }
 
 void CommunicationAdapter::sendImageDefinitionForGrabResult(
@@ -0,0 +1,77 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include "DirtyRegionTracker.h"
+
+#include "internal/Grabbing/Screen/TileDiff.h"
+
+namespace tvqtsdk
+{
+
+QRegion DirtyRegionTracker::update(const QImage& image)
+{
+	QImage previousImage;
+	previousImage.swap(m_previousImage);
+
+	if (image.isNull())
+	{
+		return {};
+	}
+	m_previousImage = image;
+
+	const bool comparable = !previousImage.isNull()
+		&& previousImage.size() == image.size()
+		&& previousImage.format() == image.format()
+		&& previousImage.bytesPerLine() == image.bytesPerLine()
+		&& image.depth() % 8 == 0;
+	if (!comparable)
+	{
+		return QRegion{image.rect()};
+	}
+
+	// the same image passed again
+	if (previousImage.constBits() == image.constBits())
+	{
+		return {};
+	}
+
+	const FrameLayout layout{
+		image.width(),
+		image.height(),
+		static_cast<size_t>(image.bytesPerLine()),
+		static_cast<size_t>(image.depth() / 8)};
+
+	QRegion dirtyRegion;
+	for (const TileRect& rect : DiffTiles(previousImage.constBits(), image.constBits(), layout, m_dirtyTiles))
+	{
+		dirtyRegion += QRect{rect.x, rect.y, rect.width, rect.height};
+	}
+	return dirtyRegion;
+}
+
+void DirtyRegionTracker::reset()
+{
+	m_previousImage = QImage{};
+}
+
+} // namespace tvqtsdk
@@ -0,0 +1,52 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include <QtGui/QImage>
+#include <QtGui/QRegion>
+
+#include <cstdint>
+#include <vector>
+
+namespace tvqtsdk
+{
+
+// Keeps the last grabbed image to tell which parts of the next one have changed.
+class DirtyRegionTracker final
+{
+public:
+	// Returns the region of image differing from the image passed before. The whole image
+	// counts as changed for the first one and whenever size or format change.
+	QRegion update(const QImage& image);
+
+	// Forgets the last image, so the next one counts as changed completely.
+	void reset();
+
+private:
+	// implicitly shared with the grab result, no copy is made as long as neither is modified
+	QImage m_previousImage;
+	std::vector<uint8_t> m_dirtyTiles;
+};
+
+} // namespace tvqtsdk
@@ -0,0 +1,87 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include "FrameBufferPool.h"
+
+#include <algorithm>
+
+namespace tvqtsdk
+{
+
+constexpr size_t FrameBufferPool::DefaultCapacity;
+
+FrameBufferPool::FrameBufferPool(size_t capacity)
+	: m_capacity(capacity)
+{
+	m_images.reserve(m_capacity);
+}
+
+QImage FrameBufferPool::acquire(const QSize& size, QImage::Format format, const FillFunction& fill)
+{
+	m_images.erase(
+		std::remove_if(
+			m_images.begin(),
+			m_images.end(),
+			[&size, format](const QImage& image)
+			{
+				return image.size() != size || image.format() != format;
+			}),
+		m_images.end());
+
+	// filled through the pool's own reference, a copy handed out before would detach on write
+	const auto pooledImage = std::find_if(
+		m_images.begin(),
+		m_images.end(),
+		[](const QImage& image)
+		{
+			return image.isDetached();
+		});
+	if (pooledImage != m_images.end())
+	{
+		return fill(*pooledImage) ? *pooledImage : QImage{};
+	}
+
+	QImage image{size, format};
+	++m_allocations;
+	if (image.isNull() || !fill(image))
+	{
+		return {};
+	}
+	if (m_images.size() < m_capacity)
+	{
+		m_images.push_back(image);
+	}
+	return image;
+}
+
+void FrameBufferPool::clear()
+{
+	m_images.clear();
+}
+
+size_t FrameBufferPool::getAllocationCount() const
+{
+	return m_allocations;
+}
+
+} // namespace tvqtsdk
@@ -0,0 +1,64 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include <QtGui/QImage>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace tvqtsdk
+{
+
+// Recycles the images grabbed frames are read into, so a frame does not need a fresh allocation.
+// An image is handed out again once no copy of it is left outside the pool, e.g. with the grab
+// result, the dirty region tracker or the transport, which all share it implicitly.
+class FrameBufferPool final
+{
+public:
+	static constexpr size_t DefaultCapacity = 5;
+
+	explicit FrameBufferPool(size_t capacity = DefaultCapacity);
+
+	using FillFunction = std::function<bool(QImage& image)>;
+
+	// Passes an image of size and format referenced by no one else to fill, which writes the frame
+	// through bits() without detaching, and returns it. A null image is returned if fill fails.
+	// Pooled images of another size or format are dropped, a fresh image not kept by the pool is
+	// used if all pooled ones are in use.
+	QImage acquire(const QSize& size, QImage::Format format, const FillFunction& fill);
+
+	// Drops the pooled images, the ones in use are freed when released.
+	void clear();
+
+	size_t getAllocationCount() const;
+
+private:
+	const size_t m_capacity;
+	std::vector<QImage> m_images;
+	size_t m_allocations = 0;
+};
+
+} // namespace tvqtsdk
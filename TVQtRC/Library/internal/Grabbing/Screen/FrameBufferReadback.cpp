@@ -0,0 +1,153 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include "FrameBufferReadback.h"
+
+#include <QtGui/QOpenGLContext>
+#include <QtGui/QOpenGLFunctions>
+#if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
+#include <QtGui/QOpenGLExtraFunctions>
+#endif
+
+#include <algorithm>
+
+namespace tvqtsdk
+{
+
+namespace
+{
+
+// the alpha of an opaque framebuffer might be anything, RGBX wants it to be 255
+void SetOpaqueIfNeeded(const QOpenGLContext* context, QImage& image)
+{
+	if (image.format() != QImage::Format_RGBX8888 || context->format().alphaBufferSize() <= 0)
+	{
+		return;
+	}
+
+	for (int line = 0; line < image.height(); ++line)
+	{
+		uchar* pixel = image.scanLine(line);
+		for (const uchar* lineEnd = pixel + ReadbackBytesPerPixel * image.width(); pixel < lineEnd; pixel += ReadbackBytesPerPixel)
+		{
+			pixel[3] = 255;
+		}
+	}
+}
+
+} // namespace
+
+constexpr size_t FrameBufferReadback::DefaultBufferCount;
+
+FrameBufferReadback::FrameBufferReadback(size_t bufferCount)
+	: m_pixelBuffers(bufferCount)
+	, m_formats(std::max<size_t>(bufferCount, 1), QImage::Format_Invalid)
+{
+}
+
+bool FrameBufferReadback::isAsynchronousSupported(const QOpenGLContext* context)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
+	// pixel pack buffers and glMapBufferRange are core from OpenGL ES 3.0 and OpenGL 3.0 on
+	return context != nullptr && context->format().majorVersion() >= 3;
+#else
+	Q_UNUSED(context);
+	return false;
+#endif
+}
+
+bool FrameBufferReadback::readSynchronously(QImage& image)
+{
+	QOpenGLContext* context = QOpenGLContext::currentContext();
+	if (context == nullptr)
+	{
+		return false;
+	}
+
+	ReadFramebuffer(*context->functions(), image.width(), image.height(), image.bits());
+	SetOpaqueIfNeeded(context, image);
+	return true;
+}
+
+QImage FrameBufferReadback::readAsynchronously(const QSize& size, QImage::Format format, FrameBufferPool& pool)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
+	QOpenGLContext* context = QOpenGLContext::currentContext();
+	if (context == nullptr || size.isEmpty())
+	{
+		return {};
+	}
+
+	QOpenGLExtraFunctions* functions = context->extraFunctions();
+	m_formats[m_pixelBuffers.startReadback(*functions, size.width(), size.height())] = format;
+	if (!m_pixelBuffers.isFull())
+	{
+		return {};
+	}
+
+	// the oldest frame has had bufferCount - 1 frames of time to arrive
+	const size_t oldest = m_pixelBuffers.getOldestPending();
+	return pool.acquire(
+		QSize{m_pixelBuffers.getWidth(oldest), m_pixelBuffers.getHeight(oldest)},
+		m_formats[oldest],
+		[this, context, functions](QImage& image)
+		{
+			if (!m_pixelBuffers.takeOldest(*functions, image.bits()))
+			{
+				return false;
+			}
+			SetOpaqueIfNeeded(context, image);
+			return true;
+		});
+#else
+	Q_UNUSED(size);
+	Q_UNUSED(format);
+	Q_UNUSED(pool);
+	return {};
+#endif
+}
+
+bool FrameBufferReadback::hasPendingFrames() const
+{
+	return m_pixelBuffers.hasPendingFrames();
+}
+
+void FrameBufferReadback::discardPendingFrames()
+{
+	m_pixelBuffers.discardPendingFrames();
+}
+
+void FrameBufferReadback::release()
+{
+	QOpenGLContext* context = QOpenGLContext::currentContext();
+	if (context != nullptr)
+	{
+		m_pixelBuffers.release(*context->functions());
+	}
+	else
+	{
+		m_pixelBuffers.forget();
+	}
+}
+
+} // namespace tvqtsdk
@@ -0,0 +1,77 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include "internal/Grabbing/Screen/FrameBufferPool.h"
+
+#include <QtGui/QImage>
+#include <QtGui/qopengl.h>
+
+#include "internal/Grabbing/Screen/PixelBufferRing.h"
+
+#include <cstddef>
+#include <vector>
+
+class QOpenGLContext;
+
+namespace tvqtsdk
+{
+
+// Reads frames from the framebuffer of the current OpenGL context into images, either synchronously
+// or through a PixelBufferRing, which returns a frame bufferCount - 1 frames later so the render
+// thread does not wait for the GPU to finish the frame just rendered.
+// All calls have to be made on the render thread with the context current.
+class FrameBufferReadback final
+{
+public:
+	static constexpr size_t DefaultBufferCount = 2;
+
+	explicit FrameBufferReadback(size_t bufferCount = DefaultBufferCount);
+
+	// Whether the context can read into pixel buffers and map them.
+	static bool isAsynchronousSupported(const QOpenGLContext* context);
+
+	// Reads the framebuffer into image, which is sized like the framebuffer and in one of the
+	// formats RGBA8888, RGBA8888_Premultiplied or RGBX8888.
+	static bool readSynchronously(QImage& image);
+
+	// Starts reading the framebuffer into the next pixel buffer. Once all of them are in use the
+	// oldest frame is returned in an image from pool, a null image is returned otherwise.
+	QImage readAsynchronously(const QSize& size, QImage::Format format, FrameBufferPool& pool);
+
+	// Whether frames are in the pixel buffers which have not been returned yet.
+	bool hasPendingFrames() const;
+
+	// Forgets the frames not returned yet, e.g. when a newer one has been read synchronously.
+	void discardPendingFrames();
+
+	// Deletes the pixel buffers, to be called before the context goes away.
+	void release();
+
+private:
+	PixelBufferRing m_pixelBuffers;
+	std::vector<QImage::Format> m_formats;
+};
+
+} // namespace tvqtsdk
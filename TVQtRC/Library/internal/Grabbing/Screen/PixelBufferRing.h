@@ -0,0 +1,224 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Kept free of Qt, the OpenGL declarations have to be included before, e.g. through QtGui/qopengl.h.
+// OpenGL ES 2 headers lack the names used by pixel buffers.
+#ifndef GL_PIXEL_PACK_BUFFER
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif
+#ifndef GL_STREAM_READ
+#define GL_STREAM_READ 0x88E1
+#endif
+#ifndef GL_MAP_READ_BIT
+#define GL_MAP_READ_BIT 0x0001
+#endif
+
+namespace tvqtsdk
+{
+
+// Frames are read as RGBA, 8 bits per channel.
+constexpr size_t ReadbackBytesPerPixel = 4;
+
+// Reads the framebuffer of the current context into destination, which holds width * height
+// pixels without padding, lines top down. Functions provides the OpenGL calls as members,
+// as QOpenGLFunctions does.
+template <typename Functions>
+void ReadFramebuffer(Functions& functions, int width, int height, uint8_t* destination)
+{
+	functions.glPixelStorei(GL_PACK_ALIGNMENT, ReadbackBytesPerPixel);
+	functions.glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, destination);
+
+	// OpenGL lines go bottom up
+	const size_t bytesPerLine = static_cast<size_t>(width) * ReadbackBytesPerPixel;
+	for (int top = 0, bottom = height - 1; top < bottom; ++top, --bottom)
+	{
+		uint8_t* topLine = destination + top * bytesPerLine;
+		std::swap_ranges(topLine, topLine + bytesPerLine, destination + bottom * bytesPerLine);
+	}
+}
+
+// Reads frames of the framebuffer through a ring of pixel buffer objects. A readback returns
+// right away, the frame is taken bufferCount - 1 readbacks later, by when the GPU has copied it.
+// Needs OpenGL 3.0 or OpenGL ES 3.0, Functions provides the calls as QOpenGLExtraFunctions does.
+// All calls have to be made with the context current.
+class PixelBufferRing final
+{
+public:
+	explicit PixelBufferRing(size_t bufferCount)
+		: m_pixelBuffers(std::max<size_t>(bufferCount, 1))
+	{
+	}
+
+	// Starts reading the framebuffer into the next pixel buffer and returns its index.
+	// The oldest frame is dropped if all buffers are in use.
+	template <typename Functions>
+	size_t startReadback(Functions& functions, int width, int height)
+	{
+		if (isFull())
+		{
+			dropOldest();
+		}
+
+		const size_t index = (m_oldestPending + m_pendingCount) % m_pixelBuffers.size();
+		PixelBuffer& pixelBuffer = m_pixelBuffers[index];
+		if (pixelBuffer.buffer == 0)
+		{
+			functions.glGenBuffers(1, &pixelBuffer.buffer);
+		}
+
+		functions.glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffer.buffer);
+		if (pixelBuffer.width != width || pixelBuffer.height != height)
+		{
+			const GLsizeiptr bufferSize = static_cast<GLsizeiptr>(width) * height * ReadbackBytesPerPixel;
+			functions.glBufferData(GL_PIXEL_PACK_BUFFER, bufferSize, nullptr, GL_STREAM_READ);
+			pixelBuffer.width = width;
+			pixelBuffer.height = height;
+		}
+
+		functions.glPixelStorei(GL_PACK_ALIGNMENT, ReadbackBytesPerPixel);
+		functions.glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		functions.glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		++m_pendingCount;
+		return index;
+	}
+
+	// Whether every pixel buffer holds a frame not taken yet.
+	bool isFull() const
+	{
+		return m_pendingCount == m_pixelBuffers.size();
+	}
+
+	bool hasPendingFrames() const
+	{
+		return m_pendingCount > 0;
+	}
+
+	// Index of the oldest frame, only meaningful with pending frames.
+	size_t getOldestPending() const
+	{
+		return m_oldestPending;
+	}
+
+	int getWidth(size_t index) const
+	{
+		return m_pixelBuffers[index].width;
+	}
+
+	int getHeight(size_t index) const
+	{
+		return m_pixelBuffers[index].height;
+	}
+
+	// Copies the oldest frame into destination, which holds its pixels without padding,
+	// lines top down, and removes it from the ring.
+	template <typename Functions>
+	bool takeOldest(Functions& functions, uint8_t* destination)
+	{
+		if (!hasPendingFrames())
+		{
+			return false;
+		}
+
+		const PixelBuffer& pixelBuffer = m_pixelBuffers[m_oldestPending];
+		dropOldest();
+
+		const size_t bytesPerLine = static_cast<size_t>(pixelBuffer.width) * ReadbackBytesPerPixel;
+		functions.glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffer.buffer);
+		const auto* pixels = static_cast<const uint8_t*>(functions.glMapBufferRange(
+			GL_PIXEL_PACK_BUFFER,
+			0,
+			static_cast<GLsizeiptr>(bytesPerLine) * pixelBuffer.height,
+			GL_MAP_READ_BIT));
+		if (pixels == nullptr)
+		{
+			functions.glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+			return false;
+		}
+
+		// OpenGL lines go bottom up
+		for (int line = 0; line < pixelBuffer.height; ++line)
+		{
+			std::memcpy(destination + (pixelBuffer.height - 1 - line) * bytesPerLine, pixels + line * bytesPerLine, bytesPerLine);
+		}
+		functions.glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		functions.glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		return true;
+	}
+
+	// Forgets the frames not taken yet.
+	void discardPendingFrames()
+	{
+		m_oldestPending = 0;
+		m_pendingCount = 0;
+	}
+
+	// Deletes the pixel buffers, to be called before the context goes away.
+	template <typename Functions>
+	void release(Functions& functions)
+	{
+		for (PixelBuffer& pixelBuffer : m_pixelBuffers)
+		{
+			if (pixelBuffer.buffer != 0)
+			{
+				functions.glDeleteBuffers(1, &pixelBuffer.buffer);
+			}
+		}
+		forget();
+	}
+
+	// Forgets the pixel buffers, for a context which is gone already.
+	void forget()
+	{
+		discardPendingFrames();
+		std::fill(m_pixelBuffers.begin(), m_pixelBuffers.end(), PixelBuffer{});
+	}
+
+private:
+	struct PixelBuffer
+	{
+		GLuint buffer = 0;
+		int width = 0;
+		int height = 0;
+	};
+
+	void dropOldest()
+	{
+		m_oldestPending = (m_oldestPending + 1) % m_pixelBuffers.size();
+		--m_pendingCount;
+	}
+
+	std::vector<PixelBuffer> m_pixelBuffers;
+	size_t m_oldestPending = 0;
+	size_t m_pendingCount = 0;
+};
+
+} // namespace tvqtsdk
@@ -49,8 +49,6 @@
 #endif
 #endif
 
-extern Q_GUI_EXPORT QImage qt_gl_read_framebuffer(const QSize& size, bool alpha_format, bool include_alpha);
-
 #define DIRECT_OPENGL_GRABBING
 
 #ifdef WIDGETS_EVENT_DRIVEN_GRABBING
@@ -84,6 +82,7 @@ namespace
 constexpr const char* ForceIntervalGrabEnvKey = "TV_SDK_QT_FORCE_INTERVAL_GRAB";
 constexpr const char* FavourQtQuickGrabEnvKey = "TV_SDK_QT_FAVOUR_QTQUICK_GRAB";
 constexpr const char* PicturesPersecondEnvKey = "TV_SDK_QT_GRABS_PER_SECOND";
+constexpr const char* SynchronousReadbackEnvKey = "TV_SDK_QT_SYNCHRONOUS_GL_READBACK";
 
 constexpr uint32_t DefaultPicturesPerSecond = 25;
 
@@ -142,6 +141,12 @@ QImage GrabWindow(QWindow* window)
 	return pixmap.toImage();
 }
 
+QImage::Format GetOpenGLGrabFormat(const QQuickWindow* quickWindow)
+{
+	const bool alpha = quickWindow->format().alphaBufferSize() > 0 && quickWindow->color().alpha() < 255;
+	return alpha ? QImage::Format_RGBA8888_Premultiplied : QImage::Format_RGBX8888;
+}
+
 } // namespace
 
 QWindowGrabMethod::QWindowGrabMethod(QWindow* window, const std::shared_ptr<ILogging>& logging, QObject* parent)
@@ -224,18 +229,24 @@ ScreenGrabResult QWindowGrabMethod::grab()
 	}
 
 	QImage image = GrabWindow(m_window);
+	QRegion dirtyRegion = updateDirtyRegion(image);
 
-	// currently no dirty rect information is available -> treat the whole image as changed
-	QRect dirtyRect = image.rect();
-
-	ScreenGrabResult screenGrabResult(std::move(image), std::move(dirtyRect));
+	ScreenGrabResult screenGrabResult(std::move(image), std::move(dirtyRegion));
 	return screenGrabResult;
 }
 
+QRegion QWindowGrabMethod::updateDirtyRegion(const QImage& image)
+{
+	std::lock_guard<std::mutex> dirtyRegionLock(m_dirtyRegionMutex);
+	return m_dirtyRegionTracker.update(image);
+}
+
 void QWindowGrabMethod::reactOnScreenUpdate()
 {
 	ScreenGrabResult grabResult = grab();
-	if (grabResult.isValid())
+
+	// unchanged frames are not sent again
+	if (grabResult.isValid() && !grabResult.getDirtyRegion().isEmpty())
 	{
 		Q_EMIT grabFinished(grabResult);
 	}
@@ -267,6 +278,18 @@ void QWindowGrabMethod::sendIfScreenChanged()
 	{
 		Q_EMIT grabFinished(screenGrabResult);
 	}
+
+	// the last frames rendered stay in the pixel buffers until another one is rendered
+	const uint32_t renderedFrames = m_renderedFrames;
+	if (!screenGrabResult.isValid() && m_readbackPending && renderedFrames == m_renderedFramesLastCheck)
+	{
+		if (auto quickWindow = qobject_cast<QQuickWindow*>(m_window))
+		{
+			m_flushReadback = true;
+			quickWindow->update();
+		}
+	}
+	m_renderedFramesLastCheck = renderedFrames;
 }
 
 static bool IsOpenGLImageGrabbable(const QQuickWindow* quickWindow)
@@ -352,6 +375,8 @@ void QWindowGrabMethod::startGrabbing()
 
 	if (!QProcessEnvironment::systemEnvironment().contains(ForceIntervalGrabEnvKey) && quickWindow && IsOpenGLImageGrabbable(quickWindow))
 	{
+		m_synchronousReadback = QProcessEnvironment::systemEnvironment().contains(SynchronousReadbackEnvKey);
+
 		auto grabScreenAndSetDirty = [quickWindow, this]()
 		{
 			if (QOpenGLContext::currentContext() == nullptr)
@@ -361,13 +386,42 @@ void QWindowGrabMethod::startGrabbing()
 
 			std::lock_guard<std::mutex> backbufferLock(m_backbufferMutex);
 
-			m_lastGrabResult = {}; // clear old image first to release its memory before allocating anew
+			// a result not sent yet is replaced, its changes are sent with the new one
+			QRegion dirtyRegion = m_lastGrabResult.getDirtyRegion();
 
-			const bool alpha = quickWindow->format().alphaBufferSize() > 0 && quickWindow->color().alpha() < 255;
-			QImage grabImage = qt_gl_read_framebuffer(quickWindow->size() * quickWindow->devicePixelRatio(), alpha, alpha);
-			QRect dirtyRect = grabImage.rect();
+			const QSize size = quickWindow->size() * quickWindow->devicePixelRatio();
+			const QImage::Format format = GetOpenGLGrabFormat(quickWindow);
+			++m_renderedFrames;
 
-			m_lastGrabResult = ScreenGrabResult(std::move(grabImage), std::move(dirtyRect));
+			// reading through pixel buffers does not wait for the GPU, a frame arrives with a later one.
+			// Either way it is read into an image no longer used by the last results, the tracker or the transport.
+			QImage grabImage;
+			if (!m_synchronousReadback
+				&& !m_flushReadback.exchange(false)
+				&& FrameBufferReadback::isAsynchronousSupported(QOpenGLContext::currentContext()))
+			{
+				grabImage = m_frameBufferReadback.readAsynchronously(size, format, m_frameBufferPool);
+			}
+			else
+			{
+				// the frame just rendered is newer than the ones in the pixel buffers
+				m_frameBufferReadback.discardPendingFrames();
+				grabImage = m_frameBufferPool.acquire(size, format, &FrameBufferReadback::readSynchronously);
+			}
+			m_readbackPending = m_frameBufferReadback.hasPendingFrames();
+
+			if (grabImage.isNull())
+			{
+				return;
+			}
+
+			dirtyRegion = (dirtyRegion + updateDirtyRegion(grabImage)).intersected(grabImage.rect());
+			if (dirtyRegion.isEmpty())
+			{
+				return;
+			}
+
+			m_lastGrabResult = ScreenGrabResult(std::move(grabImage), std::move(dirtyRegion));
 		};
 
 		// The slot gets called from the scene graph thread, since it's connected directly
@@ -375,6 +429,20 @@ void QWindowGrabMethod::startGrabbing()
 		// It's necessary for proper image grabbing from the framebuffer.
 		m_grabWindowConnection = QObject::connect(quickWindow, &QQuickWindow::afterRendering, this, grabScreenAndSetDirty, Qt::DirectConnection);
 
+		// the pixel buffers belong to the scene graph's context and go with it
+		QObject::disconnect(m_releaseReadbackConnection);
+		m_releaseReadbackConnection = QObject::connect(
+			quickWindow,
+			&QQuickWindow::sceneGraphInvalidated,
+			this,
+			[this]()
+			{
+				std::lock_guard<std::mutex> backbufferLock(m_backbufferMutex);
+				m_frameBufferReadback.release();
+				m_readbackPending = false;
+			},
+			Qt::DirectConnection);
+
 		timerProc = &QWindowGrabMethod::sendIfScreenChanged;
 	}
 #endif // DIRECT_OPENGL_GRABBING
@@ -412,6 +480,16 @@ void QWindowGrabMethod::stopGrabbing()
 	}
 #endif
 	m_timer->stop();
+
+	{
+		std::lock_guard<std::mutex> backbufferLock(m_backbufferMutex);
+		m_frameBufferPool.clear();
+		m_frameBufferReadback.discardPendingFrames();
+		m_readbackPending = false;
+	}
+
+	std::lock_guard<std::mutex> dirtyRegionLock(m_dirtyRegionMutex);
+	m_dirtyRegionTracker.reset();
 }
 
 ColorFormat QWindowGrabMethod::getColorFormat()
@@ -423,7 +501,13 @@ ColorFormat QWindowGrabMethod::getColorFormat()
 	}
 	else
 	{
-		if (m_grabColorFormat == QImage::Format::Format_Invalid)
+		const QQuickWindow* quickWindow = qobject_cast<QQuickWindow*>(m_window);
+		if (m_grabWindowConnection && quickWindow)
+		{
+			// read back from OpenGL directly
+			m_grabColorFormat = GetOpenGLGrabFormat(quickWindow);
+		}
+		else if (m_grabColorFormat == QImage::Format::Format_Invalid)
 		{
 			QImage image = GrabWindow(m_window);
 			m_grabColorFormat = image.format();
@@ -26,6 +26,9 @@
 #include "internal/Grabbing/Screen/ColorFormat.h"
 
 #include "internal/Grabbing/Screen/AbstractScreenGrabMethod.h"
+#include "internal/Grabbing/Screen/DirtyRegionTracker.h"
+#include "internal/Grabbing/Screen/FrameBufferPool.h"
+#include "internal/Grabbing/Screen/FrameBufferReadback.h"
 #include "internal/Grabbing/Screen/ScreenGrabResult.h"
 
 #include <QtCore/QPointer>
@@ -58,6 +61,8 @@ private:
 
 	void signalImageDefinitionChanged();
 
+	QRegion updateDirtyRegion(const QImage& image);
+
 #ifdef WIDGETS_EVENT_DRIVEN_GRABBING
 	Q_SLOT void conditionalReactOnScreenUpdate();
 
@@ -73,6 +78,22 @@ private:
 
 	ScreenGrabResult m_lastGrabResult;
 	std::mutex m_backbufferMutex;
+
+	// OpenGL windows are read back into recycled images, guarded by the backbuffer mutex
+	FrameBufferPool m_frameBufferPool;
+	FrameBufferReadback m_frameBufferReadback;
+	bool m_synchronousReadback = false;
+	QMetaObject::Connection m_releaseReadbackConnection;
+
+	// frames left in the pixel buffers when rendering stops are fetched by rendering once more
+	std::atomic_bool m_readbackPending{false};
+	std::atomic_bool m_flushReadback{false};
+	std::atomic<uint32_t> m_renderedFrames{0};
+	uint32_t m_renderedFramesLastCheck = 0;
+
+	// grabs come from the GUI thread and, for OpenGL windows, from the scene graph thread
+	DirtyRegionTracker m_dirtyRegionTracker;
+	std::mutex m_dirtyRegionMutex;
 };
 
 } // namespace tvqtsdk
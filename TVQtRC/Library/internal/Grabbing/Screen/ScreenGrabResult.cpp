@@ -27,7 +27,12 @@ namespace tvqtsdk
 {
 
 ScreenGrabResult::ScreenGrabResult(QImage&& image, QRect&& dirtyRect)
-	: m_image(std::move(image)), m_dirtyRect(std::move(dirtyRect))
+	: m_image(std::move(image)), m_dirtyRect(std::move(dirtyRect)), m_dirtyRegion(m_dirtyRect)
+{
+}
+
+ScreenGrabResult::ScreenGrabResult(QImage&& image, QRegion&& dirtyRegion)
+	: m_image(std::move(image)), m_dirtyRect(dirtyRegion.boundingRect()), m_dirtyRegion(std::move(dirtyRegion))
 {
 }
 
@@ -41,6 +46,11 @@ const QRect& ScreenGrabResult::getDirtyRect() const
 	return m_dirtyRect;
 }
 
+const QRegion& ScreenGrabResult::getDirtyRegion() const
+{
+	return m_dirtyRegion;
+}
+
 bool ScreenGrabResult::isValid() const
 {
 	return !m_image.isNull();
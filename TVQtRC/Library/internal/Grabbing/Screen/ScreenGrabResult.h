@@ -24,6 +24,7 @@
 #pragma once
 
 #include <QtGui/QImage>
+#include <QtGui/QRegion>
 
 namespace tvqtsdk
 {
@@ -33,15 +34,20 @@ class ScreenGrabResult final
 public:
 	ScreenGrabResult() = default;
 	ScreenGrabResult(QImage&& image, QRect&& dirtyRect);
+	ScreenGrabResult(QImage&& image, QRegion&& dirtyRegion);
 
 	const QImage& getImage() const;
+
+	// bounding rect of the dirty region
 	const QRect& getDirtyRect() const;
+	const QRegion& getDirtyRegion() const;
 
 	bool isValid() const;
 
 private:
 	QImage m_image;
 	QRect m_dirtyRect;
+	QRegion m_dirtyRegion;
 };
 
 } // namespace tvqtsdk
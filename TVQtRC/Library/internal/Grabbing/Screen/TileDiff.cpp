@@ -0,0 +1,301 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include "TileDiff.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define TILE_DIFF_SSE2
+#endif
+
+#if defined(TILE_DIFF_SSE2) && defined(__GNUC__)
+#include <immintrin.h>
+#define TILE_DIFF_AVX2
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define TILE_DIFF_NEON
+#endif
+
+namespace tvqtsdk
+{
+
+namespace
+{
+
+bool BytesEqualScalar(const uint8_t* first, const uint8_t* second, size_t size)
+{
+	size_t offset = 0;
+	for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t))
+	{
+		uint64_t firstWord = 0;
+		uint64_t secondWord = 0;
+		std::memcpy(&firstWord, first + offset, sizeof(uint64_t));
+		std::memcpy(&secondWord, second + offset, sizeof(uint64_t));
+		if (firstWord != secondWord)
+		{
+			return false;
+		}
+	}
+
+	for (; offset < size; ++offset)
+	{
+		if (first[offset] != second[offset])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+#ifdef TILE_DIFF_SSE2
+bool BytesEqualSse2(const uint8_t* first, const uint8_t* second, size_t size)
+{
+	size_t offset = 0;
+	for (; offset + sizeof(__m128i) <= size; offset += sizeof(__m128i))
+	{
+		const __m128i firstBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + offset));
+		const __m128i secondBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + offset));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(firstBytes, secondBytes)) != 0xFFFF)
+		{
+			return false;
+		}
+	}
+	return BytesEqualScalar(first + offset, second + offset, size - offset);
+}
+#endif
+
+#ifdef TILE_DIFF_AVX2
+__attribute__((target("avx2")))
+bool BytesEqualAvx2(const uint8_t* first, const uint8_t* second, size_t size)
+{
+	size_t offset = 0;
+	for (; offset + sizeof(__m256i) <= size; offset += sizeof(__m256i))
+	{
+		const __m256i firstBytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + offset));
+		const __m256i secondBytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + offset));
+		if (!_mm256_testc_si256(_mm256_cmpeq_epi8(firstBytes, secondBytes), _mm256_set1_epi8(-1)))
+		{
+			return false;
+		}
+	}
+	return BytesEqualSse2(first + offset, second + offset, size - offset);
+}
+#endif
+
+#ifdef TILE_DIFF_NEON
+bool BytesEqualNeon(const uint8_t* first, const uint8_t* second, size_t size)
+{
+	size_t offset = 0;
+	for (; offset + sizeof(uint8x16_t) <= size; offset += sizeof(uint8x16_t))
+	{
+		const uint8x16_t difference = veorq_u8(vld1q_u8(first + offset), vld1q_u8(second + offset));
+		const uint64x2_t words = vreinterpretq_u64_u8(difference);
+		if ((vgetq_lane_u64(words, 0) | vgetq_lane_u64(words, 1)) != 0)
+		{
+			return false;
+		}
+	}
+	return BytesEqualScalar(first + offset, second + offset, size - offset);
+}
+#endif
+
+TileCompareFunction SelectCompareFunction()
+{
+#ifdef TILE_DIFF_AVX2
+	if (__builtin_cpu_supports("avx2"))
+	{
+		return &BytesEqualAvx2;
+	}
+#endif
+#if defined(TILE_DIFF_SSE2)
+	return &BytesEqualSse2;
+#elif defined(TILE_DIFF_NEON)
+	return &BytesEqualNeon;
+#else
+	return &BytesEqualScalar;
+#endif
+}
+
+// Joins the changed tiles into rectangles: runs of changed tiles within a tile row,
+// extended downwards while the next row has a run with the same columns.
+std::vector<TileRect> MergeDirtyTiles(
+	const std::vector<uint8_t>& dirtyTiles,
+	int columns,
+	int rows,
+	const FrameLayout& layout)
+{
+	std::vector<TileRect> rects;
+
+	// rectangles still growing downwards, in tile units
+	std::vector<TileRect> open;
+	std::vector<TileRect> stillOpen;
+
+	const auto close = [&rects, &layout](const TileRect& tiles)
+	{
+		const int x = tiles.x * DirtyTileSize;
+		const int y = tiles.y * DirtyTileSize;
+		rects.push_back(TileRect{
+			x,
+			y,
+			std::min(tiles.width * DirtyTileSize, layout.width - x),
+			std::min(tiles.height * DirtyTileSize, layout.height - y)});
+	};
+
+	for (int row = 0; row < rows; ++row)
+	{
+		stillOpen.clear();
+		const uint8_t* rowTiles = dirtyTiles.data() + static_cast<size_t>(row) * columns;
+
+		int column = 0;
+		while (column < columns)
+		{
+			if (!rowTiles[column])
+			{
+				++column;
+				continue;
+			}
+
+			const int runStart = column;
+			while (column < columns && rowTiles[column])
+			{
+				++column;
+			}
+			const int runWidth = column - runStart;
+
+			const auto extended = std::find_if(open.begin(), open.end(), [runStart, runWidth](const TileRect& tiles)
+			{
+				return tiles.x == runStart && tiles.width == runWidth;
+			});
+
+			if (extended != open.end())
+			{
+				TileRect tiles = *extended;
+				++tiles.height;
+				stillOpen.push_back(tiles);
+				open.erase(extended);
+			}
+			else
+			{
+				stillOpen.push_back(TileRect{runStart, row, runWidth, 1});
+			}
+		}
+
+		// whatever did not continue in this row is complete
+		for (const TileRect& tiles : open)
+		{
+			close(tiles);
+		}
+		open.swap(stillOpen);
+	}
+
+	for (const TileRect& tiles : open)
+	{
+		close(tiles);
+	}
+
+	return rects;
+}
+
+} // namespace
+
+bool TileBytesEqual(const uint8_t* first, const uint8_t* second, size_t size)
+{
+	static const TileCompareFunction compare = SelectCompareFunction();
+	return compare(first, second, size);
+}
+
+std::vector<TileCompareMethod> SupportedTileCompareMethods()
+{
+	std::vector<TileCompareMethod> methods{{"scalar", &BytesEqualScalar}};
+#ifdef TILE_DIFF_SSE2
+	methods.push_back({"SSE2", &BytesEqualSse2});
+#endif
+#ifdef TILE_DIFF_AVX2
+	if (__builtin_cpu_supports("avx2"))
+	{
+		methods.push_back({"AVX2", &BytesEqualAvx2});
+	}
+#endif
+#ifdef TILE_DIFF_NEON
+	methods.push_back({"NEON", &BytesEqualNeon});
+#endif
+	return methods;
+}
+
+std::vector<TileRect> DiffTiles(
+	const uint8_t* previous,
+	const uint8_t* current,
+	const FrameLayout& layout,
+	std::vector<uint8_t>& dirtyTiles,
+	TileCompareFunction bytesEqual)
+{
+	if (layout.width <= 0 || layout.height <= 0)
+	{
+		return {};
+	}
+
+	const int columns = (layout.width + DirtyTileSize - 1) / DirtyTileSize;
+	const int rows = (layout.height + DirtyTileSize - 1) / DirtyTileSize;
+	dirtyTiles.assign(static_cast<size_t>(columns) * rows, 0);
+
+	const size_t tileBytes = DirtyTileSize * layout.bytesPerPixel;
+	const size_t rowBytes = static_cast<size_t>(layout.width) * layout.bytesPerPixel;
+
+	for (int row = 0; row < rows; ++row)
+	{
+		uint8_t* rowTiles = dirtyTiles.data() + static_cast<size_t>(row) * columns;
+		int cleanTiles = columns;
+
+		const int firstLine = row * DirtyTileSize;
+		const int endLine = std::min(firstLine + DirtyTileSize, layout.height);
+		for (int line = firstLine; line < endLine && cleanTiles > 0; ++line)
+		{
+			const size_t lineOffset = static_cast<size_t>(line) * layout.bytesPerLine;
+			for (int column = 0; column < columns; ++column)
+			{
+				if (rowTiles[column])
+				{
+					continue;
+				}
+
+				// the padding at the end of a line is not part of the picture
+				const size_t offset = column * tileBytes;
+				const size_t size = std::min(tileBytes, rowBytes - offset);
+				if (!bytesEqual(previous + lineOffset + offset, current + lineOffset + offset, size))
+				{
+					rowTiles[column] = 1;
+					--cleanTiles;
+				}
+			}
+		}
+	}
+
+	return MergeDirtyTiles(dirtyTiles, columns, rows, layout);
+}
+
+} // namespace tvqtsdk
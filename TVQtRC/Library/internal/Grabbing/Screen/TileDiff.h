@@ -0,0 +1,79 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tvqtsdk
+{
+
+// Rectangle in pixels, kept free of Qt so the comparison stays plain memory work.
+struct TileRect
+{
+	int x;
+	int y;
+	int width;
+	int height;
+};
+
+// Layout shared by the two frames compared, rows may be padded beyond width * bytesPerPixel.
+struct FrameLayout
+{
+	int width;
+	int height;
+	size_t bytesPerLine;
+	size_t bytesPerPixel;
+};
+
+// Frames are compared in square tiles of this many pixels.
+constexpr int DirtyTileSize = 32;
+
+using TileCompareFunction = bool (*)(const uint8_t* first, const uint8_t* second, size_t size);
+
+// Whether the given number of bytes at both addresses are equal. Uses AVX2, SSE2 or NEON
+// where available, picked once at runtime, a scalar loop otherwise.
+bool TileBytesEqual(const uint8_t* first, const uint8_t* second, size_t size);
+
+struct TileCompareMethod
+{
+	const char* name;
+	TileCompareFunction bytesEqual;
+};
+
+// The implementations TileBytesEqual picks from which this CPU supports, the scalar loop first.
+std::vector<TileCompareMethod> SupportedTileCompareMethods();
+
+// Compares two frames of the same layout tile by tile and returns the changed area as
+// few rectangles, each made of changed tiles and clipped to the frame.
+// dirtyTiles is scratch space, kept by the caller to be reused for the next frame.
+std::vector<TileRect> DiffTiles(
+	const uint8_t* previous,
+	const uint8_t* current,
+	const FrameLayout& layout,
+	std::vector<uint8_t>& dirtyTiles,
+	TileCompareFunction bytesEqual = &TileBytesEqual);
+
+} // namespace tvqtsdk
@@ -0,0 +1,246 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES3/gl3.h>
+
+#include "PixelBufferRing.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace tvqtsdk;
+
+namespace
+{
+
+constexpr int SurfaceWidth = 67;
+constexpr int SurfaceHeight = 45;
+
+// the OpenGL calls as members, like QOpenGLExtraFunctions provides them
+struct GlesFunctions
+{
+	void glGenBuffers(GLsizei count, GLuint* buffers) { ::glGenBuffers(count, buffers); }
+	void glDeleteBuffers(GLsizei count, const GLuint* buffers) { ::glDeleteBuffers(count, buffers); }
+	void glBindBuffer(GLenum target, GLuint buffer) { ::glBindBuffer(target, buffer); }
+	void glBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) { ::glBufferData(target, size, data, usage); }
+	void* glMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) { return ::glMapBufferRange(target, offset, length, access); }
+	GLboolean glUnmapBuffer(GLenum target) { return ::glUnmapBuffer(target); }
+	void glPixelStorei(GLenum name, GLint value) { ::glPixelStorei(name, value); }
+	void glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels)
+	{
+		::glReadPixels(x, y, width, height, format, type, pixels);
+	}
+};
+
+// Makes an OpenGL ES 3 context on an offscreen surface current, preferably without a display server.
+bool MakeContextCurrent()
+{
+	EGLDisplay display = EGL_NO_DISPLAY;
+	const auto getPlatformDisplay =
+		reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+	if (getPlatformDisplay != nullptr)
+	{
+		display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+	}
+	if (display == EGL_NO_DISPLAY)
+	{
+		display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
+	if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr) || !eglBindAPI(EGL_OPENGL_ES_API))
+	{
+		return false;
+	}
+
+	const EGLint configAttributes[] = {
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT,
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RED_SIZE, 8,
+		EGL_GREEN_SIZE, 8,
+		EGL_BLUE_SIZE, 8,
+		EGL_ALPHA_SIZE, 8,
+		EGL_NONE};
+	EGLConfig config = nullptr;
+	EGLint configCount = 0;
+	if (!eglChooseConfig(display, configAttributes, &config, 1, &configCount) || configCount < 1)
+	{
+		return false;
+	}
+
+	const EGLint surfaceAttributes[] = {EGL_WIDTH, SurfaceWidth, EGL_HEIGHT, SurfaceHeight, EGL_NONE};
+	const EGLSurface surface = eglCreatePbufferSurface(display, config, surfaceAttributes);
+	const EGLint contextAttributes[] = {EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE};
+	const EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+	return surface != EGL_NO_SURFACE && context != EGL_NO_CONTEXT && eglMakeCurrent(display, surface, surface, context);
+}
+
+// Renders a frame telling itself apart from the others, with a marker which is not symmetric vertically.
+void RenderFrame(int frame)
+{
+	glDisable(GL_SCISSOR_TEST);
+	glClearColor((frame % 7) / 7.0f, (frame % 5) / 5.0f, (frame % 3) / 3.0f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	glEnable(GL_SCISSOR_TEST);
+	glScissor(frame % 11, 3 + frame % 13, 9, 5);
+	glClearColor(1.0f, 1.0f, 1.0f, 0.5f);
+	glClear(GL_COLOR_BUFFER_BIT);
+	glDisable(GL_SCISSOR_TEST);
+}
+
+// The frame as read by a plain synchronous glReadPixels, lines flipped to go top down.
+std::vector<uint8_t> ReadReference(int width, int height)
+{
+	const size_t bytesPerLine = static_cast<size_t>(width) * ReadbackBytesPerPixel;
+	std::vector<uint8_t> bottomUp(bytesPerLine * height);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, bottomUp.data());
+
+	std::vector<uint8_t> topDown(bottomUp.size());
+	for (int line = 0; line < height; ++line)
+	{
+		std::copy(
+			bottomUp.begin() + line * bytesPerLine,
+			bottomUp.begin() + (line + 1) * bytesPerLine,
+			topDown.begin() + (height - 1 - line) * bytesPerLine);
+	}
+	return topDown;
+}
+
+bool report(const std::string& test, bool successful)
+{
+	std::cout << "Test " << test << ": " << (successful ? "SUCCESSFUL\n" : "FAILED\n");
+	return successful;
+}
+
+bool testReadFramebuffer()
+{
+	GlesFunctions functions;
+	bool successful = true;
+	for (int frame = 0; frame < 3; ++frame)
+	{
+		RenderFrame(frame);
+		std::vector<uint8_t> pixels(static_cast<size_t>(SurfaceWidth) * SurfaceHeight * ReadbackBytesPerPixel);
+		ReadFramebuffer(functions, SurfaceWidth, SurfaceHeight, pixels.data());
+		successful &= pixels == ReadReference(SurfaceWidth, SurfaceHeight);
+	}
+	return report("synchronous readback", successful && glGetError() == GL_NO_ERROR);
+}
+
+// Frames come out of the ring bufferCount - 1 frames late, as glReadPixels read them when rendered.
+// The size changes in between, which reallocates the pixel buffers.
+bool testRing(size_t bufferCount)
+{
+	GlesFunctions functions;
+	PixelBufferRing ring(bufferCount);
+
+	struct Frame
+	{
+		int width;
+		int height;
+		std::vector<uint8_t> reference;
+	};
+	std::vector<Frame> frames;
+
+	constexpr int FrameCount = 12;
+	bool successful = true;
+	size_t takenFrames = 0;
+	for (int frame = 0; frame < FrameCount; ++frame)
+	{
+		const int width = frame < FrameCount / 2 ? SurfaceWidth : SurfaceWidth - 10;
+		const int height = frame < FrameCount / 2 ? SurfaceHeight : SurfaceHeight - 7;
+
+		RenderFrame(frame);
+		frames.push_back(Frame{width, height, ReadReference(width, height)});
+
+		const size_t index = ring.startReadback(functions, width, height);
+		successful &= ring.getWidth(index) == width && ring.getHeight(index) == height;
+		if (!ring.isFull())
+		{
+			continue;
+		}
+
+		const Frame& expected = frames[takenFrames++];
+		const size_t oldest = ring.getOldestPending();
+		successful &= ring.getWidth(oldest) == expected.width && ring.getHeight(oldest) == expected.height;
+
+		std::vector<uint8_t> pixels(expected.reference.size());
+		successful &= ring.takeOldest(functions, pixels.data()) && pixels == expected.reference;
+	}
+
+	successful &= takenFrames == FrameCount - (bufferCount - 1);
+	successful &= ring.hasPendingFrames() == (bufferCount > 1);
+
+	ring.discardPendingFrames();
+	successful &= !ring.hasPendingFrames();
+
+	ring.release(functions);
+	return report(
+		"readback through " + std::to_string(bufferCount) + " pixel buffers",
+		successful && glGetError() == GL_NO_ERROR);
+}
+
+// A frame not taken before its buffer is needed again is dropped for the newer ones.
+bool testRingDropsUntakenFrames()
+{
+	GlesFunctions functions;
+	PixelBufferRing ring(2);
+
+	std::vector<std::vector<uint8_t>> references;
+	for (int frame = 0; frame < 3; ++frame)
+	{
+		RenderFrame(frame);
+		references.push_back(ReadReference(SurfaceWidth, SurfaceHeight));
+		ring.startReadback(functions, SurfaceWidth, SurfaceHeight);
+	}
+
+	std::vector<uint8_t> pixels(references.front().size());
+	bool successful = ring.takeOldest(functions, pixels.data()) && pixels == references[1];
+	successful &= ring.takeOldest(functions, pixels.data()) && pixels == references[2];
+	successful &= !ring.takeOldest(functions, pixels.data());
+
+	ring.release(functions);
+	return report("dropping frames not taken", successful && glGetError() == GL_NO_ERROR);
+}
+
+} // namespace
+
+int main()
+{
+	if (!MakeContextCurrent())
+	{
+		std::cout << "Test pixel buffer readback: SKIPPED, no offscreen OpenGL ES 3 context available\n";
+		return EXIT_SUCCESS;
+	}
+
+	bool success = testReadFramebuffer();
+	for (size_t bufferCount = 1; bufferCount <= 3; ++bufferCount)
+	{
+		success &= testRing(bufferCount);
+	}
+	success &= testRingDropsUntakenFrames();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,205 @@
+//********************************************************************************//
+// MIT License                                                                    //
+//                                                                                //
+// Copyright (c) 2024 TeamViewer Germany GmbH                                     //
+//                                                                                //
+// Permission is hereby granted, free of charge, to any person obtaining a copy   //
+// of this software and associated documentation files (the "Software"), to deal  //
+// in the Software without restriction, including without limitation the rights   //
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      //
+// copies of the Software, and to permit persons to whom the Software is          //
+// furnished to do so, subject to the following conditions:                       //
+//                                                                                //
+// The above copyright notice and this permission notice shall be included in all //
+// copies or substantial portions of the Software.                                //
+//                                                                                //
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     //
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       //
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    //
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         //
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  //
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  //
+// SOFTWARE.                                                                      //
+//********************************************************************************//
+#include "TileDiff.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tvqtsdk;
+
+namespace
+{
+
+bool report(const std::string& test, bool successful)
+{
+	std::cout << "Test " << test << ": " << (successful ? "SUCCESSFUL\n" : "FAILED\n");
+	return successful;
+}
+
+bool testBytesEqual(const TileCompareMethod& method)
+{
+	// sizes around the vector widths, at addresses not aligned to them
+	constexpr size_t MaxSize = 100;
+	constexpr size_t Misalignment = 3;
+	std::vector<uint8_t> first(MaxSize + Misalignment);
+	for (size_t index = 0; index < first.size(); ++index)
+	{
+		first[index] = static_cast<uint8_t>(index * 7);
+	}
+
+	bool successful = true;
+	for (size_t size = 0; size <= MaxSize; ++size)
+	{
+		std::vector<uint8_t> second = first;
+		successful &= method.bytesEqual(first.data() + Misalignment, second.data() + Misalignment, size);
+
+		for (size_t changed = 0; changed < size; ++changed)
+		{
+			second[Misalignment + changed] ^= 0x80;
+			successful &= !method.bytesEqual(first.data() + Misalignment, second.data() + Misalignment, size);
+			second[Misalignment + changed] ^= 0x80;
+		}
+
+		// bytes beyond the size do not count
+		second[Misalignment + size] ^= 0x80;
+		successful &= method.bytesEqual(first.data() + Misalignment, second.data() + Misalignment, size);
+	}
+	return report(std::string(method.name) + " byte comparison", successful);
+}
+
+// Which tiles the rects cover, a tile covered twice or a rect outside of the frame fails.
+bool rasterizeTiles(const std::vector<TileRect>& rects, const FrameLayout& layout, int columns, std::vector<uint8_t>& tiles)
+{
+	tiles.assign(static_cast<size_t>(columns) * ((layout.height + DirtyTileSize - 1) / DirtyTileSize), 0);
+	for (const TileRect& rect : rects)
+	{
+		const bool tileAligned = rect.x % DirtyTileSize == 0 && rect.y % DirtyTileSize == 0;
+		const bool clipped = rect.x + rect.width == layout.width || rect.width % DirtyTileSize == 0;
+		const bool clippedVertically = rect.y + rect.height == layout.height || rect.height % DirtyTileSize == 0;
+		if (!tileAligned || !clipped || !clippedVertically || rect.width <= 0 || rect.height <= 0
+			|| rect.x + rect.width > layout.width || rect.y + rect.height > layout.height)
+		{
+			return false;
+		}
+
+		for (int y = rect.y; y < rect.y + rect.height; y += DirtyTileSize)
+		{
+			for (int x = rect.x; x < rect.x + rect.width; x += DirtyTileSize)
+			{
+				uint8_t& tile = tiles[static_cast<size_t>(y / DirtyTileSize) * columns + x / DirtyTileSize];
+				if (tile)
+				{
+					return false;
+				}
+				tile = 1;
+			}
+		}
+	}
+	return true;
+}
+
+bool testDiffTiles(const TileCompareMethod& method, int width, int height, size_t bytesPerPixel, size_t padding)
+{
+	const FrameLayout layout{width, height, width * bytesPerPixel + padding, bytesPerPixel};
+	const int columns = (width + DirtyTileSize - 1) / DirtyTileSize;
+	const int rows = (height + DirtyTileSize - 1) / DirtyTileSize;
+
+	std::mt19937 random(static_cast<std::mt19937::result_type>(width * 31 + height));
+	std::vector<uint8_t> previous(layout.bytesPerLine * height);
+	for (uint8_t& byte : previous)
+	{
+		byte = static_cast<uint8_t>(random());
+	}
+
+	bool successful = true;
+	std::vector<uint8_t> dirtyTiles;
+	std::vector<uint8_t> coveredTiles;
+	for (int changes = 0; changes <= 8; ++changes)
+	{
+		std::vector<uint8_t> current = previous;
+
+		// the padding at the end of the lines differs in every frame
+		for (int line = 0; line < height; ++line)
+		{
+			for (size_t byte = width * bytesPerPixel; byte < layout.bytesPerLine; ++byte)
+			{
+				current[line * layout.bytesPerLine + byte] ^= 0xFF;
+			}
+		}
+
+		for (int change = 0; change < changes; ++change)
+		{
+			const size_t line = random() % height;
+			const size_t byte = random() % (width * bytesPerPixel);
+			current[line * layout.bytesPerLine + byte] ^= 0x01;
+		}
+
+		// compared byte by byte, a byte changed twice is unchanged again
+		std::vector<uint8_t> expectedTiles(static_cast<size_t>(columns) * rows, 0);
+		for (int line = 0; line < height; ++line)
+		{
+			for (size_t byte = 0; byte < width * bytesPerPixel; ++byte)
+			{
+				const size_t offset = line * layout.bytesPerLine + byte;
+				if (previous[offset] != current[offset])
+				{
+					const size_t column = byte / bytesPerPixel / DirtyTileSize;
+					expectedTiles[static_cast<size_t>(line / DirtyTileSize) * columns + column] = 1;
+				}
+			}
+		}
+
+		const std::vector<TileRect> rects = DiffTiles(previous.data(), current.data(), layout, dirtyTiles, method.bytesEqual);
+		successful &= rasterizeTiles(rects, layout, columns, coveredTiles) && coveredTiles == expectedTiles;
+	}
+
+	return report(std::string(method.name) + " diff of " + std::to_string(width) + "x" + std::to_string(height)
+		+ " frame, " + std::to_string(bytesPerPixel) + " bytes per pixel, " + std::to_string(padding) + " bytes padding",
+		successful);
+}
+
+bool testEmptyFrame()
+{
+	std::vector<uint8_t> dirtyTiles;
+	const std::vector<TileRect> rects = DiffTiles(nullptr, nullptr, FrameLayout{0, 0, 0, 4}, dirtyTiles);
+	return report("empty frame", rects.empty());
+}
+
+} // namespace
+
+int main()
+{
+	struct Geometry
+	{
+		int width;
+		int height;
+		size_t bytesPerPixel;
+		size_t padding;
+	};
+
+	const Geometry geometries[] = {
+		{1, 1, 4, 0},
+		{31, 33, 4, 0},
+		{64, 64, 4, 0},
+		{65, 97, 4, 12},
+		{33, 17, 3, 1},
+		{127, 3, 3, 5},
+		{1, 95, 4, 60},
+		{250, 131, 4, 64},
+	};
+
+	bool success = testEmptyFrame();
+	for (const TileCompareMethod& method : SupportedTileCompareMethods())
+	{
+		success &= testBytesEqual(method);
+		for (const Geometry& geometry : geometries)
+		{
+			success &= testDiffTiles(method, geometry.width, geometry.height, geometry.bytesPerPixel, geometry.padding);
+		}
+	}
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}